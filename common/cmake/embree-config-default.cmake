@@ -28,6 +28,7 @@ SET(EMBREE_TUTORIALS @EMBREE_TUTORIALS@)
 
 SET(EMBREE_RAY_MASK @EMBREE_RAY_MASK@)
 SET(EMBREE_STAT_COUNTERS @EMBREE_STAT_COUNTERS@)
+SET(EMBREE_COST_COUNTERS @EMBREE_COST_COUNTERS@)
 SET(EMBREE_BACKFACE_CULLING @EMBREE_BACKFACE_CULLING@)
 SET(EMBREE_INTERSECTION_FILTER @EMBREE_INTERSECTION_FILTER@)
 SET(EMBREE_INTERSECTION_FILTER_RESTORE @EMBREE_INTERSECTION_FILTER_RESTORE@)
@@ -40,4 +41,5 @@ SET(EMBREE_GEOMETRY_LINES @EMBREE_GEOMETRY_LINES@)
 SET(EMBREE_GEOMETRY_HAIR @EMBREE_GEOMETRY_HAIR@)
 SET(EMBREE_GEOMETRY_SUBDIV @EMBREE_GEOMETRY_SUBDIV@)
 SET(EMBREE_GEOMETRY_USER @EMBREE_GEOMETRY_USER@)
+SET(EMBREE_GEOMETRY_POINTS @EMBREE_GEOMETRY_POINTS@)
 SET(EMBREE_RAY_PACKETS @EMBREE_RAY_PACKETS@)
@@ -109,6 +109,16 @@ namespace embree
       return  _mm_cvtepu8_epi32(_mm_loadu_si128((__m128i*)ptr));
     }
 
+#else
+
+    static __forceinline vint4 load( const unsigned char* const ptr ) {
+      return vint4(ptr[0],ptr[1],ptr[2],ptr[3]);
+    }
+
+    static __forceinline vint4 loadu( const unsigned char* const ptr ) {
+      return vint4(ptr[0],ptr[1],ptr[2],ptr[3]);
+    }
+
 #endif
 
     static __forceinline vint4 load(const unsigned short* const ptr) {
@@ -127,7 +137,7 @@ namespace embree
       *(int*)ptr = _mm_cvtsi128_si32(x);
 #else
       for (size_t i=0;i<4;i++)
-        ptr[i] = (unsigned char)v[i];
+        ptr[i] = (unsigned char)min(max(v[i],0),255);
 #endif
     }
 
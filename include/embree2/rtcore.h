@@ -168,6 +168,9 @@ enum RTCParameter {
   RTC_CONFIG_HAIR_GEOMETRY = 20,              //!< checks if hair geometries are supported
   RTC_CONFIG_SUBDIV_GEOMETRY = 21,           //!< checks if subdiv geometries are supported
   RTC_CONFIG_USER_GEOMETRY = 22,             //!< checks if user geometries are supported
+  RTC_CONFIG_POINT_GEOMETRY = 23,            //!< checks if sphere and disc point geometries are supported
+
+  RTC_CONFIG_COST_COUNTERS = 24,             //!< checks if traversal cost counters per geometry are enabled (read only)
 };
 
 /*! \brief Configures some parameters. 
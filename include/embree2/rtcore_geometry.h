@@ -26,6 +26,9 @@
 /*! maximal number of time steps */
 #define RTC_MAX_TIME_STEPS 129
 
+/*! maximal subdivision level of opacity masks */
+#define RTC_MAX_OPACITY_MASK_LEVEL 5
+
 /*! \brief Specifies the type of buffers when mapping buffers */
 enum RTCBufferType {
   RTC_INDEX_BUFFER         = 0x01000000,
@@ -73,6 +76,14 @@ enum RTCBoundaryMode
   RTC_BOUNDARY_EDGE_AND_CORNER = 2     //!< boundary corner vertices are sharp vertices
 };
 
+/*! \brief Opacity states stored in opacity masks */
+enum RTCOpacityState
+{
+  RTC_OPACITY_TRANSPARENT = 0,         //!< hits get ignored without invoking the filter functions
+  RTC_OPACITY_OPAQUE = 1,              //!< hits get accepted without invoking the filter functions
+  RTC_OPACITY_UNKNOWN = 2              //!< hits invoke the filter functions
+};
+
 /*! Intersection filter function for single rays. */
 typedef void (*RTCFilterFunc)(void* ptr,           /*!< pointer to user data */
                               RTCRay& ray          /*!< intersection to filter */);
@@ -155,6 +166,18 @@ RTCORE_API unsigned rtcNewInstance2 (RTCScene target,                  //!< the
                                      RTCScene source,                  //!< the scene to instantiate
                                      size_t numTimeSteps = 1);         //!< number of timesteps, one matrix per timestep
 
+/*! \brief Creates a new lazily built scene instance. 
+
+  Behaves like rtcNewInstance2, but the source scene does not have to
+  get committed. The first ray that hits the provided local space
+  bounds of the instance builds the source scene, and rays that hit
+  the instance concurrently join that build. The source scene cannot
+  be a static scene, see rtcEvictLazyInstances. */
+RTCORE_API unsigned rtcNewLazyInstance (RTCScene target,                  //!< the scene the instance belongs to
+                                        RTCScene source,                  //!< the scene to instantiate
+                                        const RTCBounds* bounds,          //!< local space bounds of the source scene
+                                        size_t numTimeSteps = 1);         //!< number of timesteps, one matrix per timestep
+
 /*! \brief Sets transformation of the instance */
 RTCORE_API void rtcSetTransform (RTCScene scene,                          //!< scene handle
                                  unsigned geomID,                         //!< ID of geometry
@@ -354,6 +377,30 @@ RTCORE_API unsigned rtcNewLineSegments (RTCScene scene,                    //!<
                                         size_t numTimeSteps = 1            //!< number of motion blur time steps
   );
 
+/*! \brief Creates a new sphere geometry, consisting of multiple
+  spheres with varying radii. The number of spheres (numSpheres) and
+  number of time steps (only 1 is currently supported) have to get
+  specified at construction time. The sphere vertex buffer
+  (RTC_VERTEX_BUFFER) has to get set by mapping and writing to it, each
+  sphere consists of a single precision (x,y,z) center and radius,
+  stored in that order in memory. No index buffer is used, the primID
+  of a hit is the index of the sphere in the vertex buffer. */
+RTCORE_API unsigned rtcNewSphereGeometry (RTCScene scene,                  //!< the scene the spheres belong to
+                                          RTCGeometryFlags flags,          //!< geometry flags
+                                          size_t numSpheres,               //!< number of spheres
+                                          size_t numTimeSteps = 1          //!< number of motion blur time steps
+  );
+
+/*! \brief Creates a new disc geometry, consisting of multiple discs
+  that always face the ray origin. The vertex buffer layout is the same
+  as for rtcNewSphereGeometry, with the radius specifying the disc
+  radius. */
+RTCORE_API unsigned rtcNewDiscGeometry (RTCScene scene,                    //!< the scene the discs belong to
+                                        RTCGeometryFlags flags,            //!< geometry flags
+                                        size_t numDiscs,                   //!< number of discs
+                                        size_t numTimeSteps = 1            //!< number of motion blur time steps
+  );
+
 /*! \brief Sets 32 bit ray mask. */
 RTCORE_API void rtcSetMask (RTCScene scene, unsigned geomID, int mask);
 
@@ -447,6 +494,20 @@ RTCORE_API void rtcSetOcclusionFilterFunction16 (RTCScene scene, unsigned geomID
 /*! \brief Sets the occlusion filter function for ray packets of size N. */
 RTCORE_API void rtcSetOcclusionFilterFunctionN (RTCScene scene, unsigned geomID, RTCFilterFuncN func);
 
+/*! \brief Sets an opacity mask for a triangle or quad mesh with
+ *  filter functions. Each primitive is subdivided 'level' times into
+ *  4^level sub-triangles (sub-quads for quad meshes) that store a 2
+ *  bit RTCOpacityState each, thus each primitive occupies
+ *  (2*4^level+7)/8 bytes of the mask. Hits in transparent or opaque
+ *  sub-triangles are handled without invoking the filter functions,
+ *  only hits in unknown sub-triangles invoke them. Sub-quads are
+ *  enumerated row by row along the v coordinate. Sub-triangles are
+ *  enumerated row by row along the v barycentric coordinate, where
+ *  each row alternates upright and inverted sub-triangles along u. The
+ *  mask is not copied and has to stay valid while rays are traced, a
+ *  NULL pointer disables the mask. */
+RTCORE_API void rtcSetOpacityMask (RTCScene scene, unsigned geomID, const void* mask, unsigned level);
+
 /*! Set pointer for user defined data per geometry. Invokations
  *  of the various user intersect and occluded functions get passed
  *  this data pointer when called. */
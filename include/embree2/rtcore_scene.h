@@ -104,6 +104,36 @@ RTCORE_API void rtcCommit (RTCScene scene);
  *  coprocessor. */
 RTCORE_API void rtcCommitThread(RTCScene scene, unsigned int threadID, unsigned int numThreads);
 
+/*! Frees the acceleration structures of all scenes lazily instanced
+ *  by this scene that no ray accessed since the last call. Scenes
+ *  also instanced by a regular instance are never evicted. An evicted
+ *  scene gets rebuilt when a ray hits one of its lazy instances
+ *  again. This function must not get called while rays are traced
+ *  and returns the number of evicted scenes. */
+RTCORE_API size_t rtcEvictLazyInstances(RTCScene scene);
+
+/*! Traversal costs charged to a geometry or scene. */
+struct RTCCosts
+{
+  size_t nodes;    //!< number of ray/node tests
+  size_t prims;    //!< number of ray/primitive tests
+  size_t filters;  //!< number of filter function and opacity mask invocations
+};
+
+/*! Returns the traversal costs gathered for the scene since the last
+ *  call and resets them. The costs of geometry i get stored to
+ *  geometryCosts[i] for the first numGeometries geometries, work done
+ *  inside an instanced scene is charged to the outermost instance
+ *  geometry. Node visits of the scene that cannot be attributed to a
+ *  single geometry get stored to sceneCosts, which may be NULL. Costs
+ *  are only gathered if Embree got compiled with
+ *  EMBREE_COST_COUNTERS, see RTC_CONFIG_COST_COUNTERS, otherwise all
+ *  costs are zero. This function must not get called while rays are
+ *  traced and returns the number of geometry IDs of the scene. If
+ *  geometryCosts and sceneCosts are both NULL the costs do not get
+ *  reset, which allows to size the array before gathering. */
+RTCORE_API size_t rtcGetCosts(RTCScene scene, RTCCosts* geometryCosts, size_t numGeometries, RTCCosts* sceneCosts);
+
 /*! Returns AABB of the scene. rtcCommit has to get called
  *  previously to this function. */
 RTCORE_API void rtcGetBounds(RTCScene scene, RTCBounds& bounds_o);
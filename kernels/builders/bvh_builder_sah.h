@@ -362,6 +362,30 @@ namespace embree
                                         const size_t branchingFactor, const size_t maxDepth, const size_t blockSize, 
                                         const size_t minLeafSize, const size_t maxLeafSize,
                                         const float travCost, const float intCost)
+      {
+        /* build hierarchy */
+        BuildRecord br(pinfo,1,(size_t*)&root,Set(0,pinfo.size()));
+        return build_record(br,createAlloc,identity,createNode,updateNode,createLeaf,progressMonitor,
+                            prims,branchingFactor,maxDepth,blockSize,minLeafSize,maxLeafSize,travCost,intCost);
+      }
+
+      /*! builds the subtree for the primitives of a build record, the build record specifies depth and parent of the subtree */
+      template<typename CreateAllocFunc, 
+        typename ReductionTy, 
+        typename CreateNodeFunc, 
+        typename UpdateNodeFunc, 
+        typename CreateLeafFunc, 
+        typename ProgressMonitor>
+        
+        static ReductionTy build_record(BuildRecord& br,
+                                        CreateAllocFunc createAlloc, 
+                                        const ReductionTy& identity, 
+                                        CreateNodeFunc createNode, UpdateNodeFunc updateNode, CreateLeafFunc createLeaf, 
+                                        ProgressMonitor progressMonitor,
+                                        PrimRef* prims, 
+                                        const size_t branchingFactor, const size_t maxDepth, const size_t blockSize, 
+                                        const size_t minLeafSize, const size_t maxLeafSize,
+                                        const float travCost, const float intCost)
       {
         /* builder wants log2 of blockSize as input */		  
         const size_t logBlockSize = __bsr(blockSize); 
@@ -390,11 +414,83 @@ namespace embree
                         updateNode,
                         createLeaf,
                         progressMonitor,
-                        pinfo,
+                        br.pinfo,
                         branchingFactor,maxDepth,logBlockSize,
                         minLeafSize,maxLeafSize,travCost,intCost);
         
         /* build hierarchy */
+        return builder(br);
+      }
+    };
+
+    /* SAH builder for the upper levels of large builds, operates on
+     * an array of compact primrefs and stops at subtrees of some
+     * size, these subtrees get passed to the leaf creation function */
+    struct BVHBuilderBinnedSAHCompact
+    {
+      typedef range<size_t> Set;
+
+      struct Heuristic : public HeuristicArrayBinningSAH<PrimRefCompact,NUM_OBJECT_BINS>
+      {
+        __forceinline Heuristic (PrimRefCompact* prims)
+          : HeuristicArrayBinningSAH<PrimRefCompact,NUM_OBJECT_BINS>(prims) {}
+
+        /* primitive order gets established when building the subtrees */
+        __forceinline void deterministic_order(const Set& set) {}
+      };
+
+      typedef GeneralBuildRecord<Set,typename Heuristic::Split,PrimInfo> BuildRecord;
+
+      template<typename NodeRef, 
+        typename CreateAllocFunc, 
+        typename ReductionTy, 
+        typename CreateNodeFunc, 
+        typename UpdateNodeFunc, 
+        typename CreateSubtreeFunc>
+        
+        static ReductionTy build_reduce(NodeRef& root,
+                                        CreateAllocFunc createAlloc, 
+                                        const ReductionTy& identity, 
+                                        CreateNodeFunc createNode, UpdateNodeFunc updateNode, CreateSubtreeFunc createSubtree, 
+                                        PrimRefCompact* prims, const PrimInfo& pinfo, 
+                                        const size_t branchingFactor, const size_t maxDepth, const size_t blockSize, 
+                                        const size_t subtreeSize, const float travCost, const float intCost)
+      {
+        /* builder wants log2 of blockSize as input */		  
+        const size_t logBlockSize = __bsr(blockSize); 
+        assert((blockSize ^ (size_t(1) << logBlockSize)) == 0);
+
+        /* progress gets reported when building the subtrees */
+        auto progressMonitor = [] (size_t) {};
+
+        /* instantiate array binning heuristic */
+        Heuristic heuristic(prims);
+        
+        typedef GeneralBVHBuilder<
+          BuildRecord,
+          Heuristic,
+          ReductionTy,
+          decltype(createAlloc()),
+          CreateAllocFunc,
+          CreateNodeFunc,
+          UpdateNodeFunc,
+          CreateSubtreeFunc,
+          decltype(progressMonitor),
+          PrimInfo> Builder;
+        
+        /* instantiate builder, all sets of up to subtreeSize primitives become subtrees */
+        Builder builder(heuristic,
+                        identity,
+                        createAlloc,
+                        createNode,
+                        updateNode,
+                        createSubtree,
+                        progressMonitor,
+                        pinfo,
+                        branchingFactor,maxDepth,logBlockSize,
+                        subtreeSize,subtreeSize,travCost,intCost);
+        
+        /* build upper levels of hierarchy */
         BuildRecord br(pinfo,1,(size_t*)&root,Set(0,pinfo.size()));
         return builder(br);
       }
@@ -413,7 +509,7 @@ namespace embree
       static const size_t SPATIAL_BINS = FAST_SPATIAL_BUILDER_NUM_SPATIAL_SPLITS;
 
       typedef extended_range<size_t> Set;
-      typedef Split2<BinSplit<OBJECT_BINS>,SpatialBinSplit<SPATIAL_BINS> > Split;
+      typedef Split2<BinSplit<OBJECT_BINS>,SpatialBinSplit<SPATIAL_BINS>,HeuristicArraySweepSAH<PrimRef>::Split> Split;
       typedef GeneralBuildRecord<Set,Split,PrimInfo> BuildRecord;
 
       /*! standard build without reduction */
@@ -478,7 +574,8 @@ namespace embree
                                         const size_t branchingFactor, 
                                         const size_t maxDepth, const size_t blockSize, 
                                         const size_t minLeafSize, const size_t maxLeafSize,
-                                        const float travCost, const float intCost)
+                                        const float travCost, const float intCost,
+                                        const size_t sweepThreshold = 0)
       {
         /* builder wants log2 of blockSize as input */		  
         const size_t logBlockSize = __bsr(blockSize); 
@@ -487,8 +584,8 @@ namespace embree
 
         typedef HeuristicArraySpatialSAH<SplitPrimitiveFunc, PrimRef,OBJECT_BINS, SPATIAL_BINS> Heuristic;
 
-        /* instantiate array binning heuristic */
-        Heuristic heuristic(splitPrimitive,prims0,pinfo);
+        /* instantiate array binning heuristic, nodes with at least sweepThreshold primitives use sweep SAH object splits */
+        Heuristic heuristic(splitPrimitive,prims0,pinfo,sweepThreshold);
         
         typedef GeneralBVHBuilder<
           BuildRecord,
@@ -444,6 +444,16 @@ namespace embree
           const vint16 i = floori((p-ofs16)*scale16);
           return lt(splitDimMask,i,vSplitPos);
         }
+
+        template<typename PrimRefT>
+        __forceinline int bin_unsafe(const PrimRefT &ref,
+                                     const vint16  vSplitPos,
+                                     const vbool16 splitDimMask) const
+        {
+          const vfloat16 p(vfloat4(center2(ref.bounds())));
+          const vint16 i = floori((p-ofs16)*scale16);
+          return lt(splitDimMask,i,vSplitPos);
+        }
         
         /*! returns true if the mapping is invalid in some dimension */
         __forceinline bool invalid(const size_t dim) const {
@@ -519,231 +529,111 @@ namespace embree
       }
 
 
+      /*! bins a single primitive into the in-register bin histograms,
+       *  each primitive updates exactly one lane per dimension, thus
+       *  the masked updates are conflict free */
+      static __forceinline void bin_prim(const BBox3fa& prim, const vint16& bin, const vint16& step16,
+                                         Vec3vf16 min_b[3], Vec3vf16 max_b[3], vint16 count_b[3])
+      {
+        const vfloat16 b_min_x = prim.lower.x;
+        const vfloat16 b_min_y = prim.lower.y;
+        const vfloat16 b_min_z = prim.lower.z;
+        const vfloat16 b_max_x = prim.upper.x;
+        const vfloat16 b_max_y = prim.upper.y;
+        const vfloat16 b_max_z = prim.upper.z;
+
+        const vbool16 m_update[3] = {
+          step16 == shuffle<0>(bin),
+          step16 == shuffle<1>(bin),
+          step16 == shuffle<2>(bin)
+        };
+
+        for (size_t dim=0; dim<3; dim++)
+        {
+          const vbool16 m = m_update[dim];
+          assert(__popcnt((size_t)m) == 1);
+          min_b[dim].x = mask_min(m,min_b[dim].x,min_b[dim].x,b_min_x);
+          min_b[dim].y = mask_min(m,min_b[dim].y,min_b[dim].y,b_min_y);
+          min_b[dim].z = mask_min(m,min_b[dim].z,min_b[dim].z,b_min_z);
+          max_b[dim].x = mask_max(m,max_b[dim].x,max_b[dim].x,b_max_x);
+          max_b[dim].y = mask_max(m,max_b[dim].y,max_b[dim].y,b_max_y);
+          max_b[dim].z = mask_max(m,max_b[dim].z,max_b[dim].z,b_max_z);
+          count_b[dim] = mask_add(m,count_b[dim],count_b[dim],vint16(1));
+        }
+      }
+
       /*! bins an array of primitives */
       __forceinline void bin (const PrimRef* prims, size_t N, const BinMapping<16>& mapping)
       {
-
-        const vfloat16 init_min(pos_inf);
-        const vfloat16 init_max(neg_inf);
-
-        vfloat16 min_x0,min_x1,min_x2;
-        vfloat16 min_y0,min_y1,min_y2;
-        vfloat16 min_z0,min_z1,min_z2;
-        vfloat16 max_x0,max_x1,max_x2;
-        vfloat16 max_y0,max_y1,max_y2;
-        vfloat16 max_z0,max_z1,max_z2;
-        vint16 count0,count1,count2;
-
-        min_x0 = init_min;
-        min_x1 = init_min;
-        min_x2 = init_min;
-        min_y0 = init_min;
-        min_y1 = init_min;
-        min_y2 = init_min;
-        min_z0 = init_min;
-        min_z1 = init_min;
-        min_z2 = init_min;
-
-        max_x0 = init_max;
-        max_x1 = init_max;
-        max_x2 = init_max;
-        max_y0 = init_max;
-        max_y1 = init_max;
-        max_y2 = init_max;
-        max_z0 = init_max;
-        max_z1 = init_max;
-        max_z2 = init_max;
-
-        count0 = vint16::zero();
-        count1 = vint16::zero();
-        count2 = vint16::zero();
-
         const vint16 step16(step);
+        Vec3vf16 min_b[3], max_b[3]; vint16 count_b[3];
+        for (size_t dim=0; dim<3; dim++) {
+          min_b[dim] = Vec3vf16(pos_inf); max_b[dim] = Vec3vf16(neg_inf); count_b[dim] = vint16::zero();
+        }
+
         size_t i;
-	for (i=0; i<N-1; i+=2)
+	for (i=0; i+1<N; i+=2)
         {
           /*! map even and odd primitive to bin */
-          const BBox3fa primA = prims[i+0].bounds();
-          const vfloat16 centerA = vfloat16((vfloat4)primA.lower) + vfloat16((vfloat4)primA.upper); 
+          BBox3fa primA; Vec3fa centerA; prims[i+0].binBoundsAndCenter(primA,centerA);
+          BBox3fa primB; Vec3fa centerB; prims[i+1].binBoundsAndCenter(primB,centerB);
           const vint16 binA = mapping.bin16(centerA);
-
-          const BBox3fa primB = prims[i+1].bounds();
-          const vfloat16 centerB = vfloat16((vfloat4)primB.lower) + vfloat16((vfloat4)primB.upper); 
           const vint16 binB = mapping.bin16(centerB);
+          bin_prim(primA,binA,step16,min_b,max_b,count_b);
+          bin_prim(primB,binB,step16,min_b,max_b,count_b);
+        }
 
-          /* A */
-          {
-            const vfloat16 b_min_x = prims[i+0].lower.x;
-            const vfloat16 b_min_y = prims[i+0].lower.y;
-            const vfloat16 b_min_z = prims[i+0].lower.z;
-            const vfloat16 b_max_x = prims[i+0].upper.x;
-            const vfloat16 b_max_y = prims[i+0].upper.y;
-            const vfloat16 b_max_z = prims[i+0].upper.z;
-
-            const vint16 bin0 = shuffle<0>(binA);
-            const vint16 bin1 = shuffle<1>(binA);
-            const vint16 bin2 = shuffle<2>(binA);
-
-            const vbool16 m_update_x = step16 == bin0;
-            const vbool16 m_update_y = step16 == bin1;
-            const vbool16 m_update_z = step16 == bin2;
-
-            assert(__popcnt((size_t)m_update_x) == 1);
-            assert(__popcnt((size_t)m_update_y) == 1);
-            assert(__popcnt((size_t)m_update_z) == 1);
-
-            min_x0 = mask_min(m_update_x,min_x0,min_x0,b_min_x);
-            min_y0 = mask_min(m_update_x,min_y0,min_y0,b_min_y);
-            min_z0 = mask_min(m_update_x,min_z0,min_z0,b_min_z);
-            // ------------------------------------------------------------------------      
-            max_x0 = mask_max(m_update_x,max_x0,max_x0,b_max_x);
-            max_y0 = mask_max(m_update_x,max_y0,max_y0,b_max_y);
-            max_z0 = mask_max(m_update_x,max_z0,max_z0,b_max_z);
-            // ------------------------------------------------------------------------
-            min_x1 = mask_min(m_update_y,min_x1,min_x1,b_min_x);
-            min_y1 = mask_min(m_update_y,min_y1,min_y1,b_min_y);
-            min_z1 = mask_min(m_update_y,min_z1,min_z1,b_min_z);      
-            // ------------------------------------------------------------------------      
-            max_x1 = mask_max(m_update_y,max_x1,max_x1,b_max_x);
-            max_y1 = mask_max(m_update_y,max_y1,max_y1,b_max_y);
-            max_z1 = mask_max(m_update_y,max_z1,max_z1,b_max_z);
-            // ------------------------------------------------------------------------
-            min_x2 = mask_min(m_update_z,min_x2,min_x2,b_min_x);
-            min_y2 = mask_min(m_update_z,min_y2,min_y2,b_min_y);
-            min_z2 = mask_min(m_update_z,min_z2,min_z2,b_min_z);
-            // ------------------------------------------------------------------------      
-            max_x2 = mask_max(m_update_z,max_x2,max_x2,b_max_x);
-            max_y2 = mask_max(m_update_z,max_y2,max_y2,b_max_y);
-            max_z2 = mask_max(m_update_z,max_z2,max_z2,b_max_z);
-            // ------------------------------------------------------------------------
-            count0 = mask_add(m_update_x,count0,count0,vint16(1));
-            count1 = mask_add(m_update_y,count1,count1,vint16(1));
-            count2 = mask_add(m_update_z,count2,count2,vint16(1));      
-          }
+        /*! for uneven number of primitives */
+        if (i < N)
+        {
+          BBox3fa prim0; Vec3fa center0; prims[i].binBoundsAndCenter(prim0,center0);
+          bin_prim(prim0,mapping.bin16(center0),step16,min_b,max_b,count_b);
+        }
 
+        for (size_t dim=0; dim<3; dim++) {
+          lower[dim] = min_b[dim]; upper[dim] = max_b[dim]; count[dim] = count_b[dim];
+        }
+      }
 
-          /* B */
-          {
-            const vfloat16 b_min_x = prims[i+1].lower.x;
-            const vfloat16 b_min_y = prims[i+1].lower.y;
-            const vfloat16 b_min_z = prims[i+1].lower.z;
-            const vfloat16 b_max_x = prims[i+1].upper.x;
-            const vfloat16 b_max_y = prims[i+1].upper.y;
-            const vfloat16 b_max_z = prims[i+1].upper.z;
-
-            const vint16 bin0 = shuffle<0>(binB);
-            const vint16 bin1 = shuffle<1>(binB);
-            const vint16 bin2 = shuffle<2>(binB);
-
-            const vbool16 m_update_x = step16 == bin0;
-            const vbool16 m_update_y = step16 == bin1;
-            const vbool16 m_update_z = step16 == bin2;
-
-            assert(__popcnt((size_t)m_update_x) == 1);
-            assert(__popcnt((size_t)m_update_y) == 1);
-            assert(__popcnt((size_t)m_update_z) == 1);
-
-            min_x0 = mask_min(m_update_x,min_x0,min_x0,b_min_x);
-            min_y0 = mask_min(m_update_x,min_y0,min_y0,b_min_y);
-            min_z0 = mask_min(m_update_x,min_z0,min_z0,b_min_z);
-            // ------------------------------------------------------------------------      
-            max_x0 = mask_max(m_update_x,max_x0,max_x0,b_max_x);
-            max_y0 = mask_max(m_update_x,max_y0,max_y0,b_max_y);
-            max_z0 = mask_max(m_update_x,max_z0,max_z0,b_max_z);
-            // ------------------------------------------------------------------------
-            min_x1 = mask_min(m_update_y,min_x1,min_x1,b_min_x);
-            min_y1 = mask_min(m_update_y,min_y1,min_y1,b_min_y);
-            min_z1 = mask_min(m_update_y,min_z1,min_z1,b_min_z);      
-            // ------------------------------------------------------------------------      
-            max_x1 = mask_max(m_update_y,max_x1,max_x1,b_max_x);
-            max_y1 = mask_max(m_update_y,max_y1,max_y1,b_max_y);
-            max_z1 = mask_max(m_update_y,max_z1,max_z1,b_max_z);
-            // ------------------------------------------------------------------------
-            min_x2 = mask_min(m_update_z,min_x2,min_x2,b_min_x);
-            min_y2 = mask_min(m_update_z,min_y2,min_y2,b_min_y);
-            min_z2 = mask_min(m_update_z,min_z2,min_z2,b_min_z);
-            // ------------------------------------------------------------------------      
-            max_x2 = mask_max(m_update_z,max_x2,max_x2,b_max_x);
-            max_y2 = mask_max(m_update_z,max_y2,max_y2,b_max_y);
-            max_z2 = mask_max(m_update_z,max_z2,max_z2,b_max_z);
-            // ------------------------------------------------------------------------
-            count0 = mask_add(m_update_x,count0,count0,vint16(1));
-            count1 = mask_add(m_update_y,count1,count1,vint16(1));
-            count2 = mask_add(m_update_z,count2,count2,vint16(1));      
-          }
+      /*! bins an array of primitives in the specified space */
+      __forceinline void bin (const PrimRef* prims, size_t N, const BinMapping<16>& mapping, const AffineSpace3fa& space)
+      {
+        const vint16 step16(step);
+        Vec3vf16 min_b[3], max_b[3]; vint16 count_b[3];
+        for (size_t dim=0; dim<3; dim++) {
+          min_b[dim] = Vec3vf16(pos_inf); max_b[dim] = Vec3vf16(neg_inf); count_b[dim] = vint16::zero();
+        }
 
+        size_t i;
+	for (i=0; i+1<N; i+=2)
+        {
+          BBox3fa primA; Vec3fa centerA; prims[i+0].binBoundsAndCenter(primA,centerA,space);
+          BBox3fa primB; Vec3fa centerB; prims[i+1].binBoundsAndCenter(primB,centerB,space);
+          const vint16 binA = mapping.bin16(centerA);
+          const vint16 binB = mapping.bin16(centerB);
+          bin_prim(primA,binA,step16,min_b,max_b,count_b);
+          bin_prim(primB,binB,step16,min_b,max_b,count_b);
         }
 
         if (i < N)
         {
-          const BBox3fa prim0 = prims[i].bounds();
-          const vfloat16 center0 = vfloat16((vfloat4)prim0.lower) + vfloat16((vfloat4)prim0.upper); 
-          const vint16 bin = mapping.bin16(center0);
-          const vfloat16 b_min_x = prims[i].lower.x;
-          const vfloat16 b_min_y = prims[i].lower.y;
-          const vfloat16 b_min_z = prims[i].lower.z;
-          const vfloat16 b_max_x = prims[i].upper.x;
-          const vfloat16 b_max_y = prims[i].upper.y;
-          const vfloat16 b_max_z = prims[i].upper.z;
-
-          const vint16 bin0 = shuffle<0>(bin);
-          const vint16 bin1 = shuffle<1>(bin);
-          const vint16 bin2 = shuffle<2>(bin);
-
-          const vbool16 m_update_x = step16 == bin0;
-          const vbool16 m_update_y = step16 == bin1;
-          const vbool16 m_update_z = step16 == bin2;
-
-          assert(__popcnt((size_t)m_update_x) == 1);
-          assert(__popcnt((size_t)m_update_y) == 1);
-          assert(__popcnt((size_t)m_update_z) == 1);
-
-          min_x0 = mask_min(m_update_x,min_x0,min_x0,b_min_x);
-          min_y0 = mask_min(m_update_x,min_y0,min_y0,b_min_y);
-          min_z0 = mask_min(m_update_x,min_z0,min_z0,b_min_z);
-          // ------------------------------------------------------------------------      
-          max_x0 = mask_max(m_update_x,max_x0,max_x0,b_max_x);
-          max_y0 = mask_max(m_update_x,max_y0,max_y0,b_max_y);
-          max_z0 = mask_max(m_update_x,max_z0,max_z0,b_max_z);
-          // ------------------------------------------------------------------------
-          min_x1 = mask_min(m_update_y,min_x1,min_x1,b_min_x);
-          min_y1 = mask_min(m_update_y,min_y1,min_y1,b_min_y);
-          min_z1 = mask_min(m_update_y,min_z1,min_z1,b_min_z);      
-          // ------------------------------------------------------------------------      
-          max_x1 = mask_max(m_update_y,max_x1,max_x1,b_max_x);
-          max_y1 = mask_max(m_update_y,max_y1,max_y1,b_max_y);
-          max_z1 = mask_max(m_update_y,max_z1,max_z1,b_max_z);
-          // ------------------------------------------------------------------------
-          min_x2 = mask_min(m_update_z,min_x2,min_x2,b_min_x);
-          min_y2 = mask_min(m_update_z,min_y2,min_y2,b_min_y);
-          min_z2 = mask_min(m_update_z,min_z2,min_z2,b_min_z);
-          // ------------------------------------------------------------------------      
-          max_x2 = mask_max(m_update_z,max_x2,max_x2,b_max_x);
-          max_y2 = mask_max(m_update_z,max_y2,max_y2,b_max_y);
-          max_z2 = mask_max(m_update_z,max_z2,max_z2,b_max_z);
-          // ------------------------------------------------------------------------
-          count0 = mask_add(m_update_x,count0,count0,vint16(1));
-          count1 = mask_add(m_update_y,count1,count1,vint16(1));
-          count2 = mask_add(m_update_z,count2,count2,vint16(1));      
-        }
-
-        lower[0] = Vec3vf16( min_x0, min_y0, min_z0 );
-        lower[1] = Vec3vf16( min_x1, min_y1, min_z1 );
-        lower[2] = Vec3vf16( min_x2, min_y2, min_z2 );
-
-        upper[0] = Vec3vf16( max_x0, max_y0, max_z0 );
-        upper[1] = Vec3vf16( max_x1, max_y1, max_z1 );
-        upper[2] = Vec3vf16( max_x2, max_y2, max_z2 );
-
-        count[0] = count0;
-        count[1] = count1;
-        count[2] = count2;
+          BBox3fa prim0; Vec3fa center0; prims[i].binBoundsAndCenter(prim0,center0,space);
+          bin_prim(prim0,mapping.bin16(center0),step16,min_b,max_b,count_b);
+        }
+
+        for (size_t dim=0; dim<3; dim++) {
+          lower[dim] = min_b[dim]; upper[dim] = max_b[dim]; count[dim] = count_b[dim];
+        }
       }
 
       __forceinline void bin(const PrimRef* prims, size_t begin, size_t end, const BinMapping<16>& mapping) {
 	bin(prims+begin,end-begin,mapping);
       }
 
+      __forceinline void bin(const PrimRef* prims, size_t begin, size_t end, const BinMapping<16>& mapping, const AffineSpace3fa& space) {
+	bin(prims+begin,end-begin,mapping,space);
+      }
+
       /*! merges in other binning information */
       __forceinline void merge (const BinInfoT& other, size_t numBins)
       {
@@ -755,13 +645,13 @@ namespace embree
         }
       }
 
-      /*! reducesr binning information */
-      static __forceinline const BinInfoT reduce (const BinInfoT& a, const BinInfoT& b)
+      /*! reduces binning information */
+      static __forceinline const BinInfoT reduce (const BinInfoT& a, const BinInfoT& b, const size_t numBins = 16)
       {
         BinInfoT c;
 	for (size_t i=0; i<3; i++) 
         {
-          c.counts[i] = a.counts[i] + b.counts[i];
+          c.count[i] = a.count[i] + b.count[i];
           c.lower[i]  = min(a.lower[i],b.lower[i]);
           c.upper[i]  = max(a.upper[i],b.upper[i]);
         }
@@ -834,24 +724,26 @@ namespace embree
 	  new (&info) SplitInfo(0,empty,0,empty);
 	  return;
 	}
-	// FIXME: horizontal reduction!
 
-	size_t leftCount = 0;
-	BBox3fa leftBounds = empty;
-	for (size_t i=0; i<(size_t)split.pos; i++) {
-	  leftCount += count[split.dim][i];
-          Vec3fa bounds_lower(lower[split.dim].x[i],lower[split.dim].y[i],lower[split.dim].z[i]);
-          Vec3fa bounds_upper(upper[split.dim].x[i],upper[split.dim].y[i],upper[split.dim].z[i]);
-	  leftBounds.extend(BBox3fa(bounds_lower,bounds_upper));
-	}
-	size_t rightCount = 0;
-	BBox3fa rightBounds = empty;
-	for (size_t i=split.pos; i<mapping.size(); i++) {
-	  rightCount += count[split.dim][i];
-          Vec3fa bounds_lower(lower[split.dim].x[i],lower[split.dim].y[i],lower[split.dim].z[i]);
-          Vec3fa bounds_upper(upper[split.dim].x[i],upper[split.dim].y[i],upper[split.dim].z[i]);
-	  rightBounds.extend(BBox3fa(bounds_lower,bounds_upper));
-	}
+        /* horizontal reductions over the bins left and right of the split */
+        const size_t dim = split.dim;
+        const vbool16 lmask = vint16(step) < vint16(split.pos);
+        const vbool16 rmask = !lmask;
+        const vfloat16 inf(pos_inf), ninf(neg_inf);
+        const size_t leftCount  = reduce_add(select(lmask,count[dim],vint16::zero()));
+        const size_t rightCount = reduce_add(select(rmask,count[dim],vint16::zero()));
+        const BBox3fa leftBounds(Vec3fa(reduce_min(select(lmask,lower[dim].x,inf)),
+                                        reduce_min(select(lmask,lower[dim].y,inf)),
+                                        reduce_min(select(lmask,lower[dim].z,inf))),
+                                 Vec3fa(reduce_max(select(lmask,upper[dim].x,ninf)),
+                                        reduce_max(select(lmask,upper[dim].y,ninf)),
+                                        reduce_max(select(lmask,upper[dim].z,ninf))));
+        const BBox3fa rightBounds(Vec3fa(reduce_min(select(rmask,lower[dim].x,inf)),
+                                         reduce_min(select(rmask,lower[dim].y,inf)),
+                                         reduce_min(select(rmask,lower[dim].z,inf))),
+                                  Vec3fa(reduce_max(select(rmask,upper[dim].x,ninf)),
+                                         reduce_max(select(rmask,upper[dim].y,ninf)),
+                                         reduce_max(select(rmask,upper[dim].z,ninf))));
 	new (&info) SplitInfo(leftCount,leftBounds,rightCount,rightBounds);
       }
 
@@ -859,24 +751,16 @@ namespace embree
       __forceinline size_t getLeftCount(const BinMapping<16>& mapping, const Split& split) const
       {
         if (unlikely(split.dim == -1)) return -1;
-
-        size_t leftCount = 0;
-        for (size_t i = 0; i < (size_t)split.pos; i++) {
-          leftCount += count[split.dim][i];
-        }
-        return leftCount;
+        const vbool16 lmask = vint16(step) < vint16(split.pos);
+        return reduce_add(select(lmask,count[split.dim],vint16::zero()));
       }
 
       /*! gets the number of primitives right of the split */
       __forceinline size_t getRightCount(const BinMapping<16>& mapping, const Split& split) const
       {
         if (unlikely(split.dim == -1)) return -1;
-
-        size_t rightCount = 0;
-        for (size_t i = (size_t)split.pos; i<mapping.size(); i++) {
-          rightCount += count[split.dim][i];
-        }
-        return rightCount;
+        const vbool16 rmask = vint16(step) >= vint16(split.pos);
+        return reduce_add(select(rmask,count[split.dim],vint16::zero()));
       }
             
     private:
@@ -22,6 +22,33 @@ namespace embree
 {
   namespace isa
   { 
+    /*! Dominant strand directions of some set of curves, the spaces
+     *  of the clusters are reused by all large nodes of the hierarchy */
+    struct OrientationClusters
+    {
+      static const size_t MAX_CLUSTERS = 8;
+
+      __forceinline OrientationClusters () 
+        : num(0) {}
+
+      /*! returns the cluster whose axis is closest to the direction */
+      __forceinline size_t nearest(const Vec3fa& dir) const
+      {
+        size_t best = 0;
+        float bestDot = neg_inf;
+        for (size_t k=0; k<num; k++) {
+          const float d = abs(dot(dir,axis[k]));
+          if (d > bestDot) { bestDot = d; best = k; }
+        }
+        return best;
+      }
+
+    public:
+      size_t num;                          //!< number of valid clusters
+      Vec3fa axis[MAX_CLUSTERS];           //!< normalized cluster directions
+      LinearSpace3fa space[MAX_CLUSTERS];  //!< cached aligned space of each cluster
+    };
+
     /*! Performs standard object binning */
     template<typename PrimRef, size_t BINS = 32>
       struct UnalignedHeuristicArrayBinningSAH
@@ -30,6 +57,12 @@ namespace embree
         typedef BinInfoT<BINS,PrimRef,BBox3fa> Binner;
         typedef range<size_t> Set;
 
+        static const size_t PARALLEL_THRESHOLD = 10000;
+        static const size_t PARALLEL_BLOCK_SIZE = 4096;
+        static const size_t CLUSTER_THRESHOLD = 4096;   //!< nodes with at least that many curves use the orientation clusters
+        static const size_t CLUSTER_ITERATIONS = 4;     //!< number of k-means iterations
+        static const size_t CLUSTER_SAMPLES = 16;       //!< number of curves sampled to select the cluster of a node
+
          /*! computes bounding box of bezier curves for motion blur */
         struct PrimInfoMB 
         {
@@ -39,14 +72,86 @@ namespace embree
         };
 
         __forceinline UnalignedHeuristicArrayBinningSAH ()
-          : prims(nullptr) {}
+          : prims(nullptr), clusters(nullptr) {}
         
         /*! remember prim array */
-        __forceinline UnalignedHeuristicArrayBinningSAH (PrimRef* prims)
-          : prims(prims) {}
+        __forceinline UnalignedHeuristicArrayBinningSAH (PrimRef* prims, const OrientationClusters* clusters = nullptr)
+          : prims(prims), clusters(clusters) {}
+
+        /*! returns true if the curve has a valid direction */
+        static __forceinline bool direction(const BezierPrim& prim, Vec3fa& dir) 
+        {
+          const Vec3fa d = prim.p3 - prim.p0;
+          if (sqr_length(d) <= 1E-18f) return false;
+          dir = normalize(d);
+          return true;
+        }
+
+        /*! clusters the curve directions using some k-means iterations */
+        void computeOrientationClusters(const PrimInfo& pinfo, OrientationClusters& clusters_o)
+        {
+          clusters_o.num = 0;
+          if (pinfo.size() < CLUSTER_THRESHOLD) return;
+
+          /* seed clusters with evenly spaced curves */
+          OrientationClusters c;
+          for (size_t k=0; k<OrientationClusters::MAX_CLUSTERS; k++) {
+            const size_t i = pinfo.begin + (2*k+1)*pinfo.size()/(2*OrientationClusters::MAX_CLUSTERS);
+            if (direction(prims[i],c.axis[c.num])) c.num++;
+          }
+          if (c.num == 0) return;
+
+          /* move each cluster to the average direction of its curves, opposite directions count as the same orientation */
+          struct DirSums { Vec3fa sum[OrientationClusters::MAX_CLUSTERS]; };
+          for (size_t iter=0; iter<CLUSTER_ITERATIONS; iter++)
+          {
+            DirSums identity; 
+            for (size_t k=0; k<c.num; k++) identity.sum[k] = Vec3fa(zero);
+            
+            const DirSums sums = parallel_reduce(pinfo.begin,pinfo.end,PARALLEL_BLOCK_SIZE,identity,[&] (const range<size_t>& r) -> DirSums
+            {
+              DirSums s = identity;
+              for (size_t i=r.begin(); i<r.end(); i++) 
+              {
+                Vec3fa dir; 
+                if (!direction(prims[i],dir)) continue;
+                const size_t k = c.nearest(dir);
+                s.sum[k] += dot(dir,c.axis[k]) < 0.0f ? -dir : dir;
+              }
+              return s;
+            }, [&] (const DirSums& a, const DirSums& b) -> DirSums {
+              DirSums s; 
+              for (size_t k=0; k<c.num; k++) s.sum[k] = a.sum[k] + b.sum[k];
+              return s;
+            });
+
+            for (size_t k=0; k<c.num; k++)
+              if (sqr_length(sums.sum[k]) > 1E-18f) c.axis[k] = normalize(sums.sum[k]);
+          }
+
+          for (size_t k=0; k<c.num; k++)
+            c.space[k] = frame(c.axis[k]).transposed();
+          clusters_o = c;
+        }
 
         const LinearSpace3fa computeAlignedSpace(const PrimInfo& pinfo)
         {
+          /*! large nodes select the cluster most of some sampled curves belong to */
+          if (clusters && clusters->num && pinfo.size() >= CLUSTER_THRESHOLD)
+          {
+            size_t votes[OrientationClusters::MAX_CLUSTERS];
+            for (size_t k=0; k<clusters->num; k++) votes[k] = 0;
+            for (size_t j=0; j<CLUSTER_SAMPLES; j++) {
+              Vec3fa dir;
+              if (direction(prims[pinfo.begin + j*pinfo.size()/CLUSTER_SAMPLES],dir))
+                votes[clusters->nearest(dir)]++;
+            }
+            size_t best = 0;
+            for (size_t k=1; k<clusters->num; k++) 
+              if (votes[k] > votes[best]) best = k;
+            if (votes[best]) return clusters->space[best];
+          }
+
           /*! find first curve that defines valid direction */
           Vec3fa axis(0,0,1);
           for (size_t i=pinfo.begin; i<pinfo.end; i++)
@@ -101,59 +206,79 @@ namespace embree
         
         const PrimInfo computePrimInfo(const PrimInfo& pinfo, const LinearSpace3fa& space)
         {
-          BBox3fa geomBounds = empty;
-          BBox3fa centBounds = empty;
-          for (size_t i=pinfo.begin; i<pinfo.end; i++) { // FIXME: parallel
-            const BBox3fa bounds = prims[i].bounds(space);
-            geomBounds.extend(bounds);
-            centBounds.extend(center2(bounds));
-          }
-          return PrimInfo(pinfo.begin,pinfo.end,geomBounds,centBounds);
+          const AffineSpace3fa xfm(space);
+          auto computeBounds = [&] (const range<size_t>& r) -> CentGeomBBox3fa
+          {
+            CentGeomBBox3fa bounds(empty);
+            for (size_t i=r.begin(); i<r.end(); i++)
+              bounds.extend(prims[i].bounds(xfm));
+            return bounds;
+          };
+
+          CentGeomBBox3fa bounds(empty);
+          if (likely(pinfo.size() < PARALLEL_THRESHOLD)) 
+            bounds = computeBounds(range<size_t>(pinfo.begin,pinfo.end));
+          else
+            bounds = parallel_reduce(pinfo.begin,pinfo.end,PARALLEL_BLOCK_SIZE,bounds,computeBounds,
+                                     [] (const CentGeomBBox3fa& a, const CentGeomBBox3fa& b) -> CentGeomBBox3fa { CentGeomBBox3fa r = a; r.merge(b); return r; });
+          return PrimInfo(pinfo.begin,pinfo.end,bounds.geomBounds,bounds.centBounds);
         }
         
         const PrimInfoMB computePrimInfoMB(size_t timeSegment, size_t numTimeSteps, Scene* scene, const PrimInfo& pinfo, const AffineSpace3fa& space)
         {
-          size_t N = 0;
-          BBox3fa centBounds = empty;
-          BBox3fa geomBounds = empty;
-          BBox3fa s0t0 = empty, s1t1 = empty;
-          for (size_t i=pinfo.begin; i<pinfo.end; i++)  // FIXME: parallelize
+          auto computeBounds = [&] (const range<size_t>& r) -> PrimInfoMB
           {
-            const BezierPrim& prim = prims[i];
-            const size_t geomID = prim.geomID();
-            const size_t primID = prim.primID();
+            CentGeomBBox3fa bounds(empty);
+            BBox3fa s0t0 = empty, s1t1 = empty;
+            for (size_t i=r.begin(); i<r.end(); i++)
+            {
+              const BezierPrim& prim = prims[i];
+              const size_t geomID = prim.geomID();
+              const size_t primID = prim.primID();
+              bounds.extend(prim.bounds(space));
+              
+              const BezierCurves* curves = scene->getBezierCurves(geomID);
+              const LBBox3fa linearBounds = curves->linearBounds(space,primID,timeSegment,numTimeSteps);
+              s0t0.extend(linearBounds.bounds0);
+              s1t1.extend(linearBounds.bounds1);
+            }
 
-            N++;
-            const BBox3fa bounds = prim.bounds(space);
-            geomBounds.extend(bounds);
-            centBounds.extend(center2(bounds));
+            PrimInfoMB ret;
+            ret.pinfo = PrimInfo(r.size(),bounds.geomBounds,bounds.centBounds);
+            ret.s0t0 = s0t0;
+            ret.s1t1 = s1t1;
+            return ret;
+          };
 
-            const BezierCurves* curves = scene->getBezierCurves(geomID);
-            const LBBox3fa linearBounds = curves->linearBounds(space,primID,timeSegment,numTimeSteps);
-            s0t0.extend(linearBounds.bounds0);
-            s1t1.extend(linearBounds.bounds1);
-          }
-          
-          PrimInfoMB ret;
-          ret.pinfo = PrimInfo(N,geomBounds,centBounds);
-          ret.s0t0 = s0t0;
-          ret.s1t1 = s1t1;
-          return ret;
+          if (likely(pinfo.size() < PARALLEL_THRESHOLD))
+            return computeBounds(range<size_t>(pinfo.begin,pinfo.end));
+
+          PrimInfoMB identity;
+          identity.pinfo = PrimInfo(empty);
+          identity.s0t0 = identity.s1t1 = empty;
+          return parallel_reduce(pinfo.begin,pinfo.end,PARALLEL_BLOCK_SIZE,identity,computeBounds,[] (const PrimInfoMB& a, const PrimInfoMB& b) -> PrimInfoMB
+          {
+            PrimInfoMB ret;
+            ret.pinfo = PrimInfo::merge(a.pinfo,b.pinfo);
+            ret.s0t0 = merge(a.s0t0,b.s0t0);
+            ret.s1t1 = merge(a.s1t1,b.s1t1);
+            return ret;
+          });
         }
         
         /*! finds the best split */
         const Split find(const PrimInfo& pinfo, const size_t logBlockSize, const LinearSpace3fa& space)
         {
           Set set(pinfo.begin,pinfo.end);
-          if (likely(pinfo.size() < 10000)) return sequential_find(set,pinfo,logBlockSize,space);
-          else                              return   parallel_find(set,pinfo,logBlockSize,space);
+          if (likely(pinfo.size() < PARALLEL_THRESHOLD)) return sequential_find(set,pinfo,logBlockSize,space);
+          else                                           return   parallel_find(set,pinfo,logBlockSize,space);
         }
         
         /*! finds the best split */
         const Split find(const Set& set, const PrimInfo& pinfo, const size_t logBlockSize, const LinearSpace3fa& space)
         {
-          if (likely(pinfo.size() < 10000)) return sequential_find(set,pinfo,logBlockSize,space);
-          else                              return   parallel_find(set,pinfo,logBlockSize,space);
+          if (likely(pinfo.size() < PARALLEL_THRESHOLD)) return sequential_find(set,pinfo,logBlockSize,space);
+          else                                           return   parallel_find(set,pinfo,logBlockSize,space);
         }
 
         /*! finds the best split */
@@ -171,7 +296,7 @@ namespace embree
           Binner binner(empty);
           const BinMapping<BINS> mapping(pinfo);
           const BinMapping<BINS>& _mapping = mapping; // CLANG 3.4 parser bug workaround
-          binner = parallel_reduce(set.begin(),set.end(),size_t(4096),binner,
+          binner = parallel_reduce(set.begin(),set.end(),PARALLEL_BLOCK_SIZE,binner,
                                    [&] (const range<size_t>& r) -> Binner { Binner binner(empty); binner.bin(prims+r.begin(),r.size(),_mapping,space); return binner; },
                                    [&] (const Binner& b0, const Binner& b1) -> Binner { Binner r = b0; r.merge(b1,_mapping.size()); return r; });
           return binner.best(mapping,logBlockSize);
@@ -206,7 +331,7 @@ namespace embree
           const int splitPos = split.pos;
           const int splitDim = split.dim;
           size_t center = 0;
-          if (likely(set.size() < 10000))
+          if (likely(set.size() < PARALLEL_THRESHOLD))
             center = serial_partitioning(prims,begin,end,local_left,local_right,
                                          [&] (const PrimRef& ref) { return split.mapping.bin_unsafe(center2(ref.bounds(space)))[splitDim] < splitPos; },
                                          [] (CentGeomBBox3fa& pinfo,const PrimRef& ref) { pinfo.extend(ref.bounds()); });
@@ -261,6 +386,7 @@ namespace embree
         
       private:
         PrimRef* const prims;
+        const OrientationClusters* clusters;
       };
   }
 }
@@ -18,6 +18,7 @@
 
 #include "heuristic_binning.h"
 #include "heuristic_spatial.h"
+#include "heuristic_sweep_array_aligned.h"
 
 namespace embree
 {
@@ -33,58 +34,73 @@ namespace embree
 #define SPATIAL_ASPLIT_AREA_THRESHOLD 0.000005f
 #endif
 
-    template<typename ObjectSplit, typename SpatialSplit>
+    template<typename ObjectSplit, typename SpatialSplit, typename SweepSplit>
       struct Split2
       {
         __forceinline Split2 () {}
-        
+
         __forceinline Split2 (const Split2& other) 
         {
           spatial = other.spatial;
+          sweep = other.sweep;
           sah = other.sah;
-          if (spatial) spatialSplit() = other.spatialSplit();
-          else         objectSplit()  = other.objectSplit();
+          if      (spatial) spatialSplit() = other.spatialSplit();
+          else if (sweep)   sweepSplit()   = other.sweepSplit();
+          else              objectSplit()  = other.objectSplit();
         }
-        
+
         __forceinline Split2& operator= (const Split2& other) 
         {
           spatial = other.spatial;
+          sweep = other.sweep;
           sah = other.sah;
-          if (spatial) spatialSplit() = other.spatialSplit();
-          else         objectSplit()  = other.objectSplit();
+          if      (spatial) spatialSplit() = other.spatialSplit();
+          else if (sweep)   sweepSplit()   = other.sweepSplit();
+          else              objectSplit()  = other.objectSplit();
           return *this;
         }
-          
+
           __forceinline     ObjectSplit&  objectSplit()        { return *(      ObjectSplit*)data; }
         __forceinline const ObjectSplit&  objectSplit() const  { return *(const ObjectSplit*)data; }
-        
+
         __forceinline       SpatialSplit& spatialSplit()       { return *(      SpatialSplit*)data; }
         __forceinline const SpatialSplit& spatialSplit() const { return *(const SpatialSplit*)data; }
-        
+
+        __forceinline       SweepSplit& sweepSplit()           { return *(      SweepSplit*)data; }
+        __forceinline const SweepSplit& sweepSplit() const     { return *(const SweepSplit*)data; }
+
         __forceinline Split2 (const ObjectSplit& objectSplit, float sah)
-          : spatial(false), sah(sah) 
+          : spatial(false), sweep(false), sah(sah) 
         {
           new (data) ObjectSplit(objectSplit);
         }
-        
+
         __forceinline Split2 (const SpatialSplit& spatialSplit, float sah)
-          : spatial(true), sah(sah) 
+          : spatial(true), sweep(false), sah(sah) 
         {
           new (data) SpatialSplit(spatialSplit);
         }
-        
+
+        __forceinline Split2 (const SweepSplit& sweepSplit, float sah)
+          : spatial(false), sweep(true), sah(sah) 
+        {
+          new (data) SweepSplit(sweepSplit);
+        }
+
         __forceinline float splitSAH() const { 
           return sah; 
         }
-        
+
         __forceinline bool valid() const {
           return sah < float(inf);
         }
-        
+
       public:
         bool spatial;
+        bool sweep;
         float sah;
-        __aligned(16) char data[sizeof(ObjectSplit) > sizeof(SpatialSplit) ? sizeof(ObjectSplit) : sizeof(SpatialSplit)];
+        enum { DATA_SIZE = sizeof(ObjectSplit) > sizeof(SpatialSplit) ? sizeof(ObjectSplit) : sizeof(SpatialSplit) };
+        __aligned(16) char data[DATA_SIZE > sizeof(SweepSplit) ? DATA_SIZE : sizeof(SweepSplit)];
       };
     
     /*! Performs standard object binning */
@@ -101,8 +117,11 @@ namespace embree
         typedef SpatialBinSplit<SPATIAL_BINS> SpatialSplit;
         typedef SpatialBinInfo<SPATIAL_BINS,PrimRef> SpatialBinner;
 
+        typedef HeuristicArraySweepSAH<PrimRef> SweepHeuristic;
+        typedef typename SweepHeuristic::Split SweepSplit;
+
         typedef extended_range<size_t> Set;
-        typedef Split2<ObjectSplit,SpatialSplit> Split;
+        typedef Split2<ObjectSplit,SpatialSplit,SweepSplit> Split;
         
 #if defined(__AVX512F__)
         static const size_t PARALLEL_THRESHOLD = 3*1024; 
@@ -118,11 +137,11 @@ namespace embree
         static const size_t CREATE_SPLITS_STEP_SIZE = 64;
 
         __forceinline HeuristicArraySpatialSAH ()
-          : prims0(nullptr) {}
+          : prims0(nullptr), sweepThreshold(0) {}
         
-        /*! remember prim array */
-        __forceinline HeuristicArraySpatialSAH (const PrimitiveSplitterFactory& splitterFactory, PrimRef* prims0, const PrimInfo &root_info)
-          : prims0(prims0), splitterFactory(splitterFactory), root_info(root_info) {}
+        /*! remember prim array, object splits of nodes with at least sweepThreshold primitives are found by a full SAH sweep (0 disables) */
+        __forceinline HeuristicArraySpatialSAH (const PrimitiveSplitterFactory& splitterFactory, PrimRef* prims0, const PrimInfo &root_info, const size_t sweepThreshold = 0)
+          : prims0(prims0), splitterFactory(splitterFactory), root_info(root_info), sweep(prims0), sweepThreshold(sweepThreshold) {}
 
 
         /*! compute extended ranges */
@@ -175,7 +194,7 @@ namespace embree
         const Split find(Set& set, PrimInfo& pinfo, const size_t logBlockSize)
         {
           SplitInfo oinfo;
-          const ObjectSplit object_split = object_find(set,pinfo,logBlockSize,oinfo);
+          const Split object_split = object_or_sweep_find(set,pinfo,logBlockSize,oinfo);
           const float object_split_sah = object_split.splitSAH();
 
           if (unlikely(set.has_ext_range()))
@@ -198,7 +217,23 @@ namespace embree
             }
           }
 
-          return Split(object_split,object_split_sah);
+          return object_split;
+        }
+
+        /*! finds the best object split, large nodes sweep over all split positions, small nodes use binning */
+        __forceinline const Split object_or_sweep_find(const Set& set, const PrimInfo& pinfo, const size_t logBlockSize, SplitInfo &info)
+        {
+          if (likely(sweepThreshold == 0 || pinfo.size() < sweepThreshold)) {
+            const ObjectSplit object_split = object_find(set,pinfo,logBlockSize,info);
+            return Split(object_split,object_split.splitSAH());
+          }
+
+          const range<size_t> rset(set.begin(),set.end());
+          const SweepSplit sweep_split = sweep.find(rset,pinfo,logBlockSize);
+          info = SplitInfo(0,empty,0,empty);
+          if (unlikely(set.has_ext_range() && sweep_split.valid())) 
+            sweep.getSplitInfo(rset,sweep_split,info);
+          return Split(sweep_split,sweep_split.splitSAH());
         }
 
         /*! finds the best object split */
@@ -350,6 +385,11 @@ namespace embree
             else
               ext_weights = parallel_spatial_split(split.spatialSplit(),set,left,lset,right,rset);
           }
+          else if (unlikely(split.sweep))
+          {
+            /* object split found by sweeping */
+            ext_weights = sweep_split(split.sweepSplit(),set,left,lset,right,rset);
+          }
           else
           {
             /* object split */
@@ -497,6 +537,43 @@ namespace embree
           return std::pair<size_t,size_t>(left_weight,right_weight);
         }
 
+        /*! array partitioning */
+        __noinline std::pair<size_t,size_t> sweep_split(const SweepSplit& split, const Set& set, PrimInfo& left, Set& lset, PrimInfo& right, Set& rset)
+        {
+          const size_t begin = set.begin();
+          const size_t end   = set.end();
+          left.reset(); 
+          right.reset();
+          const unsigned int splitDim = split.dim;
+          const float splitValue = split.value;
+
+          auto isLeft = [&] (const PrimRef &ref) { return ref.bounds().center()[splitDim] < splitValue; };
+
+          size_t center = 0;
+          if (likely(set.size() < PARALLEL_THRESHOLD))
+            center = serial_partitioning(prims0,begin,end,left,right,isLeft,
+                                         [] (PrimInfo &pinfo,const PrimRef &ref) { pinfo.add(ref.bounds(),ref.lower.a >> 24); });
+          else
+            center = parallel_partitioning(
+              prims0,begin,end,empty,left,right,isLeft,
+              [] (PrimInfo &pinfo,const PrimRef &ref) { pinfo.add(ref.bounds(),ref.lower.a >> 24); },
+              [] (PrimInfo &pinfo0,const PrimInfo &pinfo1) { pinfo0.merge(pinfo1); },
+              PARALLEL_PARITION_BLOCK_SIZE);
+
+          const size_t left_weight  = left.end;
+          const size_t right_weight = right.end;
+          
+          left.begin  = begin;  left.end  = center; 
+          right.begin = center; right.end = end;
+          
+          new (&lset) extended_range<size_t>(begin,center,center);
+          new (&rset) extended_range<size_t>(center,end,end);
+
+          assert(area(left.geomBounds) >= 0.0f);
+          assert(area(right.geomBounds) >= 0.0f);
+          return std::pair<size_t,size_t>(left_weight,right_weight);
+        }
+
         /*! array partitioning */
         __noinline std::pair<size_t,size_t> parallel_spatial_split(const SpatialSplit& split, const Set& set, PrimInfo& left, Set& lset, PrimInfo& right, Set& rset)
         {
@@ -582,6 +659,8 @@ namespace embree
         PrimRef* const prims0;
         const PrimitiveSplitterFactory& splitterFactory;
         const PrimInfo& root_info;
+        SweepHeuristic sweep;
+        const size_t sweepThreshold;
       };
   }
 }
@@ -17,6 +17,8 @@
 #pragma once
 
 #include "heuristic_binning.h"
+#include "../../common/algorithms/parallel_sort.h"
+#include "../../common/algorithms/parallel_prefix_sum.h"
 
 //#define DBG_PRINT(x) PRINT(x)
 #define DBG_PRINT(x) 
@@ -34,11 +36,11 @@ namespace embree
         {
           /*! construct an invalid split by default */
           __forceinline Split()
-            : sah(inf), dim(-1), pos(0), data(0) {}
+            : sah(inf), dim(-1), pos(0), data(0), value(0.0f) {}
         
           /*! constructs specified split */
-          __forceinline Split(float sah, int dim, int pos)
-            : sah(sah), dim(dim), pos(pos), data(0) {}
+          __forceinline Split(float sah, int dim, int pos, float value)
+            : sah(sah), dim(dim), pos(pos), data(0), value(value) {}
         
           /*! tests if this split is valid */
           __forceinline bool valid() const { return dim != -1; }
@@ -54,8 +56,9 @@ namespace embree
         public:
           float sah;                //!< SAH cost of the split
           int dim;                  //!< split dimension
-          int pos;                  //!< bin index for splitting
+          int pos;                  //!< number of primitives left of the split
           unsigned int data;        //!< extra optional split data
+          float value;              //!< centroid coordinate of the first primitive right of the split
         };
 
         typedef range<size_t> Set;
@@ -79,6 +82,33 @@ namespace embree
 
           __forceinline bool operator<(const Centroid &m) const { return v < m.v; } 
 
+          /*! radix sort key that preserves the ordering of the floating point values */
+          __forceinline operator unsigned int() const {
+            const unsigned int i = (unsigned int) cast_f2i(v);
+            return (i & 0x80000000) ? ~i : (i | 0x80000000);
+          }
+        };
+
+        /*! prefix bounds of the sweep together with the best split found so far */
+        struct SweepInfo
+        {
+          __forceinline SweepInfo () {}
+
+          __forceinline SweepInfo (EmptyTy)
+            : bounds(empty), sah(inf), pos(0) {}
+
+          __forceinline SweepInfo (const BBox3fa& bounds, float sah, size_t pos)
+            : bounds(bounds), sah(sah), pos(pos) {}
+
+          /*! merges bounds and keeps the first best split */
+          static __forceinline const SweepInfo merge (const SweepInfo& a, const SweepInfo& b) {
+            return SweepInfo(embree::merge(a.bounds,b.bounds), b.sah < a.sah ? b.sah : a.sah, b.sah < a.sah ? b.pos : a.pos);
+          }
+
+        public:
+          BBox3fa bounds;
+          float sah;
+          size_t pos;
         };
 
         __forceinline HeuristicArraySweepSAH ()
@@ -156,6 +186,7 @@ namespace embree
           float bestSAH = inf;
           int   bestDim = -1;
           int   bestPos = 0;
+          float bestValue = 0.0f;
           for (size_t dim = 0;dim<3;dim++)
           {
             if (unlikely(scale[dim] == 0.0f)) continue;
@@ -187,6 +218,7 @@ namespace embree
                 bestDim = (int)dim;
                 bestPos = (int)i;
                 bestSAH = sah;
+                bestValue = centroid[dim][i].v;
               }
             }
 
@@ -198,14 +230,132 @@ namespace embree
           delete [] centroid[1];
           delete [] centroid[2];
 
-          DBG_PRINT(Split(bestSAH,bestDim,bestPos));
-          return Split(bestSAH,bestDim,bestPos);
+          DBG_PRINT(Split(bestSAH,bestDim,bestPos,bestValue));
+          return Split(bestSAH,bestDim,bestPos,bestValue);
         }
         
-        /*! finds the best split */
+        /*! finds the best split, sorts the centroids with a parallel
+         *  radix sort and evaluates all split positions with parallel
+         *  prefix sums over the primitive bounds */
         __noinline const Split parallel_find(const Set& set, const PrimInfo& pinfo, const size_t logBlockSize)
         {
-          return sequential_find(set,pinfo,logBlockSize);
+          assert(pinfo.size() == set.size());
+          const size_t numPrims = pinfo.size();
+          const size_t begin = set.begin();
+          assert(numPrims);
+
+          /* create temporary arrays */
+          Centroid* centroid = new Centroid[numPrims];
+          Centroid* temp = new Centroid[numPrims];
+          float* right_area = new float[numPrims];
+
+          const vfloat4 diag = (vfloat4)pinfo.centBounds.size();
+          const vfloat4 scale = select(diag > vfloat4(1E-34f),diag,vfloat4(0.0f));
+          const size_t blocks_add = (1 << logBlockSize)-1;
+
+          float bestSAH = inf;
+          int   bestDim = -1;
+          int   bestPos = 0;
+          float bestValue = 0.0f;
+          for (size_t dim = 0;dim<3;dim++)
+          {
+            if (unlikely(scale[dim] == 0.0f)) continue;
+
+            /* init & sort centroids of this dimension */
+            parallel_for(size_t(0), numPrims, PARALLEL_FIND_BLOCK_SIZE, [&](const range<size_t>& r) {
+                for (size_t i=r.begin(); i<r.end(); i++)
+                  new (&centroid[i]) Centroid(prims[begin+i].bounds().center()[dim],begin+i);
+              });
+            radix_sort_u32(centroid,temp,numPrims);
+
+            /* compute area from right to left */
+            ParallelPrefixSumState<BBox3fa> rstate;
+            auto right_sweep = [&] (const range<size_t>& r, const BBox3fa& sum, const bool store) -> BBox3fa
+            {
+              BBox3fa local(empty);
+              for (size_t j=r.begin(); j<r.end(); j++) {
+                const size_t i = numPrims-1-j;
+                local.extend(prims[centroid[i].id].bounds());
+                if (store) right_area[i] = halfArea(merge(sum,local));
+              }
+              return local;
+            };
+            auto merge_bounds = [] (const BBox3fa& a, const BBox3fa& b) -> BBox3fa { return merge(a,b); };
+            parallel_prefix_sum(rstate,size_t(0),numPrims,PARALLEL_FIND_BLOCK_SIZE,BBox3fa(empty),
+                                [&] (const range<size_t>& r, const BBox3fa& sum) -> BBox3fa { return right_sweep(r,sum,false); },merge_bounds);
+            parallel_prefix_sum(rstate,size_t(0),numPrims,PARALLEL_FIND_BLOCK_SIZE,BBox3fa(empty),
+                                [&] (const range<size_t>& r, const BBox3fa& sum) -> BBox3fa { return right_sweep(r,sum,true); },merge_bounds);
+
+            /* compute left bounds from left to right and find best sah */
+            ParallelPrefixSumState<SweepInfo> lstate;
+            parallel_prefix_sum(lstate,size_t(0),numPrims,PARALLEL_FIND_BLOCK_SIZE,SweepInfo(empty),[&] (const range<size_t>& r, const SweepInfo& sum) -> SweepInfo 
+            {
+              BBox3fa local(empty);
+              for (size_t i=r.begin(); i<r.end(); i++)
+                local.extend(prims[centroid[i].id].bounds());
+              return SweepInfo(local,inf,0);
+            },SweepInfo::merge);
+
+            const SweepInfo best = parallel_prefix_sum(lstate,size_t(0),numPrims,PARALLEL_FIND_BLOCK_SIZE,SweepInfo(empty),[&] (const range<size_t>& r, const SweepInfo& sum) -> SweepInfo
+            {
+              BBox3fa local(empty);
+              SweepInfo best(empty);
+              for (size_t i=r.begin(); i<r.end(); i++)
+              {
+                if (i > 0 && centroid[i-1].v != centroid[i].v)
+                {
+                  const size_t numLeft = i;
+                  const size_t numRight = numPrims-numLeft;
+                  const float lArea = halfArea(merge(sum.bounds,local));
+                  const float rArea = right_area[i];
+                  const size_t lCount = (numLeft +blocks_add) >> logBlockSize;
+                  const size_t rCount = (numRight+blocks_add) >> logBlockSize;
+                  const float sah = lArea*lCount + rArea*rCount;
+                  if (unlikely(sah < best.sah)) {
+                    best.sah = sah;
+                    best.pos = i;
+                  }
+                }
+                local.extend(prims[centroid[i].id].bounds());
+              }
+              best.bounds = local;
+              return best;
+            },SweepInfo::merge);
+
+            if (best.sah < bestSAH) {
+              bestDim = (int)dim;
+              bestPos = (int)best.pos;
+              bestSAH = best.sah;
+              bestValue = centroid[best.pos].v;
+            }
+          }
+
+          /* delete temporary arrays */
+          delete [] right_area;
+          delete [] temp;
+          delete [] centroid;
+
+          return Split(bestSAH,bestDim,bestPos,bestValue);
+        }
+
+        /*! computes the bounds of both sides of some split */
+        void getSplitInfo(const Set& set, const Split& split, SplitInfo& info)
+        {
+          const int splitDim = split.dim;
+          const float splitValue = split.value;
+          info = parallel_reduce(set.begin(),set.end(),PARALLEL_FIND_BLOCK_SIZE,SplitInfo(0,empty,0,empty),[&] (const range<size_t>& r) -> SplitInfo
+          {
+            SplitInfo info(0,empty,0,empty);
+            for (size_t i=r.begin(); i<r.end(); i++)
+            {
+              const BBox3fa bounds = prims[i].bounds();
+              if (bounds.center()[splitDim] < splitValue) { info.leftCount++;  info.leftBounds.extend(bounds); }
+              else                                        { info.rightCount++; info.rightBounds.extend(bounds); }
+            }
+            return info;
+          }, [] (const SplitInfo& a, const SplitInfo& b) -> SplitInfo {
+            return SplitInfo(a.leftCount+b.leftCount,merge(a.leftBounds,b.leftBounds),a.rightCount+b.rightCount,merge(a.rightBounds,b.rightBounds));
+          });
         }
         
         /*! array partitioning */
@@ -240,26 +390,26 @@ namespace embree
           const size_t end   = set.end();
           CentGeomBBox3fa local_left(empty);
           CentGeomBBox3fa local_right(empty);
-          const unsigned int splitPos = split.pos;
           const unsigned int splitDim = split.dim;
+          const float splitValue = split.value;
 
-          /* sort prims according to best split dimension */
-          std::sort(&prims[begin],&prims[end], [&](const PrimRef &a, const PrimRef &b) -> bool { 
-              const Vec3fa centerA = a.bounds().center();
-              const Vec3fa centerB = b.bounds().center();
-              return centerA[splitDim] < centerB[splitDim];
-            });
+          /* partition prims at the centroid of the first primitive right of the split */
+          auto isLeft = [&] (const PrimRef& ref) { return ref.bounds().center()[splitDim] < splitValue; };
+          size_t center = 0;
+          if (!parallel)
+            center = serial_partitioning(prims,begin,end,local_left,local_right,isLeft,
+                                         [] (CentGeomBBox3fa& pinfo,const PrimRef& ref) { pinfo.extend(ref.bounds()); });          
+          else
+            center = parallel_partitioning(
+              prims,begin,end,empty,local_left,local_right,isLeft,
+              [] (CentGeomBBox3fa& pinfo,const PrimRef &ref) { pinfo.extend(ref.bounds()); },
+              [] (CentGeomBBox3fa& pinfo0,const CentGeomBBox3fa &pinfo1) { pinfo0.merge(pinfo1); },
+              PARALLEL_PARITION_BLOCK_SIZE);
 
-          const size_t center = begin + splitPos;
+          assert(center == begin + split.pos);
           assert(begin < center);
           assert(center < end);
 
-          /* compute left, right pinfos */
-          for (size_t i = begin;i<center;i++)
-            local_left.extend(prims[i].bounds());
-          for (size_t i = center;i<end;i++)
-            local_right.extend(prims[i].bounds());
-
           new (&left ) PrimInfo(begin,center,local_left.geomBounds,local_left.centBounds);
           new (&right) PrimInfo(center,end,local_right.geomBounds,local_right.centBounds);
           new (&lset) range<size_t>(begin,center);
@@ -0,0 +1,134 @@
+// ======================================================================== //
+// Copyright 2009-2016 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#pragma once
+
+#include "heuristic_binning.h"
+#include "../common/scene.h"
+#include "../../common/algorithms/parallel_reduce.h"
+
+namespace embree
+{
+  namespace isa
+  {
+    /*! Evaluates the time-aware SAH of splitting a motion blur time
+     *  segment into temporal sub-ranges. Primitives are binned with
+     *  their linear bounds over each sub-range, thus the cost
+     *  accounts for the motion of the primitives inside that
+     *  range. */
+    template<typename Mesh, size_t BINS = 32>
+      struct HeuristicArrayTimeSplitSAH
+      {
+        /*! primitive reference with linear bounds over some time range */
+        struct PrimRefLB
+        {
+          __forceinline PrimRefLB () {}
+
+          __forceinline PrimRefLB (const LBBox3fa& lbounds)
+            : lbounds(lbounds) {}
+
+          /*! returns bounds and centroid used for binning */
+          __forceinline void binBoundsAndCenter(LBBox3fa& bounds_o, Vec3fa& center_o) const {
+            bounds_o = lbounds;
+            center_o = center2(lbounds);
+          }
+
+          LBBox3fa lbounds;
+        };
+
+        typedef BinSplit<BINS> Split;
+        typedef BinInfoT<BINS,PrimRefLB,LBBox3fa> Binner;
+
+        static const size_t PARALLEL_THRESHOLD = 3 * 1024;
+        static const size_t PARALLEL_FIND_BLOCK_SIZE = 1024;
+
+        HeuristicArrayTimeSplitSAH (Scene* scene, const PrimRef* prims, size_t numPrims, size_t itime, size_t numTimeSteps)
+          : scene(scene), prims(prims), numPrims(numPrims), itime(itime), numTimeSteps(numTimeSteps), lprims(scene->device,numPrims) {}
+
+        /*! calculates the linear bounds of the primitives over the time range dt */
+        const PrimInfo2 computePrimInfoMB(const BBox1f& dt)
+        {
+          return parallel_reduce(size_t(0),numPrims,PARALLEL_FIND_BLOCK_SIZE,PrimInfo2(empty),[&] (const range<size_t>& r) -> PrimInfo2
+          {
+            PrimInfo2 pinfo(empty);
+            for (size_t i=r.begin(); i<r.end(); i++)
+            {
+              const Mesh* mesh = (Mesh*) scene->get(prims[i].geomID());
+              lprims[i] = PrimRefLB(mesh->linearBounds(prims[i].primID(),itime,numTimeSteps).interpolate(dt));
+              pinfo.add_primref(lprims[i]);
+            }
+            return pinfo;
+          }, [] (const PrimInfo2& a, const PrimInfo2& b) -> PrimInfo2 { return PrimInfo2::merge(a,b); });
+        }
+
+        /*! calculates the expected cost of a BVH over the time range
+         *  dt, weighted by the probability of a ray time in dt */
+        float sah(const BBox1f& dt, const size_t logBlockSize, const float travCost, const float intCost)
+        {
+          const PrimInfo2 pinfo = computePrimInfoMB(dt);
+          const BinMapping<BINS> mapping(pinfo.centBounds,pinfo.size());
+
+          Binner binner(empty);
+          if (likely(numPrims < PARALLEL_THRESHOLD))
+            binner.bin(lprims.data(),numPrims,mapping);
+          else
+          {
+            const BinMapping<BINS>& _mapping = mapping; // CLANG 3.4 parser bug workaround
+            binner = parallel_reduce(size_t(0),numPrims,PARALLEL_FIND_BLOCK_SIZE,binner,
+                                     [&](const range<size_t>& r) -> Binner { Binner binner(empty); binner.bin(lprims.data() + r.begin(), r.size(), _mapping); return binner; },
+                                     [&](const Binner& b0, const Binner& b1) -> Binner { Binner r = b0; r.merge(b1, _mapping.size()); return r; });
+          }
+
+          const Split split = binner.best(mapping,logBlockSize);
+          const float splitSAH = split.valid() ? split.splitSAH() : pinfo.leafSAH(logBlockSize);
+          return dt.size()*(travCost*expectedApproxHalfArea(pinfo.geomBounds) + intCost*splitSAH);
+        }
+
+        /*! returns the number of temporal splits of the time segment,
+         *  the time range is halved as long as this reduces the
+         *  expected cost by at least the minGain fraction */
+        size_t numTimeSplits(const size_t maxTimeSplits, const size_t logBlockSize, const float travCost, const float intCost, const float minGain)
+        {
+          size_t numSplits = 1;
+          float cost = sah(BBox1f(0.0f,1.0f),logBlockSize,travCost,intCost);
+          while (2*numSplits <= maxTimeSplits)
+          {
+            float splitCost = 0.0f;
+            for (size_t i=0; i<2*numSplits; i++)
+              splitCost += sah(timeSplit(i,2*numSplits),logBlockSize,travCost,intCost);
+
+            if (!(splitCost < (1.0f-minGain)*cost)) break;
+            numSplits *= 2;
+            cost = splitCost;
+          }
+          return numSplits;
+        }
+
+        /*! returns the time range of the i'th of numSplits temporal splits */
+        static __forceinline BBox1f timeSplit(const size_t i, const size_t numSplits) {
+          return BBox1f(float(i+0)/float(numSplits),float(i+1)/float(numSplits));
+        }
+
+      private:
+        Scene* scene;
+        const PrimRef* prims;
+        const size_t numPrims;
+        const size_t itime;
+        const size_t numTimeSteps;
+        mvector<PrimRefLB> lprims;
+      };
+  }
+}
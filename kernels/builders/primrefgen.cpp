@@ -18,11 +18,92 @@
 
 #include "../../common/algorithms/parallel_for_for.h"
 #include "../../common/algorithms/parallel_for_for_prefix_sum.h"
+#include "../../common/algorithms/parallel_reduce.h"
 
 namespace embree
 {
   namespace isa
   {
+    /*! creates the primrefs of a range of primitives of a mesh */
+    template<typename Mesh>
+    __forceinline PrimInfo createPrimRefs(Mesh* mesh, const range<size_t>& r, size_t k, mvector<PrimRef>& prims)
+    {
+      PrimInfo pinfo(empty);
+      for (size_t j=r.begin(); j<r.end(); j++)
+      {
+        BBox3fa bounds = empty;
+        if (!mesh->buildBounds(j,&bounds)) continue;
+        const PrimRef prim(bounds,mesh->id,unsigned(j));
+        pinfo.add(bounds,bounds.center2());
+        prims[k++] = prim;
+      }
+      return pinfo;
+    }
+
+    /*! creates the primrefs of a range of primitives of a mesh, 4 primitives at a time */
+    template<typename Mesh>
+    __forceinline PrimInfo createPrimRefs4(Mesh* mesh, const range<size_t>& r, size_t k, mvector<PrimRef>& prims)
+    {
+      const size_t k0 = k;
+      Vec3vf4 geomLower(pos_inf), geomUpper(neg_inf);
+      Vec3vf4 centLower(pos_inf), centUpper(neg_inf);
+      const vfloat4 geomID = asFloat(vint4(int(mesh->id)));
+
+      for (size_t j=r.begin(); j<r.end(); j+=4)
+      {
+        Vec3vf4 lower, upper;
+        const vbool4 valid = mesh->buildBounds4(j,min(r.end()-j,size_t(4)),lower,upper);
+        if (none(valid)) continue;
+
+        /* extend geometry and centroid bounds by valid primitives only */
+        const Vec3vf4 center = lower+upper;
+        geomLower.x = select(valid,min(geomLower.x,lower.x),geomLower.x);
+        geomLower.y = select(valid,min(geomLower.y,lower.y),geomLower.y);
+        geomLower.z = select(valid,min(geomLower.z,lower.z),geomLower.z);
+        geomUpper.x = select(valid,max(geomUpper.x,upper.x),geomUpper.x);
+        geomUpper.y = select(valid,max(geomUpper.y,upper.y),geomUpper.y);
+        geomUpper.z = select(valid,max(geomUpper.z,upper.z),geomUpper.z);
+        centLower.x = select(valid,min(centLower.x,center.x),centLower.x);
+        centLower.y = select(valid,min(centLower.y,center.y),centLower.y);
+        centLower.z = select(valid,min(centLower.z,center.z),centLower.z);
+        centUpper.x = select(valid,max(centUpper.x,center.x),centUpper.x);
+        centUpper.y = select(valid,max(centUpper.y,center.y),centUpper.y);
+        centUpper.z = select(valid,max(centUpper.z,center.z),centUpper.z);
+
+        /* transpose back into primrefs and store the valid ones compactly */
+        const vfloat4 primID = asFloat(vint4(int(j))+vint4(step));
+        vfloat4 l[4], u[4];
+        transpose(lower.x,lower.y,lower.z,geomID,l[0],l[1],l[2],l[3]);
+        transpose(upper.x,upper.y,upper.z,primID,u[0],u[1],u[2],u[3]);
+        size_t m = movemask(valid);
+        do {
+          const size_t i = __bscf(m);
+          vfloat4::store((float*)&prims[k].lower,l[i]);
+          vfloat4::store((float*)&prims[k].upper,u[i]);
+          k++;
+        } while (m);
+      }
+
+      const BBox3fa geomBounds(Vec3fa(reduce_min(geomLower.x),reduce_min(geomLower.y),reduce_min(geomLower.z)),
+                               Vec3fa(reduce_max(geomUpper.x),reduce_max(geomUpper.y),reduce_max(geomUpper.z)));
+      const BBox3fa centBounds(Vec3fa(reduce_min(centLower.x),reduce_min(centLower.y),reduce_min(centLower.z)),
+                               Vec3fa(reduce_max(centUpper.x),reduce_max(centUpper.y),reduce_max(centUpper.z)));
+      return PrimInfo(k-k0,geomBounds,centBounds);
+    }
+
+    /* triangles, quads, and line segments without motion blur compute their bounds 4 at a time */
+    __forceinline PrimInfo createPrimRefs(TriangleMesh* mesh, const range<size_t>& r, size_t k, mvector<PrimRef>& prims) {
+      return mesh->numTimeSteps == 1 ? createPrimRefs4(mesh,r,k,prims) : createPrimRefs<TriangleMesh>(mesh,r,k,prims);
+    }
+
+    __forceinline PrimInfo createPrimRefs(QuadMesh* mesh, const range<size_t>& r, size_t k, mvector<PrimRef>& prims) {
+      return mesh->numTimeSteps == 1 ? createPrimRefs4(mesh,r,k,prims) : createPrimRefs<QuadMesh>(mesh,r,k,prims);
+    }
+
+    __forceinline PrimInfo createPrimRefs(LineSegments* mesh, const range<size_t>& r, size_t k, mvector<PrimRef>& prims) {
+      return mesh->numTimeSteps == 1 ? createPrimRefs4(mesh,r,k,prims) : createPrimRefs<LineSegments>(mesh,r,k,prims);
+    }
+
     template<typename Mesh>
     PrimInfo createPrimRefArray(Mesh* mesh, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor)
     {
@@ -31,18 +112,7 @@ namespace embree
       progressMonitor(0);
       PrimInfo pinfo = parallel_prefix_sum( pstate, size_t(0), mesh->size(), size_t(1024), PrimInfo(empty), [&](const range<size_t>& r, const PrimInfo& base) -> PrimInfo
       {
-        size_t k = r.begin();
-        PrimInfo pinfo(empty);
-        for (size_t j=r.begin(); j<r.end(); j++)
-        {
-          BBox3fa bounds = empty;
-          if (!mesh->buildBounds(j,&bounds)) continue;
-
-          const PrimRef prim(bounds,mesh->id,unsigned(j));          
-          pinfo.add(bounds,bounds.center2());
-          prims[k++] = prim;
-        }
-        return pinfo;
+        return createPrimRefs(mesh,r,r.begin(),prims);
       }, [](const PrimInfo& a, const PrimInfo& b) -> PrimInfo { return PrimInfo::merge(a,b); });
 
       /* if we need to filter out geometry, run again */
@@ -51,17 +121,7 @@ namespace embree
         progressMonitor(0);
         pinfo = parallel_prefix_sum( pstate, size_t(0), mesh->size(), size_t(1024), PrimInfo(empty), [&](const range<size_t>& r, const PrimInfo& base) -> PrimInfo
         {
-          size_t k = base.size();
-          PrimInfo pinfo(empty);
-          for (size_t j=r.begin(); j<r.end(); j++)
-          {
-            BBox3fa bounds = empty;
-            if (!mesh->buildBounds(j,&bounds)) continue;
-            const PrimRef prim(bounds,mesh->id,unsigned(j));
-            pinfo.add(bounds,bounds.center2());
-            prims[k++] = prim;
-          }
-          return pinfo;
+          return createPrimRefs(mesh,r,base.size(),prims);
         }, [](const PrimInfo& a, const PrimInfo& b) -> PrimInfo { return PrimInfo::merge(a,b); });
       }
       return pinfo;
@@ -78,16 +138,7 @@ namespace embree
       pstate.init(iter,size_t(1024));
       PrimInfo pinfo = parallel_for_for_prefix_sum( pstate, iter, PrimInfo(empty), [&](Mesh* mesh, const range<size_t>& r, size_t k, const PrimInfo& base) -> PrimInfo
       {
-        PrimInfo pinfo(empty);
-        for (size_t j=r.begin(); j<r.end(); j++)
-        {
-          BBox3fa bounds = empty;
-          if (!mesh->buildBounds(j,&bounds)) continue;
-          const PrimRef prim(bounds,mesh->id,unsigned(j));
-          pinfo.add(bounds,bounds.center2());
-          prims[k++] = prim;
-        }
-        return pinfo;
+        return createPrimRefs(mesh,r,k,prims);
       }, [](const PrimInfo& a, const PrimInfo& b) -> PrimInfo { return PrimInfo::merge(a,b); });
       
       /* if we need to filter out geometry, run again */
@@ -96,17 +147,7 @@ namespace embree
         progressMonitor(0);
         pinfo = parallel_for_for_prefix_sum( pstate, iter, PrimInfo(empty), [&](Mesh* mesh, const range<size_t>& r, size_t k, const PrimInfo& base) -> PrimInfo
         {
-          k = base.size();
-          PrimInfo pinfo(empty);
-          for (size_t j=r.begin(); j<r.end(); j++)
-          {
-            BBox3fa bounds = empty;
-            if (!mesh->buildBounds(j,&bounds)) continue;
-            const PrimRef prim(bounds,mesh->id,unsigned(j));
-            pinfo.add(bounds,bounds.center2());
-            prims[k++] = prim;
-          }
-          return pinfo;
+          return createPrimRefs(mesh,r,base.size(),prims);
         }, [](const PrimInfo& a, const PrimInfo& b) -> PrimInfo { return PrimInfo::merge(a,b); });
       }
       return pinfo;
@@ -265,10 +306,53 @@ namespace embree
       return pinfo;
     }
 
+    size_t createTrianglePairs(Scene* scene)
+    {
+      Scene::Iterator<TriangleMesh,false> iter(scene);
+      size_t numPairs = 0;
+      for (size_t i=0; i<iter.size(); i++)
+      {
+        TriangleMesh* mesh = iter[i];
+        if (mesh == nullptr) continue;
+        if (mesh->isModified() || mesh->numTrianglePairs() == 0)
+          mesh->buildTrianglePairs();
+        numPairs += mesh->numTrianglePairs();
+      }
+      return numPairs;
+    }
+
+    PrimInfo createTrianglePairRefArray(Scene* scene, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor)
+    {
+      Scene::Iterator<TriangleMesh,false> iter(scene);
+      progressMonitor(0);
+
+      /* triangle pairs only contain valid triangles, thus no filtering is required */
+      PrimInfo pinfo(empty);
+      for (size_t i=0; i<iter.size(); i++)
+      {
+        TriangleMesh* mesh = iter[i];
+        if (mesh == nullptr) continue;
+        const size_t offset = pinfo.size();
+        pinfo.merge(parallel_reduce(size_t(0), mesh->numTrianglePairs(), size_t(1024), PrimInfo(empty), [&](const range<size_t>& r) -> PrimInfo
+        {
+          PrimInfo pinfo(empty);
+          for (size_t j=r.begin(); j<r.end(); j++)
+          {
+            const BBox3fa bounds = mesh->trianglePairBounds(j);
+            pinfo.add(bounds,bounds.center2());
+            prims[offset+j] = PrimRef(bounds,mesh->id,unsigned(j));
+          }
+          return pinfo;
+        }, [](const PrimInfo& a, const PrimInfo& b) -> PrimInfo { return PrimInfo::merge(a,b); }));
+      }
+      return pinfo;
+    }
+
     template PrimInfo createPrimRefArray<TriangleMesh>(TriangleMesh* mesh, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor);
     template PrimInfo createPrimRefArray<QuadMesh>(QuadMesh* mesh, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor);
     template PrimInfo createPrimRefArray<BezierCurves>(BezierCurves* mesh, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor);
     template PrimInfo createPrimRefArray<LineSegments>(LineSegments* mesh, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor);
+    template PrimInfo createPrimRefArray<Points>(Points* mesh, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor);
     template PrimInfo createPrimRefArray<AccelSet>(AccelSet* mesh, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor);
 
     template PrimInfo createPrimRefArray<TriangleMesh,false>(Scene* scene, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor);
@@ -278,6 +362,7 @@ namespace embree
     template PrimInfo createPrimRefArray<BezierCurves,false>(Scene* scene, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor);
     template PrimInfo createPrimRefArray<LineSegments,false>(Scene* scene, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor);
     template PrimInfo createPrimRefArray<LineSegments,true>(Scene* scene, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor);
+    template PrimInfo createPrimRefArray<Points,false>(Scene* scene, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor);
     //template PrimInfo createPrimRefArray<SubdivMesh,false>(Scene* scene, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor);
     template PrimInfo createPrimRefArray<AccelSet,false>(Scene* scene, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor);
     template PrimInfo createPrimRefArray<AccelSet,true>(Scene* scene, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor);
@@ -23,7 +23,7 @@ namespace embree
   BVHN<N>::BVHN (const PrimitiveType& primTy, Scene* scene)
     : AccelData((N==4) ? AccelData::TY_BVH4 : (N==8) ? AccelData::TY_BVH8 : AccelData::TY_UNKNOWN),
       primTy(primTy), device(scene->device), scene(scene),
-      root(emptyNode), msmblur(false), numTimeSteps(1), alloc(scene->device), numPrimitives(0), numVertices(0) {}
+      root(emptyNode), generation(0), msmblur(false), numTimeSteps(1), numTimeSplits(1), alloc(scene->device), numPrimitives(0), numVertices(0) {}
 
   template<int N>
   BVHN<N>::~BVHN ()
@@ -43,6 +43,7 @@ namespace embree
   void BVHN<N>::set (NodeRef root, const LBBox3fa& bounds, size_t numPrimitives)
   {
     this->root = root;
+    this->generation = OccluderCache::nextGeneration();
     this->bounds = bounds;
     this->numPrimitives = numPrimitives;
   }
@@ -171,6 +172,9 @@ namespace embree
   template class BVHN<8>;
 #else
   template class BVHN<4>;
+
+  std::atomic<size_t> OccluderCache::generationCounter(0);
+  __thread OccluderCache::Entry OccluderCache::entries[OccluderCache::SIZE];
 #endif
 }
 
@@ -23,6 +23,7 @@
 #include "../common/scene.h"
 #include "../geometry/primitive.h"
 #include "../common/ray.h"
+#include "bvh_occluder_cache.h"
 
 namespace embree
 {
@@ -35,18 +36,20 @@ namespace embree
     BVH_FLAG_UNALIGNED_NODE_MB = 0x01000,
     BVH_FLAG_TRANSFORM_NODE = 0x10000,
     BVH_FLAG_QUANTIZED_NODE = 0x100000,
+    BVH_FLAG_QUANTIZED_NODE_MB = 0x1000000,
 
     /* short versions */
     BVH_AN1 = BVH_FLAG_ALIGNED_NODE,
     BVH_AN2 = BVH_FLAG_ALIGNED_NODE_MB,
     BVH_UN1 = BVH_FLAG_UNALIGNED_NODE,
     BVH_UN2 = BVH_FLAG_UNALIGNED_NODE_MB,
-    BVH_MB = BVH_FLAG_ALIGNED_NODE_MB | BVH_FLAG_UNALIGNED_NODE_MB,
+    BVH_MB = BVH_FLAG_ALIGNED_NODE_MB | BVH_FLAG_UNALIGNED_NODE_MB | BVH_FLAG_QUANTIZED_NODE_MB,
     BVH_AN1_UN1 = BVH_FLAG_ALIGNED_NODE | BVH_FLAG_UNALIGNED_NODE,
     BVH_AN2_UN2 = BVH_FLAG_ALIGNED_NODE_MB | BVH_FLAG_UNALIGNED_NODE_MB,
     BVH_TN_AN1 = BVH_FLAG_TRANSFORM_NODE | BVH_FLAG_ALIGNED_NODE,
     BVH_TN_AN1_AN2 = BVH_FLAG_TRANSFORM_NODE | BVH_FLAG_ALIGNED_NODE | BVH_FLAG_ALIGNED_NODE_MB,
-    BVH_QN1 = BVH_FLAG_QUANTIZED_NODE
+    BVH_QN1 = BVH_FLAG_QUANTIZED_NODE,
+    BVH_QN2 = BVH_FLAG_QUANTIZED_NODE_MB
   };
 
   /*! Multi BVH with N children. Each node stores the bounding box of
@@ -65,6 +68,7 @@ namespace embree
     struct UnalignedNodeMB;
     struct TransformNode;
     struct QuantizedNode;
+    struct QuantizedNodeMB;
 
     /*! Number of bytes the nodes and primitives are minimally aligned to.*/
     static const size_t byteAlignment = 16;
@@ -84,6 +88,7 @@ namespace embree
     static const size_t tyUnalignedNodeMB = 3;
     static const size_t tyTransformNode = 4;
     static const size_t tyQuantizedNode = 5;
+    static const size_t tyQuantizedNodeMB = 6;
     static const size_t tyLeaf = 8;
 
     /*! Empty node */
@@ -343,6 +348,9 @@ namespace embree
       /*! checks if this is a quantized node */
       __forceinline int isQuantizedNode() const { return (ptr & (size_t)align_mask) == tyQuantizedNode; }
 
+      /*! checks if this is a quantized motion blur node */
+      __forceinline int isQuantizedNodeMB() const { return (ptr & (size_t)align_mask) == tyQuantizedNodeMB; }
+
       /*! returns base node pointer */
       __forceinline BaseNode* baseNode(int types)
       {
@@ -389,6 +397,10 @@ namespace embree
       __forceinline       QuantizedNode* quantizedNode()       { assert(isQuantizedNode()); return (      QuantizedNode*)(ptr & ~(size_t)align_mask); }
       __forceinline const QuantizedNode* quantizedNode() const { assert(isQuantizedNode()); return (const QuantizedNode*)(ptr & ~(size_t)align_mask); }
 
+      /*! returns quantized motion blur node pointer */
+      __forceinline       QuantizedNodeMB* quantizedNodeMB()       { assert(isQuantizedNodeMB()); return (      QuantizedNodeMB*)(ptr & ~(size_t)align_mask); }
+      __forceinline const QuantizedNodeMB* quantizedNodeMB() const { assert(isQuantizedNodeMB()); return (const QuantizedNodeMB*)(ptr & ~(size_t)align_mask); }
+
       /*! returns leaf pointer */
       __forceinline char* leaf(size_t& num) const {
         assert(isLeaf());
@@ -572,8 +584,10 @@ namespace embree
         lower_x[i] = bounds0.lower.x; lower_y[i] = bounds0.lower.y; lower_z[i] = bounds0.lower.z;
         upper_x[i] = bounds0.upper.x; upper_y[i] = bounds0.upper.y; upper_z[i] = bounds0.upper.z;
 
-        /*! for empty bounds we have to avoid inf-inf=nan */
-        if (unlikely(bounds0.empty())) {
+        /*! for empty bounds we have to avoid inf-inf=nan, bounds
+         *  extrapolated from a temporal split may be inverted at
+         *  one end only */
+        if (unlikely(bounds0.empty() && bounds1.empty())) {
           lower_dx[i] = lower_dy[i] = lower_dz[i] = zero;
           upper_dx[i] = upper_dy[i] = upper_dz[i] = zero;
         }
@@ -938,6 +952,161 @@ namespace embree
       Vec3f scale;
     };
 
+    /*! BVHN Quantized Motion Blur Node. Stores the child bounds at
+     *  time 0 and time 1 with 8 bits per plane, both relative to a
+     *  common grid. The bounds at some time are obtained by linear
+     *  interpolation of the decoded bounds of the two time steps. */
+    struct __aligned(16) QuantizedNodeMB : public BaseNode
+    {
+      using BaseNode::children;
+
+      static const unsigned char MIN_QUAN_8BIT = 0;
+      static const unsigned char MAX_QUAN_8BIT = 255;
+
+      /*! Clears the node. */
+      __forceinline void clear() {
+        for (size_t i=0; i<N; i++) lower0_x[i] = lower0_y[i] = lower0_z[i] = lower1_x[i] = lower1_y[i] = lower1_z[i] = MAX_QUAN_8BIT;
+        for (size_t i=0; i<N; i++) upper0_x[i] = upper0_y[i] = upper0_z[i] = upper1_x[i] = upper1_y[i] = upper1_z[i] = MIN_QUAN_8BIT;
+        BaseNode::clear();
+      }
+
+      /*! Return bounding box for time 0 */
+      __forceinline BBox3fa bounds0(size_t i) const
+      {
+        assert(i < N);
+        const Vec3fa lower(start.x + scale.x * (float)lower0_x[i],
+                           start.y + scale.y * (float)lower0_y[i],
+                           start.z + scale.z * (float)lower0_z[i]);
+        const Vec3fa upper(start.x + scale.x * (float)upper0_x[i],
+                           start.y + scale.y * (float)upper0_y[i],
+                           start.z + scale.z * (float)upper0_z[i]);
+        return BBox3fa(lower,upper);
+      }
+
+      /*! Return bounding box for time 1 */
+      __forceinline BBox3fa bounds1(size_t i) const
+      {
+        assert(i < N);
+        const Vec3fa lower(start.x + scale.x * (float)lower1_x[i],
+                           start.y + scale.y * (float)lower1_y[i],
+                           start.z + scale.z * (float)lower1_z[i]);
+        const Vec3fa upper(start.x + scale.x * (float)upper1_x[i],
+                           start.y + scale.y * (float)upper1_y[i],
+                           start.z + scale.z * (float)upper1_z[i]);
+        return BBox3fa(lower,upper);
+      }
+
+      /*! Return bounding box of child i */
+      __forceinline BBox3fa bounds(size_t i) const {
+        return merge(bounds0(i),bounds1(i));
+      }
+
+      /*! Returns extent of bounds of specified child. */
+      __forceinline Vec3fa extend0(size_t i) const {
+        return bounds0(i).size();
+      }
+
+      /*! quantizes lower planes conservatively by rounding down */
+      static __forceinline vint<N> quantizeLower(const vfloat<N>& lower, const vbool<N>& m_valid, const float minF, const float scale, const float inv_scale)
+      {
+        vint<N> i_lower(floor((lower - vfloat<N>(minF)) * vfloat<N>(inv_scale)));
+        const vbool<N> m_correction = ((minF + vfloat<N>(i_lower) * scale) > lower) & m_valid;
+        i_lower = select(m_correction,i_lower-1,i_lower);
+        return select(m_valid,i_lower,255);
+      }
+
+      /*! quantizes upper planes conservatively by rounding up */
+      static __forceinline vint<N> quantizeUpper(const vfloat<N>& upper, const vbool<N>& m_valid, const float minF, const float scale, const float inv_scale)
+      {
+        vint<N> i_upper(ceil((upper - vfloat<N>(minF)) * vfloat<N>(inv_scale)));
+        const vbool<N> m_correction = ((minF + vfloat<N>(i_upper) * scale) < upper) & m_valid;
+        i_upper = select(m_correction,i_upper+1,i_upper);
+        return select(m_valid,i_upper,0);
+      }
+
+      /*! quantizes one dimension of the bounds at time 0 and time 1
+       *  into a grid that covers the planes of both time steps,
+       *  bounds extrapolated from temporal splits may be inverted
+       *  at one end thus all planes contribute to the grid range */
+      static __forceinline void init_dim(const vfloat<N>& lower0, const vfloat<N>& upper0,
+                                         const vfloat<N>& lower1, const vfloat<N>& upper1,
+                                         unsigned char lower0_quant[N], unsigned char upper0_quant[N],
+                                         unsigned char lower1_quant[N], unsigned char upper1_quant[N],
+                                         float& start, float& scale)
+      {
+        const vbool<N> m_valid = lower0 != vfloat<N>(pos_inf);
+        const float minF = reduce_min(select(m_valid,min(min(lower0,upper0),min(lower1,upper1)),vfloat<N>(pos_inf)));
+        const float maxF = reduce_max(select(m_valid,max(max(lower0,upper0),max(lower1,upper1)),vfloat<N>(neg_inf)));
+        float diff = maxF - minF;
+        float scale_diff = diff / 255.0f;
+
+        /* accomodate floating point accuracy issues in 'diff' */
+        while(minF + scale_diff * 255.0f < maxF)
+        {
+          diff = nextafter(diff, FLT_MAX);
+          scale_diff = diff / 255.0f;
+        }
+        const float inv_diff = diff > 0.0f ? 255.0f / diff : 0.0f;
+
+        vint<N>::store_uchar(lower0_quant,quantizeLower(lower0,m_valid,minF,scale_diff,inv_diff));
+        vint<N>::store_uchar(upper0_quant,quantizeUpper(upper0,m_valid,minF,scale_diff,inv_diff));
+        vint<N>::store_uchar(lower1_quant,quantizeLower(lower1,m_valid,minF,scale_diff,inv_diff));
+        vint<N>::store_uchar(upper1_quant,quantizeUpper(upper1,m_valid,minF,scale_diff,inv_diff));
+        start = minF;
+        scale = scale_diff;
+      }
+
+      /*! initializes the node from the bounds of the children at time 0 and time 1 */
+      __forceinline void init(const AlignedNode& node0, const AlignedNode& node1)
+      {
+        init_dim(node0.lower_x,node0.upper_x,node1.lower_x,node1.upper_x,lower0_x,upper0_x,lower1_x,upper1_x,start.x,scale.x);
+        init_dim(node0.lower_y,node0.upper_y,node1.lower_y,node1.upper_y,lower0_y,upper0_y,lower1_y,upper1_y,start.y,scale.y);
+        init_dim(node0.lower_z,node0.upper_z,node1.lower_z,node1.upper_z,lower0_z,upper0_z,lower1_z,upper1_z,start.z,scale.z);
+      }
+
+      /*! returns the planes at offset interpolated to the given time, in grid units */
+      template <int M>
+      __forceinline vfloat<M> dequantize(const size_t offset, const float time) const
+      {
+        const vfloat<M> p0(vint<M>::loadu(all_planes+offset));
+        const vfloat<M> p1(vint<M>::loadu(all_planes+6*N+offset));
+        return madd(time,p1-p0,p0);
+      }
+
+      /*! returns the bounds of child i interpolated to the given times */
+      template<int K>
+      __forceinline void bounds(const size_t i, const vfloat<K>& time, Vec3<vfloat<K>>& lower, Vec3<vfloat<K>>& upper) const
+      {
+        lower.x = madd(madd(time,vfloat<K>(float(lower1_x[i])-float(lower0_x[i])),vfloat<K>(float(lower0_x[i]))),vfloat<K>(scale.x),vfloat<K>(start.x));
+        lower.y = madd(madd(time,vfloat<K>(float(lower1_y[i])-float(lower0_y[i])),vfloat<K>(float(lower0_y[i]))),vfloat<K>(scale.y),vfloat<K>(start.y));
+        lower.z = madd(madd(time,vfloat<K>(float(lower1_z[i])-float(lower0_z[i])),vfloat<K>(float(lower0_z[i]))),vfloat<K>(scale.z),vfloat<K>(start.z));
+        upper.x = madd(madd(time,vfloat<K>(float(upper1_x[i])-float(upper0_x[i])),vfloat<K>(float(upper0_x[i]))),vfloat<K>(scale.x),vfloat<K>(start.x));
+        upper.y = madd(madd(time,vfloat<K>(float(upper1_y[i])-float(upper0_y[i])),vfloat<K>(float(upper0_y[i]))),vfloat<K>(scale.y),vfloat<K>(start.y));
+        upper.z = madd(madd(time,vfloat<K>(float(upper1_z[i])-float(upper0_z[i])),vfloat<K>(float(upper0_z[i]))),vfloat<K>(scale.z),vfloat<K>(start.z));
+      }
+
+      union {
+        struct {
+          unsigned char lower0_x[N]; //!< 8bit discretized X dimension of lower bounds of all N children at time 0
+          unsigned char upper0_x[N]; //!< 8bit discretized X dimension of upper bounds of all N children at time 0
+          unsigned char lower0_y[N]; //!< 8bit discretized Y dimension of lower bounds of all N children at time 0
+          unsigned char upper0_y[N]; //!< 8bit discretized Y dimension of upper bounds of all N children at time 0
+          unsigned char lower0_z[N]; //!< 8bit discretized Z dimension of lower bounds of all N children at time 0
+          unsigned char upper0_z[N]; //!< 8bit discretized Z dimension of upper bounds of all N children at time 0
+          unsigned char lower1_x[N]; //!< 8bit discretized X dimension of lower bounds of all N children at time 1
+          unsigned char upper1_x[N]; //!< 8bit discretized X dimension of upper bounds of all N children at time 1
+          unsigned char lower1_y[N]; //!< 8bit discretized Y dimension of lower bounds of all N children at time 1
+          unsigned char upper1_y[N]; //!< 8bit discretized Y dimension of upper bounds of all N children at time 1
+          unsigned char lower1_z[N]; //!< 8bit discretized Z dimension of lower bounds of all N children at time 1
+          unsigned char upper1_z[N]; //!< 8bit discretized Z dimension of upper bounds of all N children at time 1
+        };
+        unsigned char all_planes[12*N];
+      };
+
+      Vec3f start;
+      Vec3f scale;
+    };
+
 
     /*! swap the children of two nodes */
     __forceinline static void swap(AlignedNode* a, size_t i, AlignedNode* b, size_t j)
@@ -1054,7 +1223,7 @@ namespace embree
 
     __forceinline NodeRef getRoot(const RayPrecalculationsMB& pre) const {
       NodeRef* roots = (NodeRef*)(size_t)root;
-      return roots[pre.itime()];
+      return roots[pre.itime()*numTimeSplits + getTimeSplit(pre.ftime())];
     }
 
     template<int K>
@@ -1065,7 +1234,24 @@ namespace embree
     template<int K>
     __forceinline NodeRef getRoot(const RayKPrecalculationsMB<K>& pre, size_t k) const {
       NodeRef* roots = (NodeRef*)(size_t)root;
-      return roots[pre.itime(k)];
+      return roots[pre.itime(k)*numTimeSplits + getTimeSplit(pre.ftime(k))];
+    }
+
+    /*! returns the index into the MSMBlur root array for each ray */
+    template<int K>
+    __forceinline vint<K> getRootIndex(const RayKPrecalculations<K>& pre) const {
+      return zero;
+    }
+
+    template<int K>
+    __forceinline vint<K> getRootIndex(const RayKPrecalculationsMB<K>& pre) const {
+      const vint<K> isplit = min(vint<K>(pre.ftime()*float(numTimeSplits)),vint<K>(numTimeSplits-1));
+      return pre.itime()*int(numTimeSplits) + isplit;
+    }
+
+    /*! returns the temporal split containing the time inside the time segment */
+    __forceinline unsigned getTimeSplit(const float ftime) const {
+      return min(unsigned(ftime*float(numTimeSplits)),numTimeSplits-1);
     }
 
   public:
@@ -1096,6 +1282,12 @@ namespace embree
       return NodeRef((size_t) node | tyAlignedNodeMB);
     }
 
+    /*! Encodes a quantized motion blur node */
+    static __forceinline NodeRef encodeNode(QuantizedNodeMB* node) {
+      assert(!((size_t)node & align_mask));
+      return NodeRef((size_t) node | tyQuantizedNodeMB);
+    }
+
     /*! Encodes an unaligned node */
     static __forceinline NodeRef encodeNode(UnalignedNode* node) {
       return NodeRef((size_t) node | tyUnalignedNode);
@@ -1133,8 +1325,10 @@ namespace embree
     Device* device;                    //!< device pointer
     Scene* scene;                      //!< scene pointer
     NodeRef root;                      //!< root node
+    size_t generation;                 //!< unique id of the current root, changes with each build
     bool msmblur;                      //!< when true root points to array of roots for MSMBlur mode
     unsigned numTimeSteps;             //!< number of time steps
+    unsigned numTimeSplits;            //!< number of temporal splits of each time segment in MSMBlur mode
     FastAllocator alloc;               //!< allocator used to allocate nodes
 
     /*! statistics data */
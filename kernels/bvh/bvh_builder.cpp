@@ -88,6 +88,134 @@ namespace embree
     }
 
 
+    /*! subtree below the upper levels build by the compact builder */
+    struct CompactSubtree
+    {
+      __forceinline CompactSubtree () {}
+
+      __forceinline CompactSubtree (const range<size_t>& prims, size_t depth, size_t* parent)
+        : prims(prims), depth(depth), parent(parent), bounds(empty) {}
+
+      __forceinline friend bool operator< (const CompactSubtree& a, const CompactSubtree& b) { 
+        return a.parent < b.parent; 
+      }
+
+    public:
+      range<size_t> prims;   //!< range of primitives of the subtree
+      size_t depth;          //!< depth of the root of the subtree
+      size_t* parent;        //!< reference to the subtree in the parent node
+      BBox3fa bounds;        //!< exact bounds of the subtree
+    };
+
+    /*! sets the exact bounds of the nodes of the upper levels, as they were created with quantized bounds */
+    template<int N>
+    BBox3fa refitCompactLevels(size_t* ref, const avector<CompactSubtree>& subtrees)
+    {
+      /* bounds of subtrees are already known */
+      auto subtree = std::lower_bound(subtrees.begin(),subtrees.end(),ref,[] (const CompactSubtree& a, size_t* b) { return a.parent < b; });
+      if (subtree != subtrees.end() && subtree->parent == ref)
+        return subtree->bounds;
+
+      /* recurse into all children of upper level nodes */
+      typename BVHN<N>::AlignedNode* node = ((typename BVHN<N>::NodeRef*)ref)->alignedNode();
+      BBox3fa bounds = empty;
+      for (size_t i=0; i<N; i++) 
+      {
+        if (node->child(i) == BVHN<N>::emptyNode) continue;
+        const BBox3fa cbounds = refitCompactLevels<N>((size_t*)&node->child(i),subtrees);
+        node->set(i,cbounds);
+        bounds.extend(cbounds);
+      }
+      return bounds;
+    }
+
+    template<int N>
+    void BVHNBuilderCompact<N>::BVHNBuilderV::build(BVH* bvh, BuildProgressMonitor& progress_in, PrimRef* prims, const PrimInfo& pinfo, const size_t blockSize, const size_t minLeafSize, const size_t maxLeafSize, const float travCost, const float intCost)
+    {
+      auto progressFunc = [&] (size_t dn) { 
+        progress_in(dn); 
+      };
+            
+      auto createLeafFunc = [&] (const BVHBuilderBinnedSAH::BuildRecord& current, Allocator* alloc) -> size_t {
+        return createLeaf(current,alloc);
+      };
+
+      const size_t numPrims = pinfo.size();
+      const size_t subtreeSize = max(MIN_SUBTREE_SIZE,numPrims/NUM_SUBTREES);
+
+      /* quantize primrefs in place, compact primref i overwrites half of primref i/2 which got already processed */
+      const PrimRefCompact::Grid grid(pinfo.geomBounds);
+      PrimRefCompact* cprims = (PrimRefCompact*) prims;
+      cprims[0] = PrimRefCompact(prims[0],grid);
+      for (size_t k=1; k<numPrims; k*=2) 
+      {
+        parallel_for(k, min(2*k,numPrims), size_t(4096), [&] (const range<size_t>& r) {
+            for (size_t i=r.begin(); i<r.end(); i++)
+              cprims[i] = PrimRefCompact(prims[i],grid);
+          });
+      }
+
+      /* calculate bounding info in grid space */
+      const CentGeomBBox3fa cbounds = parallel_reduce(size_t(0), numPrims, size_t(4096), CentGeomBBox3fa(empty), [&] (const range<size_t>& r) -> CentGeomBBox3fa
+      {
+        CentGeomBBox3fa bounds(empty);
+        for (size_t i=r.begin(); i<r.end(); i++)
+          bounds.extend_primref(cprims[i]);
+        return bounds;
+      }, [] (const CentGeomBBox3fa& a, const CentGeomBBox3fa& b) -> CentGeomBBox3fa { CentGeomBBox3fa c = a; c.merge(b); return c; });
+      const PrimInfo cinfo(0,numPrims,cbounds.geomBounds,cbounds.centBounds);
+
+      /* build upper levels using compact primrefs */
+      MutexSys mutex;
+      avector<CompactSubtree> subtrees;
+      auto createSubtreeFunc = [&] (const BVHBuilderBinnedSAHCompact::BuildRecord& current, Allocator* alloc) -> size_t {
+        Lock<MutexSys> lock(mutex);
+        subtrees.push_back(CompactSubtree(current.prims,current.depth,current.parent));
+        return 0;
+      };
+
+      NodeRef root;
+      BVHBuilderBinnedSAHCompact::build_reduce<NodeRef>
+        (root,typename BVH::CreateAlloc(bvh),size_t(0),typename BVH::CreateAlignedNode(bvh),dummy<N>,createSubtreeFunc,
+         cprims,cinfo,N,BVH::maxBuildDepthLeaf,blockSize,subtreeSize,travCost,intCost);
+
+      /* restore full precision primrefs in place from back to front, primref i overwrites compact primrefs 2*i and 2*i+1 */
+      auto restore = [&] (size_t i) {
+        const PrimRefCompact prim = cprims[i];
+        prims[i] = PrimRef(primBounds(prim.geomID(),prim.primID()),prim.geomID(),prim.primID());
+      };
+      for (size_t k=numPrims; k>1; k=(k+1)/2) 
+      {
+        parallel_for((k+1)/2, k, size_t(4096), [&] (const range<size_t>& r) {
+            for (size_t i=r.begin(); i<r.end(); i++) restore(i);
+          });
+      }
+      restore(0);
+
+      /* build subtrees using full precision primrefs */
+      parallel_for(subtrees.size(), [&] (const size_t i) 
+      {
+        CompactSubtree& subtree = subtrees[i];
+        CentGeomBBox3fa bounds(empty);
+        for (size_t j=subtree.prims.begin(); j<subtree.prims.end(); j++)
+          bounds.extend(prims[j].bounds());
+        subtree.bounds = bounds.geomBounds;
+
+        const PrimInfo sinfo(subtree.prims.begin(),subtree.prims.end(),bounds.geomBounds,bounds.centBounds);
+        BVHBuilderBinnedSAH::BuildRecord br(sinfo,subtree.depth,subtree.parent,subtree.prims);
+        BVHBuilderBinnedSAH::build_record
+          (br,typename BVH::CreateAlloc(bvh),size_t(0),typename BVH::CreateAlignedNode(bvh),rotate<N>,createLeafFunc,progressFunc,
+           prims,N,BVH::maxBuildDepthLeaf,blockSize,minLeafSize,maxLeafSize,travCost,intCost);
+      });
+
+      /* upper levels still use bounds in grid space */
+      std::sort(subtrees.begin(),subtrees.end());
+      refitCompactLevels<N>((size_t*)&root,subtrees);
+
+      bvh->set(root,LBBox3fa(pinfo.geomBounds),pinfo.size());
+      bvh->layoutLargeNodes(size_t(pinfo.size()*0.005f));
+    }
+
     template<int N>
     void BVHNBuilderQuantized<N>::BVHNBuilderV::build(BVH* bvh, BuildProgressMonitor& progress_in, PrimRef* prims, const PrimInfo& pinfo, const size_t blockSize, const size_t minLeafSize, const size_t maxLeafSize, const float travCost, const float intCost)
     {
@@ -134,7 +262,43 @@ namespace embree
     };
 
     template<int N>
-    std::tuple<typename BVHN<N>::NodeRef,LBBox3fa> BVHNBuilderMblur<N>::BVHNBuilderV::build(BVH* bvh, BuildProgressMonitor& progress_in, PrimRef* prims, const PrimInfo& pinfo, const size_t blockSize, const size_t minLeafSize, const size_t maxLeafSize, const float travCost, const float intCost)
+      struct CreateQuantizedNodeMB
+    {
+      typedef BVHN<N> BVH;
+      typedef typename BVH::QuantizedNodeMB QuantizedNodeMB;
+
+      __forceinline CreateQuantizedNodeMB (BVH* bvh) : bvh(bvh) {}
+      
+      __forceinline QuantizedNodeMB* operator() (const isa::BVHBuilderBinnedSAH::BuildRecord& current, BVHBuilderBinnedSAH::BuildRecord* children, const size_t num, FastAllocator::ThreadLocal2* alloc)
+      {
+        QuantizedNodeMB* node = (QuantizedNodeMB*) alloc->alloc0->malloc(sizeof(QuantizedNodeMB),BVH::byteNodeAlignment); node->clear();
+        for (size_t i=0; i<num; i++) {
+          children[i].parent = (size_t*)&node->child(i);
+        }
+        *current.parent = bvh->encodeNode(node);
+	return node;
+      }
+
+      BVH* bvh;
+    };
+
+    /*! extrapolates bounds over the time range dt to the full time
+     *  segment, enlarged to stay conservative inside dt */
+    static __forceinline LBBox3fa globalBoundsMB(const LBBox3fa& bounds, const BBox1f& dt)
+    {
+      if (dt.lower == 0.0f && dt.upper == 1.0f)
+        return bounds;
+
+      const LBBox3fa gbounds = bounds.global(dt);
+      const Vec3fa mag = max(max(abs(gbounds.bounds0.lower),abs(gbounds.bounds0.upper)),
+                             max(abs(gbounds.bounds1.lower),abs(gbounds.bounds1.upper)));
+      const Vec3fa eps = 8.0f*float(ulp)*mag;
+      return LBBox3fa(BBox3fa(gbounds.bounds0.lower-eps,gbounds.bounds0.upper+eps),
+                      BBox3fa(gbounds.bounds1.lower-eps,gbounds.bounds1.upper+eps));
+    }
+
+    template<int N>
+    std::tuple<typename BVHN<N>::NodeRef,LBBox3fa> BVHNBuilderMblur<N>::BVHNBuilderV::build(BVH* bvh, BuildProgressMonitor& progress_in, PrimRef* prims, const PrimInfo& pinfo, const size_t blockSize, const size_t minLeafSize, const size_t maxLeafSize, const float travCost, const float intCost, const BBox1f& dt, const bool quantized)
     {
       auto progressFunc = [&] (size_t dn) { 
         progress_in(dn); 
@@ -145,20 +309,40 @@ namespace embree
       };
 
       /* reduction function */
-      auto reduce = [] (AlignedNodeMB* node, const LBBox3fa* bounds, const size_t num) -> LBBox3fa
+      auto reduce = [&] (AlignedNodeMB* node, const LBBox3fa* bounds, const size_t num) -> LBBox3fa
+      {
+        assert(num <= N);
+        LBBox3fa allBounds = empty;
+        for (size_t i=0; i<num; i++) {
+          node->set(i, globalBoundsMB(bounds[i],dt));
+          allBounds.extend(bounds[i]);
+        }
+        return allBounds;
+      };
+      /* reduction function for quantized nodes, the bounds of both time steps get quantized at once */
+      auto reduceQuantized = [&] (QuantizedNodeMB* node, const LBBox3fa* bounds, const size_t num) -> LBBox3fa
       {
         assert(num <= N);
+        AlignedNode node0; node0.clear();
+        AlignedNode node1; node1.clear();
         LBBox3fa allBounds = empty;
         for (size_t i=0; i<num; i++) {
-          node->set(i, bounds[i]);
+          const LBBox3fa gbounds = globalBoundsMB(bounds[i],dt);
+          node0.set(i, gbounds.bounds0);
+          node1.set(i, gbounds.bounds1);
           allBounds.extend(bounds[i]);
         }
+        node->init(node0,node1);
         return allBounds;
       };
       auto identity = LBBox3fa(empty);
       
       NodeRef root;
-      LBBox3fa root_bounds = BVHBuilderBinnedSAH::build_reduce<NodeRef>
+      LBBox3fa root_bounds = quantized ?
+        BVHBuilderBinnedSAH::build_reduce<NodeRef>
+        (root,typename BVH::CreateAlloc(bvh),identity,CreateQuantizedNodeMB<N>(bvh),reduceQuantized,createLeafFunc,progressFunc,
+         prims,pinfo,N,BVH::maxBuildDepthLeaf,blockSize,minLeafSize,maxLeafSize,travCost,intCost) :
+        BVHBuilderBinnedSAH::build_reduce<NodeRef>
         (root,typename BVH::CreateAlloc(bvh),identity,CreateAlignedNodeMB<N>(bvh),reduce,createLeafFunc,progressFunc,
          prims,pinfo,N,BVH::maxBuildDepthLeaf,blockSize,minLeafSize,maxLeafSize,travCost,intCost);
 
@@ -215,12 +399,14 @@ namespace embree
 
 
     template struct BVHNBuilder<4>;
+    template struct BVHNBuilderCompact<4>;
     template struct BVHNBuilderQuantized<4>;
     template struct BVHNBuilderMblur<4>;    
     template struct BVHNBuilderSweep<4>;
 
 #if defined(__AVX__)
     template struct BVHNBuilder<8>;
+    template struct BVHNBuilderCompact<8>;
     template struct BVHNBuilderQuantized<8>;
     template struct BVHNBuilderMblur<8>;
     template struct BVHNBuilderSweep<8>;
@@ -56,6 +56,54 @@ namespace embree
       };
 
 
+    template<int N>
+      struct BVHNBuilderCompact
+      {
+        static const size_t MIN_SUBTREE_SIZE = 4096;  //!< minimal number of primitives of subtrees build with full precision primrefs
+        static const size_t NUM_SUBTREES = 1024;      //!< approximate number of subtrees for large builds 
+
+        typedef BVHN<N> BVH;
+        typedef typename BVH::NodeRef NodeRef;
+        typedef FastAllocator::ThreadLocal2 Allocator;
+      
+        struct BVHNBuilderV {
+          void build(BVH* bvh, BuildProgressMonitor& progress, PrimRef* prims, const PrimInfo& pinfo, 
+                     const size_t blockSize, const size_t minLeafSize, const size_t maxLeafSize, const float travCost, const float intCost);
+          virtual size_t createLeaf (const BVHBuilderBinnedSAH::BuildRecord& current, Allocator* alloc) = 0;
+          virtual BBox3fa primBounds (unsigned geomID, unsigned primID) = 0;
+        };
+
+        template<typename CreateLeafFunc, typename PrimBoundsFunc>
+        struct BVHNBuilderT : public BVHNBuilderV
+        {
+          BVHNBuilderT (CreateLeafFunc createLeafFunc, PrimBoundsFunc primBoundsFunc)
+            : createLeafFunc(createLeafFunc), primBoundsFunc(primBoundsFunc) {}
+
+          size_t createLeaf (const BVHBuilderBinnedSAH::BuildRecord& current, Allocator* alloc) {
+            return createLeafFunc(current,alloc);
+          }
+
+          BBox3fa primBounds (unsigned geomID, unsigned primID) {
+            return primBoundsFunc(geomID,primID);
+          }
+
+        private:
+          CreateLeafFunc createLeafFunc;
+          PrimBoundsFunc primBoundsFunc;
+        };
+
+        /*! builds the upper levels of the hierarchy on compact primrefs
+         *  and the lower levels on full precision primrefs, the full
+         *  precision primrefs get restored through the primBounds
+         *  function that has to calculate the original bounds of a
+         *  primitive */
+        template<typename CreateLeafFunc, typename PrimBoundsFunc>
+        static void build(BVH* bvh, CreateLeafFunc createLeaf, PrimBoundsFunc primBounds, BuildProgressMonitor& progress, PrimRef* prims, const PrimInfo& pinfo, 
+                          const size_t blockSize, const size_t minLeafSize, const size_t maxLeafSize, const float travCost, const float intCost) {
+          BVHNBuilderT<CreateLeafFunc,PrimBoundsFunc>(createLeaf,primBounds).build(bvh,progress,prims,pinfo,blockSize,minLeafSize,maxLeafSize,travCost,intCost);
+        }
+      };
+
     template<int N>
       struct BVHNBuilderQuantized
       {
@@ -94,13 +142,15 @@ namespace embree
       struct BVHNBuilderMblur
       {
         typedef BVHN<N> BVH;
+        typedef typename BVH::AlignedNode AlignedNode;
         typedef typename BVH::AlignedNodeMB AlignedNodeMB;
+        typedef typename BVH::QuantizedNodeMB QuantizedNodeMB;
         typedef typename BVH::NodeRef NodeRef;
         typedef FastAllocator::ThreadLocal2 Allocator;
       
         struct BVHNBuilderV {
           std::tuple<NodeRef,LBBox3fa> build(BVH* bvh, BuildProgressMonitor& progress, PrimRef* prims, const PrimInfo& pinfo, 
-                     const size_t blockSize, const size_t minLeafSize, const size_t maxLeafSize, const float travCost, const float intCost);
+                     const size_t blockSize, const size_t minLeafSize, const size_t maxLeafSize, const float travCost, const float intCost, const BBox1f& dt, const bool quantized);
           virtual LBBox3fa createLeaf (const BVHBuilderBinnedSAH::BuildRecord& current, Allocator* alloc) = 0;
         };
 
@@ -118,10 +168,14 @@ namespace embree
           CreateLeafFunc createLeafFunc;
         };
 
+        /*! builds a BVH over the time range dt of the time segment, the
+         *  leaves return their bounds over dt and the nodes store
+         *  bounds extrapolated to the full time segment, quantized
+         *  motion blur nodes are created if requested */
         template<typename CreateLeafFunc>
         static std::tuple<NodeRef,LBBox3fa>  build(BVH* bvh, CreateLeafFunc createLeaf, BuildProgressMonitor& progress, PrimRef* prims, const PrimInfo& pinfo, 
-                          const size_t blockSize, const size_t minLeafSize, const size_t maxLeafSize, const float travCost, const float intCost) {
-          return BVHNBuilderT<CreateLeafFunc>(createLeaf).build(bvh,progress,prims,pinfo,blockSize,minLeafSize,maxLeafSize,travCost,intCost);
+                          const size_t blockSize, const size_t minLeafSize, const size_t maxLeafSize, const float travCost, const float intCost, const BBox1f& dt = BBox1f(0.0f,1.0f), const bool quantized = false) {
+          return BVHNBuilderT<CreateLeafFunc>(createLeaf).build(bvh,progress,prims,pinfo,blockSize,minLeafSize,maxLeafSize,travCost,intCost,dt,quantized);
         }
       };
 
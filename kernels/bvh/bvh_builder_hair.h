@@ -69,10 +69,11 @@ namespace embree
         prims(prims), 
         branchingFactor(branchingFactor), maxDepth(maxDepth), logBlockSize(logBlockSize), 
         minLeafSize(minLeafSize), maxLeafSize(maxLeafSize),
-        alignedHeuristic(prims), unalignedHeuristic(prims), strandHeuristic(prims) {}
+        alignedHeuristic(prims), unalignedHeuristic(prims,&orientationClusters), strandHeuristic(prims) {}
        
       /*! entry point into builder */
       NodeRef operator() (const PrimInfo& pinfo) {
+        unalignedHeuristic.computeOrientationClusters(pinfo,orientationClusters);
         NodeRef root = recurse(1,pinfo,nullptr,true);
         _mm_mfence(); // to allow non-temporal stores during build
         return root;
@@ -310,6 +311,7 @@ namespace embree
       const size_t maxLeafSize;
   
     private:
+      OrientationClusters orientationClusters;
       HeuristicBinningSAH alignedHeuristic;
       UnalignedHeuristicArrayBinningSAH<BezierPrim> unalignedHeuristic;
       HeuristicStrandSplit strandHeuristic;
@@ -22,6 +22,8 @@
 #include "../geometry/quadv.h"
 #include "../geometry/quadi.h"
 #include "../geometry/quadi_mb.h"
+#include "../geometry/bezier1v.h"
+#include "../geometry/object.h"
 
 namespace embree
 {
@@ -34,6 +36,9 @@ namespace embree
     Builder* BVH4Quad4vMeshBuilderSAH        (void* bvh, QuadMesh* mesh,     size_t mode = 0);
     //Builder* BVH4Quad4iMBMeshBuilderSAH     (void* bvh, QuadMesh* mesh,     size_t mode = 0);
 
+    Builder* BVH4VirtualMeshBuilderSAH      (void* bvh, AccelSet* mesh,     size_t mode = 0);
+    Builder* BVH4Bezier1vMeshBuilderSAH     (void* bvh, BezierCurves* mesh, size_t mode = 0);
+
     template<int N>
     BVHNBuilderInstancing<N>::BVHNBuilderInstancing (BVH* bvh, Scene* scene)
       : bvh(bvh), objects(bvh->objects), scene(scene), refs(scene->device), prims(scene->device), nextRef(0) {}
@@ -53,14 +58,16 @@ namespace embree
       return xfmID;
     }
 
+    /*! leaf type of the instanced BVH, selects the primitive intersector during traversal */
     int slot(int type, int numTimeSteps)
     {
       if (numTimeSteps == 1)
       {
         switch (type) {
         case Geometry::TRIANGLE_MESH: return 0;
-        case Geometry::USER_GEOMETRY: break;
-        case Geometry::BEZIER_CURVES: break;
+        case Geometry::QUAD_MESH    : return 2;
+        case Geometry::USER_GEOMETRY: return 3;
+        case Geometry::BEZIER_CURVES: return 4;
         case Geometry::SUBDIV_MESH  : break;
         }
       } else {
@@ -107,9 +114,8 @@ namespace embree
       
       /* skip build for empty scene */
       size_t numPrimitives = 0;
-      //numPrimitives += scene->getNumPrimitives<TriangleMesh,false>();
-      numPrimitives += scene->instanced.numTriangles;
-      numPrimitives += scene->instancedMB.numTriangles;
+      numPrimitives += scene->instanced.size();
+      numPrimitives += scene->instancedMB.size();
       if (numPrimitives == 0) {
         prims.resize(0);
         bvh->set(BVH::emptyNode,empty,0);
@@ -155,9 +161,18 @@ namespace embree
                   builders[objectID] = BVH4Quad4vMeshBuilderSAH((BVH4*)objects[objectID],(QuadMesh*)geom);
                   break;
 #endif
-
-                case Geometry::USER_GEOMETRY: break;
-                case Geometry::BEZIER_CURVES: break;
+#if defined(EMBREE_GEOMETRY_USER)
+                case Geometry::USER_GEOMETRY:
+                  objects[objectID] = new BVH4(Object::type,geom->parent);
+                  builders[objectID] = BVH4VirtualMeshBuilderSAH((BVH4*)objects[objectID],(AccelSet*)geom);
+                  break;
+#endif
+#if defined(EMBREE_GEOMETRY_HAIR)
+                case Geometry::BEZIER_CURVES:
+                  objects[objectID] = new BVH4(Bezier1v::type,geom->parent);
+                  builders[objectID] = BVH4Bezier1vMeshBuilderSAH((BVH4*)objects[objectID],(BezierCurves*)geom);
+                  break;
+#endif
                 case Geometry::SUBDIV_MESH  : break;
                 default                     : break; 
                 }
@@ -330,11 +345,7 @@ namespace embree
       refs.clear();
     }
     
-    Builder* BVH4BuilderInstancingTriangleMeshSAH (void* bvh, Scene* scene, const createTriangleMeshAccelTy createTriangleMeshAccel) {
-      return new BVHNBuilderInstancing<4>((BVH4*)bvh,scene);
-    }
-
-    Builder* BVH4BuilderInstancingQuadMeshSAH (void* bvh, Scene* scene, const createQuadMeshAccelTy createQuadMeshAccel) {
+    Builder* BVH4BuilderInstancingSAH (void* bvh, Scene* scene, size_t mode) {
       return new BVHNBuilderInstancing<4>((BVH4*)bvh,scene);
     }
 
@@ -19,13 +19,16 @@
 
 #include "../builders/primrefgen.h"
 #include "../builders/presplit.h"
+#include "../builders/heuristic_timesplit_array.h"
 
 #include "../geometry/bezier1v.h"
 #include "../geometry/bezier1i.h"
 #include "../geometry/linei.h"
+#include "../geometry/pointv.h"
 #include "../geometry/triangle.h"
 #include "../geometry/trianglev.h"
 #include "../geometry/trianglei.h"
+#include "../geometry/trianglepairv.h"
 #include "../geometry/trianglev_mb.h"
 #include "../geometry/trianglei_mb.h"
 #include "../geometry/quadv.h"
@@ -38,6 +41,9 @@
 #define PROFILE 0
 #define PROFILE_RUNS 20
 
+/* minimal relative reduction of the time-aware SAH cost required to split a time segment */
+#define TIME_SPLIT_MIN_GAIN 0.1f
+
 namespace embree
 {
   namespace isa
@@ -176,6 +182,12 @@ namespace embree
           return;
         }
         
+        /* tiny scenes and meshes fit into a single node */
+        if (presplitFactor == 1.0f && numPrimitives <= min(bvh->device->tiny_scene_threshold,N*Primitive::max_size()*(maxLeafSize/Primitive::max_size()))) {
+          buildTiny(numPrimitives);
+          return;
+        }
+        
         double t0 = bvh->preBuild(mesh ? "" : TOSTRING(isa) "::BVH" + toString(N) + "BuilderSAH");
 
 #if PROFILE
@@ -203,7 +215,20 @@ namespace embree
         
             /* call BVH builder */            
             bvh->alloc.init_estimate(pinfo.size()*sizeof(PrimRef));
-            BVHNBuilder<N>::build(bvh,CreateLeaf<N,Primitive>(bvh,prims.data()),bvh->scene->progressInterface,prims.data(),pinfo,sahBlockSize,minLeafSize,maxLeafSize,travCost,intCost);
+            const size_t compactThreshold = bvh->device->compact_build_threshold;
+            if (presplitFactor == 1.0f && compactThreshold && pinfo.size() > compactThreshold)
+            {
+              /* bounds of primitives get recalculated for the lower levels */
+              auto primBounds = [&] (unsigned geomID, unsigned primID) -> BBox3fa {
+                Mesh* geom = mesh ? mesh : (Mesh*) scene->get(geomID);
+                BBox3fa bounds = empty;
+                geom->buildBounds(primID,&bounds);
+                return bounds;
+              };
+              BVHNBuilderCompact<N>::build(bvh,CreateLeaf<N,Primitive>(bvh,prims.data()),primBounds,bvh->scene->progressInterface,prims.data(),pinfo,sahBlockSize,minLeafSize,maxLeafSize,travCost,intCost);
+            }
+            else
+              BVHNBuilder<N>::build(bvh,CreateLeaf<N,Primitive>(bvh,prims.data()),bvh->scene->progressInterface,prims.data(),pinfo,sahBlockSize,minLeafSize,maxLeafSize,travCost,intCost);
 
 #if PROFILE
           }); 
@@ -220,6 +245,95 @@ namespace embree
         bvh->postBuild(t0);
       }
 
+      /*! builds a single node over at most N leaves on the calling
+       *  thread, without spawning tasks and with a single allocation */
+      void buildTiny(size_t numPrimitives)
+      {
+        double t0 = bvh->preBuild(mesh ? "" : TOSTRING(isa) "::BVH" + toString(N) + "BuilderTiny");
+
+        /* create primref array */
+        prims.resize(numPrimitives);
+        PrimInfo pinfo(empty);
+        auto createPrimRefs = [&] (Mesh* geom) 
+        {
+          for (size_t j=0; j<geom->size(); j++)
+          {
+            BBox3fa bounds = empty;
+            if (!geom->buildBounds(j,&bounds)) continue;
+            const PrimRef prim(bounds,geom->id,unsigned(j));
+            prims[pinfo.size()] = prim;
+            pinfo.add_primref(prim);
+          }
+        };
+        if (mesh) createPrimRefs(mesh);
+        else 
+        {
+          Scene::Iterator<Mesh,false> iter(scene);
+          for (size_t i=0; i<iter.size(); i++)
+            if (iter[i]) createPrimRefs(iter[i]);
+        }
+        const size_t numPrims = pinfo.size();
+
+        /* pinfo might has zero size due to invalid geometry */
+        if (unlikely(numPrims == 0))
+        {
+          prims.clear();
+          bvh->clear();
+          return;
+        }
+
+        /* sort primitives along the largest extent of their centers */
+        const size_t dim = maxDim(pinfo.centBounds.size());
+        std::sort(prims.data(),prims.data()+numPrims,[&] (const PrimRef& a, const PrimRef& b) { 
+            return a.center2()[dim] < b.center2()[dim]; 
+          });
+
+        /* distribute primitives equally over the leaves, only the last leaf has a partially filled block */
+        const size_t numBlocks = Primitive::blocks(numPrims);
+        const size_t leafSize = Primitive::max_size()*((numBlocks+N-1)/N);
+        const size_t numLeaves = (numPrims+leafSize-1)/leafSize;
+        assert(leafSize <= maxLeafSize);
+        const size_t nodeBytes = numLeaves > 1 ? sizeof(typename BVH::AlignedNode) : 0;
+        size_t bytes = nodeBytes + numBlocks*sizeof(Primitive);
+        bvh->alloc.init_exact(bytes);
+        char* ptr = (char*) bvh->alloc.malloc(bytes,BVH::byteNodeAlignment,false);
+
+        typename BVH::AlignedNode* node = nullptr;
+        if (numLeaves > 1) {
+          node = (typename BVH::AlignedNode*) ptr; node->clear();
+          ptr += nodeBytes;
+        }
+
+        typename BVH::NodeRef root = BVH::emptyNode;
+        for (size_t i=0, begin=0; i<numLeaves; i++)
+        {
+          const size_t end = min(begin+leafSize,numPrims);
+          BBox3fa bounds = empty;
+          for (size_t j=begin; j<end; j++) bounds.extend(prims[j].bounds());
+
+          const size_t items = Primitive::blocks(end-begin);
+          Primitive* accel = (Primitive*) ptr;
+          ptr += items*sizeof(Primitive);
+          for (size_t j=0; j<items; j++)
+            accel[j].fill(prims.data(),begin,end,bvh->scene,false);
+
+          const typename BVH::NodeRef leaf = BVH::encodeLeaf((char*)accel,items);
+          if (node) node->set(i,bounds,leaf);
+          else      root = leaf;
+        }
+        if (node) root = bvh->encodeNode(node);
+        bvh->set(root,LBBox3fa(pinfo.geomBounds),numPrims);
+
+        /* clear temporary data for static geometry */
+        bool staticGeom = mesh ? mesh->isStatic() : scene->isStatic();
+        if (staticGeom) {
+          prims.clear(); 
+          bvh->shrink();
+        }
+        bvh->cleanup();
+        bvh->postBuild(t0);
+      }
+
       void clear() {
         prims.clear();
       }
@@ -308,11 +422,75 @@ namespace embree
     /************************************************************************************/
     /************************************************************************************/
 
+    template<int N, typename Primitive>
+    struct BVHNBuilderTrianglePairSAH : public Builder
+    {
+      typedef BVHN<N> BVH;
+      BVH* bvh;
+      Scene* scene;
+      mvector<PrimRef> prims;
+      const size_t sahBlockSize;
+      const float intCost;
+      const size_t minLeafSize;
+      const size_t maxLeafSize;
+
+      BVHNBuilderTrianglePairSAH (BVH* bvh, Scene* scene, const size_t sahBlockSize, const float intCost, const size_t minLeafSize, const size_t maxLeafSize, const size_t mode)
+        : bvh(bvh), scene(scene), prims(scene->device), sahBlockSize(sahBlockSize), intCost(intCost), minLeafSize(minLeafSize), maxLeafSize(min(maxLeafSize,Primitive::max_size()*BVH::maxLeafBlocks)) {}
+
+      void build(size_t, size_t) 
+      {
+	/* skip build for empty scene */
+        const size_t numTriangles = scene->getNumPrimitives<TriangleMesh,false>();
+        if (numTriangles == 0) {
+          prims.clear();
+          bvh->clear();
+          return;
+        }
+
+        double t0 = bvh->preBuild(TOSTRING(isa) "::BVH" + toString(N) + "BuilderTrianglePairSAH");
+
+        /* pair adjacent triangles of all modified meshes */
+        const size_t numPairs = createTrianglePairs(scene);
+        if (unlikely(numPairs == 0))
+        {
+          prims.clear();
+          bvh->clear();
+          return;
+        }
+
+        /* create primref array */
+        prims.resize(numPairs);
+        PrimInfo pinfo = createTrianglePairRefArray(scene,prims,bvh->scene->progressInterface);
+
+        /* call BVH builder */
+        bvh->alloc.init_estimate(pinfo.size()*sizeof(PrimRef));
+        BVHNBuilder<N>::build(bvh,CreateLeaf<N,Primitive>(bvh,prims.data()),bvh->scene->progressInterface,prims.data(),pinfo,sahBlockSize,minLeafSize,maxLeafSize,travCost,intCost);
+
+	/* clear temporary data for static geometry */
+	if (scene->isStatic()) {
+          prims.clear();
+          bvh->shrink();
+        }
+	bvh->cleanup();
+        bvh->postBuild(t0);
+      }
+
+      void clear() {
+        prims.clear();
+      }
+    };
+
+    /************************************************************************************/ 
+    /************************************************************************************/
+    /************************************************************************************/
+    /************************************************************************************/
+
     template<int N, typename Primitive>
     struct CreateMSMBlurLeaf
     {
       typedef BVHN<N> BVH;
-      __forceinline CreateMSMBlurLeaf (BVH* bvh, PrimRef* prims, size_t time) : bvh(bvh), prims(prims), time(time) {}
+      __forceinline CreateMSMBlurLeaf (BVH* bvh, PrimRef* prims, size_t time, const BBox1f& dt = BBox1f(0.0f,1.0f)) 
+        : bvh(bvh), prims(prims), time(time), dt(dt) {}
       
       __forceinline LBBox3fa operator() (const BVHBuilderBinnedSAH::BuildRecord& current, Allocator* alloc)
       {
@@ -324,12 +502,13 @@ namespace embree
         for (size_t i=0; i<items; i++)
           allBounds.extend(accel[i].fillMB(prims, start, current.prims.end(), bvh->scene, false, time, bvh->numTimeSteps));
         *current.parent = node;
-        return allBounds;
+        return allBounds.interpolate(dt);
       }
 
       BVH* bvh;
       PrimRef* prims;
       size_t time;
+      BBox1f dt;
     };
 
     template<int N, typename Mesh, typename Primitive>
@@ -344,10 +523,37 @@ namespace embree
       const float intCost;
       const size_t minLeafSize;
       const size_t maxLeafSize;
+      const bool quantized;
 
-      BVHNBuilderMSMBlurSAH (BVH* bvh, Scene* scene, const size_t sahBlockSize, const float intCost, const size_t minLeafSize, const size_t maxLeafSize)
+      BVHNBuilderMSMBlurSAH (BVH* bvh, Scene* scene, const size_t sahBlockSize, const float intCost, const size_t minLeafSize, const size_t maxLeafSize, const bool quantized = false)
         : bvh(bvh), scene(scene), prims(scene->device), 
-          sahBlockSize(sahBlockSize), intCost(intCost), minLeafSize(minLeafSize), maxLeafSize(min(maxLeafSize,Primitive::max_size()*BVH::maxLeafBlocks)) {}
+          sahBlockSize(sahBlockSize), intCost(intCost), minLeafSize(minLeafSize), maxLeafSize(min(maxLeafSize,Primitive::max_size()*BVH::maxLeafBlocks)), quantized(quantized) {}
+
+      /*! maximal number of temporal splits per time segment, rounded down to a power of two */
+      size_t maxTimeSplitsMB() const
+      {
+        const size_t maxTimeSplits = max(size_t(1),bvh->device->max_time_splits);
+        return size_t(1) << __bsr(maxTimeSplits);
+      }
+
+      /*! recomputes the build bounds of the primitives for the time range dt of the time segment */
+      PrimInfo updatePrimRefArrayMBlur(const size_t itime, const BBox1f& dt, const size_t numPrims)
+      {
+        return parallel_reduce(size_t(0),numPrims,size_t(1024),PrimInfo(empty),[&] (const range<size_t>& r) -> PrimInfo
+        {
+          PrimInfo pinfo(empty);
+          for (size_t i=r.begin(); i<r.end(); i++)
+          {
+            const unsigned geomID = prims[i].geomID();
+            const unsigned primID = prims[i].primID();
+            const Mesh* mesh = (Mesh*) scene->get(geomID);
+            const BBox3fa bounds = mesh->linearBounds(primID,itime,bvh->numTimeSteps).interpolate(dt).interpolate(0.5f);
+            prims[i] = PrimRef(bounds,geomID,primID);
+            pinfo.add(bounds,bounds.center2());
+          }
+          return pinfo;
+        }, [] (const PrimInfo& a, const PrimInfo& b) -> PrimInfo { return PrimInfo::merge(a,b); });
+      }
 
       void build(size_t, size_t) 
       {
@@ -365,34 +571,58 @@ namespace embree
         /* allocate buffers */
         bvh->numTimeSteps = scene->getNumTimeSteps<Mesh,true>();
         const size_t numTimeSegments = bvh->numTimeSteps-1; assert(bvh->numTimeSteps > 1);
+        const size_t maxTimeSplits = maxTimeSplitsMB();
         prims.resize(numPrimitives);
         bvh->alloc.init_estimate(numPrimitives*sizeof(PrimRef)*numTimeSegments);
-        NodeRef* roots = (NodeRef*) bvh->alloc.threadLocal2()->alloc0->malloc(sizeof(NodeRef)*numTimeSegments,BVH::byteNodeAlignment);
+        NodeRef* roots = (NodeRef*) bvh->alloc.threadLocal2()->alloc0->malloc(sizeof(NodeRef)*numTimeSegments*maxTimeSplits,BVH::byteNodeAlignment);
 
-        /* build BVH for each timestep */
-        avector<BBox3fa> bounds(bvh->numTimeSteps);
+        /* build BVH for each timestep, optionally split into temporal sub-ranges */
+        avector<BBox3fa> bounds(numTimeSegments*maxTimeSplits+1);
+        for (size_t i=0; i<bounds.size(); i++) bounds[i] = empty;
         size_t num_bvh_primitives = 0;
         for (size_t t=0; t<numTimeSegments; t++)
         {
-          /* call BVH builder */
-          NodeRef root; LBBox3fa tbounds;
           const PrimInfo pinfo = createPrimRefArrayMBlur<Mesh>(t,bvh->numTimeSteps,scene,prims,bvh->scene->progressInterface);
-          if (pinfo.size())
-          {
-            std::tie(root, tbounds) = BVHNBuilderMblur<N>::build(bvh,CreateMSMBlurLeaf<N,Primitive>(bvh,prims.data(),t),bvh->scene->progressInterface,prims.data(),pinfo,
-                                                                 sahBlockSize,minLeafSize,maxLeafSize,travCost,intCost);
+          num_bvh_primitives = max(num_bvh_primitives,pinfo.size());
+
+          /* select number of temporal splits by time-aware SAH */
+          size_t numTimeSplits = 1;
+          if (maxTimeSplits > 1 && pinfo.size()) {
+            HeuristicArrayTimeSplitSAH<Mesh> heuristic(scene,prims.data(),pinfo.size(),t,bvh->numTimeSteps);
+            numTimeSplits = heuristic.numTimeSplits(maxTimeSplits,__bsf(sahBlockSize),travCost,intCost,TIME_SPLIT_MIN_GAIN);
           }
-          else
+
+          for (size_t i=0; i<numTimeSplits; i++)
           {
-            tbounds = LBBox3fa(empty);
-            root = BVH::emptyNode;
+            /* call BVH builder */
+            const BBox1f dt = HeuristicArrayTimeSplitSAH<Mesh>::timeSplit(i,numTimeSplits);
+            NodeRef root; LBBox3fa tbounds;
+            if (pinfo.size())
+            {
+              const PrimInfo tinfo = numTimeSplits > 1 ? updatePrimRefArrayMBlur(t,dt,pinfo.size()) : pinfo;
+              std::tie(root, tbounds) = BVHNBuilderMblur<N>::build(bvh,CreateMSMBlurLeaf<N,Primitive>(bvh,prims.data(),t,dt),bvh->scene->progressInterface,prims.data(),tinfo,
+                                                                   sahBlockSize,minLeafSize,maxLeafSize,travCost,intCost,dt,quantized);
+            }
+            else
+            {
+              tbounds = LBBox3fa(empty);
+              root = BVH::emptyNode;
+            }
+
+            /* a temporal split covers maxTimeSplits/numTimeSplits root slots */
+            const size_t slots = maxTimeSplits/numTimeSplits;
+            for (size_t j=0; j<slots; j++) 
+            {
+              const size_t k = t*maxTimeSplits + i*slots + j;
+              roots[k] = root;
+              if (root == BVH::emptyNode) continue;
+              bounds[k+0].extend(tbounds.interpolate(float(j+0)/float(slots)));
+              bounds[k+1].extend(tbounds.interpolate(float(j+1)/float(slots)));
+            }
           }
-          roots[t] = root;
-          bounds[t+0] = tbounds.bounds0;
-          bounds[t+1] = tbounds.bounds1;
-          num_bvh_primitives = max(num_bvh_primitives,pinfo.size());
         }
         bvh->set(NodeRef((size_t)roots),LBBox3fa(bounds),num_bvh_primitives);
+        bvh->numTimeSplits = unsigned(maxTimeSplits);
         bvh->msmblur = true;
 
 	/* clear temporary data for static geometry */
@@ -434,14 +664,15 @@ namespace embree
       const size_t minLeafSize;
       const size_t maxLeafSize;
       const float splitFactor;
+      const size_t sweepThreshold;
 
       BVHNBuilderFastSpatialSAH (BVH* bvh, Scene* scene, const size_t sahBlockSize, const float intCost, const size_t minLeafSize, const size_t maxLeafSize, const size_t mode)
         : bvh(bvh), scene(scene), mesh(nullptr), prims0(scene->device), sahBlockSize(sahBlockSize), intCost(intCost), minLeafSize(minLeafSize), maxLeafSize(min(maxLeafSize,Primitive::max_size()*BVH::maxLeafBlocks)),
-          splitFactor(scene->device->max_spatial_split_replications) {}
+          splitFactor(scene->device->max_spatial_split_replications), sweepThreshold(scene->device->sweep_build_threshold) {}
 
       BVHNBuilderFastSpatialSAH (BVH* bvh, Mesh* mesh, const size_t sahBlockSize, const float intCost, const size_t minLeafSize, const size_t maxLeafSize, const size_t mode)
         : bvh(bvh), scene(nullptr), mesh(mesh), prims0(bvh->device), sahBlockSize(sahBlockSize), intCost(intCost), minLeafSize(minLeafSize), maxLeafSize(min(maxLeafSize,Primitive::max_size()*BVH::maxLeafBlocks)),
-          splitFactor(scene->device->max_spatial_split_replications) {}
+          splitFactor(bvh->device->max_spatial_split_replications), sweepThreshold(bvh->device->sweep_build_threshold) {}
 
       // FIXME: shrink bvh->alloc in destructor here and in other builders too
 
@@ -515,7 +746,8 @@ namespace embree
           pinfo,
           N,BVH::maxBuildDepthLeaf,
           sahBlockSize,minLeafSize,maxLeafSize,
-          travCost,intCost);
+          travCost,intCost,
+          sweepThreshold);
         
 
         bvh->set(root,LBBox3fa(pinfo.geomBounds),pinfo.size());      
@@ -659,8 +891,16 @@ namespace embree
 #endif
 #endif
 
+#if defined(EMBREE_GEOMETRY_POINTS)
+    Builder* BVH4Point4vSceneBuilderSAH    (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAH<4,Points,Point4v>((BVH4*)bvh,scene,4,1.0f,4,inf,mode); }
+#if defined(__AVX__)
+    Builder* BVH8Point4vSceneBuilderSAH    (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAH<8,Points,Point4v>((BVH8*)bvh,scene,4,1.0f,4,inf,mode); }
+#endif
+#endif
+
 #if defined(EMBREE_GEOMETRY_HAIR)
     Builder* BVH4Bezier1vSceneBuilderSAH   (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAH<4,BezierCurves,Bezier1v>((BVH4*)bvh,scene,1,1.0f,1,1,mode); }
+    Builder* BVH4Bezier1vMeshBuilderSAH    (void* bvh, BezierCurves* mesh, size_t mode) { return new BVHNBuilderSAH<4,BezierCurves,Bezier1v>((BVH4*)bvh,mesh,1,1.0f,1,1,mode); }
     Builder* BVH4Bezier1iSceneBuilderSAH   (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAH<4,BezierCurves,Bezier1i>((BVH4*)bvh,scene,1,1.0f,1,1,mode); }
 #endif
 
@@ -682,6 +922,9 @@ namespace embree
 
 
     Builder* BVH4QuantizedTriangle4iSceneBuilderSAH (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAHQuantized<4,TriangleMesh,Triangle4i>((BVH4*)bvh,scene,4,1.0f,4,inf,mode); }
+    Builder* BVH4QuantizedTriangle4iMBSceneBuilderSAH (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderMSMBlurSAH<4,TriangleMesh,Triangle4iMB>((BVH4*)bvh,scene,4,1.0f,4,inf,true); }
+
+    Builder* BVH4TrianglePair4vSceneBuilderSAH (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderTrianglePairSAH<4,TrianglePair4v>((BVH4*)bvh,scene,4,1.0f,4,inf,mode); }
 #if defined(__AVX__)
     Builder* BVH8Triangle4MeshBuilderSAH  (void* bvh, TriangleMesh* mesh, size_t mode) { return new BVHNBuilderSAH<8,TriangleMesh,Triangle4>((BVH8*)bvh,mesh,4,1.0f,4,inf,mode); }
     Builder* BVH8Triangle4vMeshBuilderSAH (void* bvh, TriangleMesh* mesh, size_t mode) { return new BVHNBuilderSAH<8,TriangleMesh,Triangle4v>((BVH8*)bvh,mesh,4,1.0f,4,inf,mode); }
@@ -695,6 +938,7 @@ namespace embree
     Builder* BVH8QuantizedTriangle4iSceneBuilderSAH  (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAHQuantized<8,TriangleMesh,Triangle4i>((BVH8*)bvh,scene,4,1.0f,4,inf,mode); }
     Builder* BVH8Triangle4SceneBuilderFastSpatialSAH  (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderFastSpatialSAH<8,TriangleMesh,Triangle4,TriangleSplitterFactory>((BVH8*)bvh,scene,4,1.0f,4,inf,mode); }
     Builder* BVH8Triangle4vSceneBuilderFastSpatialSAH  (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderFastSpatialSAH<8,TriangleMesh,Triangle4v,TriangleSplitterFactory>((BVH8*)bvh,scene,4,1.0f,4,inf,mode); }
+    Builder* BVH8TrianglePair4vSceneBuilderSAH (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderTrianglePairSAH<8,TrianglePair4v>((BVH8*)bvh,scene,4,1.0f,4,inf,mode); }
 
     /* experimental full sweep builder */
     Builder* BVH8Triangle4SceneBuilderSweepSAH  (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSweepSAH<8,TriangleMesh,Triangle4>((BVH8*)bvh,scene,4,1.0f,4,inf,mode); }
@@ -710,6 +954,7 @@ namespace embree
     Builder* BVH4Quad4iMBSceneBuilderSAH (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderMSMBlurSAH<4,QuadMesh,Quad4iMB>((BVH4*)bvh,scene ,4,1.0f,4,inf); }
     Builder* BVH4QuantizedQuad4vSceneBuilderSAH     (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAHQuantized<4,QuadMesh,Quad4v>((BVH4*)bvh,scene,4,1.0f,4,inf,mode); }
     Builder* BVH4QuantizedQuad4iSceneBuilderSAH     (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAHQuantized<4,QuadMesh,Quad4i>((BVH4*)bvh,scene,4,1.0f,4,inf,mode); }
+    Builder* BVH4QuantizedQuad4iMBSceneBuilderSAH   (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderMSMBlurSAH<4,QuadMesh,Quad4iMB>((BVH4*)bvh,scene,4,1.0f,4,inf,true); }
     Builder* BVH4Quad4vSceneBuilderFastSpatialSAH  (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderFastSpatialSAH<4,QuadMesh,Quad4v,QuadSplitterFactory>((BVH4*)bvh,scene,4,1.0f,4,inf,mode); }
 
 #if defined(__AVX__)
@@ -319,6 +319,9 @@ namespace embree
         Scene::Iterator<SubdivMesh,mblur> iter(scene);
         parallel_for_for_prefix_sum( pstate, iter, PrimInfo(empty), [&](SubdivMesh* mesh, const range<size_t>& r, size_t k, const PrimInfo& base) -> PrimInfo
         {
+          const bool useGridStencils = mesh->useGridStencils();
+          avector<Vec3fa> basis;
+
           size_t s = 0;
           size_t sMB = 0;
           for (size_t f=r.begin(); f!=r.end(); ++f) 
@@ -335,6 +338,9 @@ namespace embree
               const size_t patchIndexMB = base.end+sMB;
               assert(patchIndex < numPrimitives);
 
+              if (useGridStencils) 
+                updateGridStencil(mesh,unsigned(f),subPatch,uv,edge_level,subdiv,basis);
+
               for (size_t t=0; t<mesh->numTimeSteps; t++)
               {
                 SubdivPatch1Base& patch = subdiv_patches[patchIndexMB+t];
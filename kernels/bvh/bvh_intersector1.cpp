@@ -30,6 +30,8 @@
 #include "../geometry/bezier1v_intersector.h"
 #include "../geometry/bezier1i_intersector.h"
 #include "../geometry/linei_intersector.h"
+#include "../geometry/pointv_intersector.h"
+#include "../geometry/trianglepairv_intersector.h"
 #include "../geometry/subdivpatch1eager_intersector.h"
 #include "../geometry/subdivpatch1cached_intersector.h"
 #include "../geometry/object_intersector.h"
@@ -44,6 +46,16 @@ namespace embree
   
     template<int N, int types, bool robust, typename PrimitiveIntersector1>
     void BVHNIntersector1<N,types,robust,PrimitiveIntersector1>::intersect(const BVH* __restrict__ bvh, Ray& __restrict__ ray, IntersectContext* context)
+    {
+      /* the traversal stack lives in separate functions, thus only the selected traversal allocates its stack */
+      if (unlikely(!(types & BVH_FLAG_TRANSFORM_NODE) && bvh->device->short_stack_traversal))
+        intersectShortStack(bvh,ray,context);
+      else
+        intersectFullStack(bvh,ray,context);
+    }
+
+    template<int N, int types, bool robust, typename PrimitiveIntersector1>
+    __noinline void BVHNIntersector1<N,types,robust,PrimitiveIntersector1>::intersectFullStack(const BVH* __restrict__ bvh, Ray& __restrict__ ray, IntersectContext* context)
     {
       /*! perform per ray precalculations required by the primitive intersector */
       Precalculations pre(ray,bvh,bvh->numTimeSteps);
@@ -92,6 +104,7 @@ namespace embree
           /*! stop if we found a leaf node */
           if (unlikely(cur.isLeaf())) break;
           STAT3(normal.trav_nodes,1,1,1);
+          COST(CostCounters::nodes(context,1));
 
           /* intersect node */
           size_t mask = 0;
@@ -145,6 +158,28 @@ namespace embree
       if (unlikely(ray.geomID == 0))
         return;
 
+      if (unlikely(!(types & BVH_FLAG_TRANSFORM_NODE) && bvh->device->short_stack_traversal))
+        occludedShortStack(bvh,ray,context);
+      else
+        occludedFullStack(bvh,ray,context);
+    }
+
+    template<int N, int types, bool robust, typename PrimitiveIntersector1>
+    __forceinline bool BVHNIntersector1<N,types,robust,PrimitiveIntersector1>::occludedCached(const BVH* __restrict__ bvh, Precalculations& pre, Ray& __restrict__ ray, IntersectContext* context)
+    {
+      const NodeRef cur = (NodeRef) OccluderCache::lookup(bvh,bvh->generation);
+      if (cur == 0) return false;
+      STAT3(shadow.trav_cache_tests,1,1,1);
+      size_t num; Primitive* prim = (Primitive*) cur.leaf(num);
+      size_t lazy_node = 0;
+      if (!PrimitiveIntersector1::occluded(pre,ray,context,0,prim,num,lazy_node)) return false;
+      STAT3(shadow.trav_cache_hits,1,1,1);
+      return true;
+    }
+
+    template<int N, int types, bool robust, typename PrimitiveIntersector1>
+    __noinline void BVHNIntersector1<N,types,robust,PrimitiveIntersector1>::occludedFullStack(const BVH* __restrict__ bvh, Ray& __restrict__ ray, IntersectContext* context)
+    {
       /*! perform per ray precalculations required by the primitive intersector */
       Precalculations pre(ray,bvh,bvh->numTimeSteps);
 
@@ -171,6 +206,14 @@ namespace embree
       vfloat<Nx> ray_near = max(ray.tnear,0.0f);
       vfloat<Nx> ray_far  = max(ray.tfar ,0.0f);
 
+      /*! first test the leaf that occluded the previous shadow ray */
+      const bool cacheOccluders = !(types & BVH_FLAG_TRANSFORM_NODE) && bvh->device->occluder_cache;
+      if (unlikely(cacheOccluders) && occludedCached(bvh,pre,ray,context)) {
+        ray.geomID = 0;
+        return;
+      }
+      bool lazy = false;
+
       /*! initialize the node traverser */
       BVHNNodeTraverser1<N,Nx,types> nodeTraverser(vray);
 
@@ -188,6 +231,7 @@ namespace embree
           /*! stop if we found a leaf node */
           if (unlikely(cur.isLeaf())) break;
           STAT3(shadow.trav_nodes,1,1,1);
+          COST(CostCounters::nodes(context,1));
 
           /* intersect node */
           size_t mask = 0;
@@ -214,6 +258,7 @@ namespace embree
         size_t lazy_node = 0;
         if (PrimitiveIntersector1::occluded(pre,ray,context,leafType,prim,num,lazy_node)) {
           ray.geomID = 0;
+          if (unlikely(cacheOccluders && !lazy)) OccluderCache::store(bvh,bvh->generation,cur);
           break;
         }
         
@@ -221,6 +266,171 @@ namespace embree
         if (unlikely(lazy_node)) {
           *stackPtr = (NodeRef)lazy_node;
           stackPtr++;
+          lazy = true;
+        }
+      }
+      AVX_ZERO_UPPER();
+    }
+
+    template<int N, int types, bool robust, typename PrimitiveIntersector1>
+    __noinline void BVHNIntersector1<N,types,robust,PrimitiveIntersector1>::intersectShortStack(const BVH* __restrict__ bvh, Ray& __restrict__ ray, IntersectContext* context)
+    {
+      /*! perform per ray precalculations required by the primitive intersector */
+      Precalculations pre(ray,bvh,bvh->numTimeSteps);
+
+      /* filter out invalid rays */
+#if defined(EMBREE_IGNORE_INVALID_RAYS)
+      if (!ray.valid()) return;
+#endif
+      /* verify correct input */
+      assert(ray.valid());
+      assert(ray.tnear >= 0.0f);
+      assert(!(types & BVH_MB) || (ray.time >= 0.0f && ray.time <= 1.0f));
+
+      /*! load the ray into SIMD registers */
+      size_t leafType = 0;
+      context->geomID_to_instID = nullptr;
+      TravRay<N,Nx> vray(ray.org,ray.dir);
+      vfloat<Nx> ray_near = max(ray.tnear,0.0f);
+      vfloat<Nx> ray_far  = max(ray.tfar ,0.0f);
+
+      /*! short stack state */
+      NodeRef cur;
+      BVHNShortStackTraverser1<N,Nx,types,true> traverser(bvh->getRoot(pre));
+
+      /*! intersects the nodes on the current path when the traversal restarts */
+      auto intersectNode = [&] (NodeRef node, vfloat<Nx>& tNear, size_t& mask) {
+        STAT3(normal.trav_nodes,1,1,1);
+        COST(CostCounters::nodes(context,1));
+        BVHNNodeIntersector1<N,Nx,types,robust>::intersect(node,vray,ray_near,ray_far,pre.ftime(),tNear,mask);
+      };
+
+      /* pop loop */
+      while (true) pop:
+      {
+        /*! pop next node */
+        if (unlikely(!traverser.pop(cur,ray.tfar,intersectNode))) break;
+
+        /* downtraversal loop */
+        while (true)
+        {
+          /*! stop if we found a leaf node */
+          if (unlikely(cur.isLeaf())) break;
+          STAT3(normal.trav_nodes,1,1,1);
+          COST(CostCounters::nodes(context,1));
+
+          /* intersect node */
+          size_t mask = 0;
+          vfloat<Nx> tNear;
+          BVHNNodeIntersector1<N,Nx,types,robust>::intersect(cur,vray,ray_near,ray_far,pre.ftime(),tNear,mask);
+
+          /*! if no child is hit, pop next node */
+          if (unlikely(mask == 0))
+            goto pop;
+
+          /* select next child and push other children */
+          traverser.traverse(cur,mask,tNear);
+        }
+
+        /*! this is a leaf node */
+        assert(cur != BVH::emptyNode);
+        STAT3(normal.trav_leaves,1,1,1);
+        size_t num; Primitive* prim = (Primitive*) cur.leaf(num);
+        size_t lazy_node = 0;
+        PrimitiveIntersector1::intersect(pre,ray,context,leafType,prim,num,lazy_node);
+        ray_far = ray.tfar;
+
+        /*! push lazy node onto stack */
+        if (unlikely(lazy_node))
+          traverser.pushLazy((NodeRef)lazy_node);
+      }
+      AVX_ZERO_UPPER();
+    }
+
+    template<int N, int types, bool robust, typename PrimitiveIntersector1>
+    __noinline void BVHNIntersector1<N,types,robust,PrimitiveIntersector1>::occludedShortStack(const BVH* __restrict__ bvh, Ray& __restrict__ ray, IntersectContext* context)
+    {
+      /*! perform per ray precalculations required by the primitive intersector */
+      Precalculations pre(ray,bvh,bvh->numTimeSteps);
+
+      /* filter out invalid rays */
+#if defined(EMBREE_IGNORE_INVALID_RAYS)
+      if (!ray.valid()) return;
+#endif
+
+      /* verify correct input */
+      assert(ray.valid());
+      assert(ray.tnear >= 0.0f);
+      assert(!(types & BVH_MB) || (ray.time >= 0.0f && ray.time <= 1.0f));
+
+      /*! load the ray into SIMD registers */
+      size_t leafType = 0;
+      context->geomID_to_instID = nullptr;
+      TravRay<N,Nx> vray(ray.org,ray.dir);
+      vfloat<Nx> ray_near = max(ray.tnear,0.0f);
+      vfloat<Nx> ray_far  = max(ray.tfar ,0.0f);
+
+      /*! first test the leaf that occluded the previous shadow ray */
+      const bool cacheOccluders = !(types & BVH_FLAG_TRANSFORM_NODE) && bvh->device->occluder_cache;
+      if (unlikely(cacheOccluders) && occludedCached(bvh,pre,ray,context)) {
+        ray.geomID = 0;
+        return;
+      }
+      bool lazy = false;
+
+      /*! short stack state */
+      NodeRef cur;
+      BVHNShortStackTraverser1<N,Nx,types,false> traverser(bvh->getRoot(pre));
+
+      /*! intersects the nodes on the current path when the traversal restarts */
+      auto intersectNode = [&] (NodeRef node, vfloat<Nx>& tNear, size_t& mask) {
+        STAT3(shadow.trav_nodes,1,1,1);
+        COST(CostCounters::nodes(context,1));
+        BVHNNodeIntersector1<N,Nx,types,robust>::intersect(node,vray,ray_near,ray_far,pre.ftime(),tNear,mask);
+      };
+
+      /* pop loop */
+      while (true) pop:
+      {
+        /*! pop next node */
+        if (unlikely(!traverser.pop(cur,ray.tfar,intersectNode))) break;
+
+        /* downtraversal loop */
+        while (true)
+        {
+          /*! stop if we found a leaf node */
+          if (unlikely(cur.isLeaf())) break;
+          STAT3(shadow.trav_nodes,1,1,1);
+          COST(CostCounters::nodes(context,1));
+
+          /* intersect node */
+          size_t mask = 0;
+          vfloat<Nx> tNear;
+          BVHNNodeIntersector1<N,Nx,types,robust>::intersect(cur,vray,ray_near,ray_far,pre.ftime(),tNear,mask);
+
+          /*! if no child is hit, pop next node */
+          if (unlikely(mask == 0))
+            goto pop;
+
+          /* select next child and push other children */
+          traverser.traverse(cur,mask,tNear);
+        }
+
+        /*! this is a leaf node */
+        assert(cur != BVH::emptyNode);
+        STAT3(shadow.trav_leaves,1,1,1);
+        size_t num; Primitive* prim = (Primitive*) cur.leaf(num);
+        size_t lazy_node = 0;
+        if (PrimitiveIntersector1::occluded(pre,ray,context,leafType,prim,num,lazy_node)) {
+          ray.geomID = 0;
+          if (unlikely(cacheOccluders && !lazy)) OccluderCache::store(bvh,bvh->generation,cur);
+          break;
+        }
+
+        /*! push lazy node onto stack */
+        if (unlikely(lazy_node)) {
+          traverser.pushLazy((NodeRef)lazy_node);
+          lazy = true;
         }
       }
       AVX_ZERO_UPPER();
@@ -233,20 +443,22 @@ namespace embree
     IF_ENABLED_LINES(DEFINE_INTERSECTOR1(BVH4Line4iIntersector1,BVHNIntersector1<4 COMMA BVH_AN1 COMMA false COMMA ArrayIntersector1<LineMiIntersector1<SIMD_MODE(4) COMMA true> > >));
     IF_ENABLED_LINES(DEFINE_INTERSECTOR1(BVH4Line4iMBIntersector1,BVHNIntersector1<4 COMMA BVH_AN2 COMMA false COMMA ArrayIntersector1<LineMiMBIntersector1<SIMD_MODE(4) COMMA true> > >));
 
+    IF_ENABLED_POINTS(DEFINE_INTERSECTOR1(BVH4Point4vIntersector1,BVHNIntersector1<4 COMMA BVH_AN1 COMMA false COMMA ArrayIntersector1<PointMvIntersector1<4 COMMA true> > >));
+    IF_ENABLED_TRIS(DEFINE_INTERSECTOR1(BVH4TrianglePair4vIntersector1,BVHNIntersector1<4 COMMA BVH_AN1 COMMA false COMMA ArrayIntersector1<TrianglePairMvIntersector1Moeller<4 COMMA true> > >));
+
     IF_ENABLED_HAIR(DEFINE_INTERSECTOR1(BVH4Bezier1vIntersector1,BVHNIntersector1<4 COMMA BVH_AN1 COMMA false COMMA ArrayIntersector1<Bezier1vIntersector1> >));
     IF_ENABLED_HAIR(DEFINE_INTERSECTOR1(BVH4Bezier1iIntersector1,BVHNIntersector1<4 COMMA BVH_AN1 COMMA false COMMA ArrayIntersector1<Bezier1iIntersector1> >));
     IF_ENABLED_HAIR(DEFINE_INTERSECTOR1(BVH4Bezier1vIntersector1_OBB,BVHNIntersector1<4 COMMA BVH_AN1_UN1 COMMA false COMMA ArrayIntersector1<Bezier1vIntersector1> >));
     IF_ENABLED_HAIR(DEFINE_INTERSECTOR1(BVH4Bezier1iIntersector1_OBB,BVHNIntersector1<4 COMMA BVH_AN1_UN1 COMMA false COMMA ArrayIntersector1<Bezier1iIntersector1> >));
     IF_ENABLED_HAIR(DEFINE_INTERSECTOR1(BVH4Bezier1iMBIntersector1_OBB,BVHNIntersector1<4 COMMA BVH_AN2_UN2 COMMA false COMMA ArrayIntersector1<Bezier1iIntersector1MB> >));
   
-#if 1
-    typedef Select2Intersector1<
+    typedef Select5Intersector1<
       TriangleMIntersector1Moeller<4 COMMA 4 COMMA true>,
-      TriangleMvMBIntersector1Moeller<4 COMMA 4 COMMA true> > Intersector1_Triangle4Moeller_Triangle4vMBMoeller;
-    IF_ENABLED_TRIS(DEFINE_INTERSECTOR1(BVH4XfmTriangle4Intersector1Moeller,BVHNIntersector1<4 COMMA BVH_TN_AN1_AN2 COMMA false COMMA Intersector1_Triangle4Moeller_Triangle4vMBMoeller>));
-#else
-    IF_ENABLED_TRIS(DEFINE_INTERSECTOR1(BVH4XfmTriangle4Intersector1Moeller,BVHNIntersector1<4 COMMA BVH_TN_AN1 COMMA false COMMA ArrayIntersector1<TriangleMIntersector1Moeller<4 COMMA 4 COMMA true> > >));
-#endif
+      TriangleMvMBIntersector1Moeller<4 COMMA 4 COMMA true>,
+      QuadMvIntersector1Moeller<4 COMMA true>,
+      ObjectIntersector1<false>,
+      Bezier1vIntersector1> Intersector1_Instanced;
+    IF_ENABLED_TRIS(DEFINE_INTERSECTOR1(BVH4XfmIntersector1Moeller,BVHNIntersector1<4 COMMA BVH_TN_AN1_AN2 COMMA false COMMA Intersector1_Instanced>));
 
     IF_ENABLED_TRIS(DEFINE_INTERSECTOR1(BVH4Triangle4Intersector1Moeller,  BVHNIntersector1<4 COMMA BVH_AN1 COMMA false COMMA ArrayIntersector1<TriangleMIntersector1Moeller  <SIMD_MODE(4) COMMA true> > >));
     IF_ENABLED_TRIS(DEFINE_INTERSECTOR1(BVH4Triangle4iIntersector1Moeller, BVHNIntersector1<4 COMMA BVH_AN1 COMMA false COMMA ArrayIntersector1<TriangleMiIntersector1Moeller <SIMD_MODE(4) COMMA true> > >));
@@ -255,8 +467,10 @@ namespace embree
 
     IF_ENABLED_TRIS(DEFINE_INTERSECTOR1(BVH4Triangle4vMBIntersector1Moeller, BVHNIntersector1<4 COMMA BVH_AN2 COMMA false COMMA ArrayIntersector1<TriangleMvMBIntersector1Moeller <SIMD_MODE(4) COMMA true> > >));
     IF_ENABLED_TRIS(DEFINE_INTERSECTOR1(BVH4Triangle4iMBIntersector1Moeller, BVHNIntersector1<4 COMMA BVH_AN2 COMMA false COMMA ArrayIntersector1<TriangleMiMBIntersector1Moeller <SIMD_MODE(4) COMMA true> > >));
+    IF_ENABLED_TRIS(DEFINE_INTERSECTOR1(QBVH4Triangle4iMBIntersector1Moeller, BVHNIntersector1<4 COMMA BVH_QN2 COMMA false COMMA ArrayIntersector1<TriangleMiMBIntersector1Moeller <SIMD_MODE(4) COMMA true> > >));
     IF_ENABLED_TRIS(DEFINE_INTERSECTOR1(BVH4Triangle4vMBIntersector1Pluecker,BVHNIntersector1<4 COMMA BVH_AN2 COMMA true  COMMA ArrayIntersector1<TriangleMvMBIntersector1Pluecker<SIMD_MODE(4) COMMA true> > >));
     IF_ENABLED_TRIS(DEFINE_INTERSECTOR1(BVH4Triangle4iMBIntersector1Pluecker,BVHNIntersector1<4 COMMA BVH_AN2 COMMA true  COMMA ArrayIntersector1<TriangleMiMBIntersector1Pluecker<SIMD_MODE(4) COMMA true> > >));
+    IF_ENABLED_TRIS(DEFINE_INTERSECTOR1(QBVH4Triangle4iMBIntersector1Pluecker,BVHNIntersector1<4 COMMA BVH_QN2 COMMA true  COMMA ArrayIntersector1<TriangleMiMBIntersector1Pluecker<SIMD_MODE(4) COMMA true> > >));
 
     IF_ENABLED_QUADS(DEFINE_INTERSECTOR1(BVH4Quad4vIntersector1Moeller, BVHNIntersector1<4 COMMA BVH_AN1 COMMA false COMMA ArrayIntersector1<QuadMvIntersector1Moeller <4 COMMA true> > >));
     IF_ENABLED_QUADS(DEFINE_INTERSECTOR1(BVH4Quad4iIntersector1Moeller, BVHNIntersector1<4 COMMA BVH_AN1 COMMA false COMMA ArrayIntersector1<QuadMiIntersector1Moeller <4 COMMA true> > >));
@@ -264,7 +478,9 @@ namespace embree
     IF_ENABLED_QUADS(DEFINE_INTERSECTOR1(BVH4Quad4iIntersector1Pluecker,BVHNIntersector1<4 COMMA BVH_AN1 COMMA true  COMMA ArrayIntersector1<QuadMiIntersector1Pluecker<4 COMMA true> > >));
 
     IF_ENABLED_QUADS(DEFINE_INTERSECTOR1(BVH4Quad4iMBIntersector1Moeller, BVHNIntersector1<4 COMMA BVH_AN2 COMMA false COMMA ArrayIntersector1<QuadMiMBIntersector1Moeller <4 COMMA true> > >));
+    IF_ENABLED_QUADS(DEFINE_INTERSECTOR1(QBVH4Quad4iMBIntersector1Moeller, BVHNIntersector1<4 COMMA BVH_QN2 COMMA false COMMA ArrayIntersector1<QuadMiMBIntersector1Moeller <4 COMMA true> > >));
     IF_ENABLED_QUADS(DEFINE_INTERSECTOR1(BVH4Quad4iMBIntersector1Pluecker,BVHNIntersector1<4 COMMA BVH_AN2 COMMA true  COMMA ArrayIntersector1<QuadMiMBIntersector1Pluecker<4 COMMA true> > >));
+    IF_ENABLED_QUADS(DEFINE_INTERSECTOR1(QBVH4Quad4iMBIntersector1Pluecker,BVHNIntersector1<4 COMMA BVH_QN2 COMMA true  COMMA ArrayIntersector1<QuadMiMBIntersector1Pluecker<4 COMMA true> > >));
 
     IF_ENABLED_SUBDIV(DEFINE_INTERSECTOR1(BVH4Subdivpatch1Intersector1,BVHNIntersector1<4 COMMA BVH_AN1 COMMA true COMMA SubdivPatch1CachedIntersector1<false>>));
     IF_ENABLED_SUBDIV(DEFINE_INTERSECTOR1(BVH4Subdivpatch1EagerIntersector1,BVHNIntersector1<4 COMMA BVH_AN1 COMMA true COMMA SubdivPatch1EagerIntersector1>));
@@ -311,6 +527,8 @@ namespace embree
     IF_ENABLED_HAIR(DEFINE_INTERSECTOR1(BVH8Bezier1iMBIntersector1_OBB,BVHNIntersector1<8 COMMA BVH_AN2_UN2 COMMA false COMMA ArrayIntersector1<Bezier1iIntersector1MB> >));
     IF_ENABLED_LINES(DEFINE_INTERSECTOR1(BVH8Line4iIntersector1,BVHNIntersector1<8 COMMA BVH_AN1 COMMA false COMMA ArrayIntersector1<LineMiIntersector1<SIMD_MODE(4) COMMA true> > >));
     IF_ENABLED_LINES(DEFINE_INTERSECTOR1(BVH8Line4iMBIntersector1,BVHNIntersector1<8 COMMA BVH_AN2 COMMA false COMMA ArrayIntersector1<LineMiMBIntersector1<SIMD_MODE(4) COMMA true> > >));
+    IF_ENABLED_POINTS(DEFINE_INTERSECTOR1(BVH8Point4vIntersector1,BVHNIntersector1<8 COMMA BVH_AN1 COMMA false COMMA ArrayIntersector1<PointMvIntersector1<4 COMMA true> > >));
+    IF_ENABLED_TRIS(DEFINE_INTERSECTOR1(BVH8TrianglePair4vIntersector1,BVHNIntersector1<8 COMMA BVH_AN1 COMMA false COMMA ArrayIntersector1<TrianglePairMvIntersector1Moeller<4 COMMA true> > >));
 
 #endif
   }
@@ -45,6 +45,18 @@ namespace embree
     public:
       static void intersect(const BVH* This, Ray& ray, IntersectContext* context);
       static void occluded (const BVH* This, Ray& ray, IntersectContext* context);
+
+    private:
+      /* traversal using a stack large enough for any BVH */
+      static void intersectFullStack(const BVH* This, Ray& ray, IntersectContext* context);
+      static void occludedFullStack (const BVH* This, Ray& ray, IntersectContext* context);
+
+      /* traversal using a short stack with restarts, for threads with little stack memory */
+      static void intersectShortStack(const BVH* This, Ray& ray, IntersectContext* context);
+      static void occludedShortStack (const BVH* This, Ray& ray, IntersectContext* context);
+
+      /* tests the leaf that occluded the previous shadow ray of the thread */
+      static bool occludedCached(const BVH* This, Precalculations& pre, Ray& ray, IntersectContext* context);
     };
   }
 }
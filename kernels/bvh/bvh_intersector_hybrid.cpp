@@ -55,11 +55,11 @@ namespace embree
       assert(all(valid,ray.tnear >= 0.0f));
       assert(!(types & BVH_MB) || all(valid,(ray.time >= 0.0f) & (ray.time <= 1.0f)));
 
-      /* if the rays belong to different time segments, immediately switch to single ray traversal */
+      /* if the rays belong to different time segments or temporal splits, immediately switch to single ray traversal */
       Precalculations pre(valid,ray,bvh->numTimeSteps);
       size_t valid_bits = movemask(valid);
       const size_t valid_first = __bsf(valid_bits);
-      if (unlikely((types & BVH_MB) && valid_bits && (movemask(pre.itime() == pre.itime(valid_first)) != valid_bits)))
+      if (unlikely((types & BVH_MB) && valid_bits && (movemask(bvh->getRootIndex(pre) == vint<K>(bvh->getRootIndex(pre)[valid_first])) != valid_bits)))
       {
         intersectSingle(valid, bvh, pre, ray, context);
         AVX_ZERO_UPPER();
@@ -139,6 +139,7 @@ namespace embree
           /* process nodes */
           STAT(const vbool<K> valid_node = ray_tfar > curDist);
           STAT3(normal.trav_nodes,1,popcnt(valid_node),K);
+          COST(CostCounters::nodes(context,popcnt(ray_tfar > curDist)));
           const NodeRef nodeRef = cur;
           const BaseNode* __restrict__ const node = nodeRef.baseNode(types);
 
@@ -266,11 +267,11 @@ namespace embree
       assert(all(valid,ray.tnear >= 0.0f));
       assert(!(types & BVH_MB) || all(valid,(ray.time >= 0.0f) & (ray.time <= 1.0f)));
 
-      /* if the rays belong to different time segments, immediately switch to single ray traversal */
+      /* if the rays belong to different time segments or temporal splits, immediately switch to single ray traversal */
       Precalculations pre(valid,ray,bvh->numTimeSteps);
       size_t valid_bits = movemask(valid);
       const size_t valid_first = __bsf(valid_bits);
-      if (unlikely((types & BVH_MB) && valid_bits && (movemask(pre.itime() == pre.itime(valid_first)) != valid_bits)))
+      if (unlikely((types & BVH_MB) && valid_bits && (movemask(bvh->getRootIndex(pre) == vint<K>(bvh->getRootIndex(pre)[valid_first])) != valid_bits)))
       {
         occludedSingle(valid, bvh, pre, ray, context);
         AVX_ZERO_UPPER();
@@ -348,6 +349,7 @@ namespace embree
           /* process nodes */
           STAT(const vbool<K> valid_node = ray_tfar > curDist);
           STAT3(shadow.trav_nodes,1,popcnt(valid_node),K);
+          COST(CostCounters::nodes(context,popcnt(ray_tfar > curDist)));
           const NodeRef nodeRef = cur;
           const BaseNode* __restrict__ const node = nodeRef.baseNode(types);
 
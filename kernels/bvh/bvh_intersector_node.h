@@ -462,6 +462,131 @@ namespace embree
       return lhit;
     }
     
+    //////////////////////////////////////////////////////////////////////////////////////
+    // fast ray/BVHN::QuantizedNodeMB intersection
+    //////////////////////////////////////////////////////////////////////////////////////
+
+    template<int N>
+      __forceinline size_t intersectNode(const typename BVHN<N>::QuantizedNodeMB* node, const TravRay<N,N>& ray, const vfloat<N>& tnear, const vfloat<N>& tfar, const float time, vfloat<N>& dist)
+    {
+      const vfloat<N> start_x(node->start.x), scale_x(node->scale.x);
+      const vfloat<N> start_y(node->start.y), scale_y(node->scale.y);
+      const vfloat<N> start_z(node->start.z), scale_z(node->scale.z);
+      const vfloat<N> lower_x = madd(node->template dequantize<N>(ray.nearX >> 2,time),scale_x,start_x);
+      const vfloat<N> lower_y = madd(node->template dequantize<N>(ray.nearY >> 2,time),scale_y,start_y);
+      const vfloat<N> lower_z = madd(node->template dequantize<N>(ray.nearZ >> 2,time),scale_z,start_z);
+      const vfloat<N> upper_x = madd(node->template dequantize<N>(ray.farX  >> 2,time),scale_x,start_x);
+      const vfloat<N> upper_y = madd(node->template dequantize<N>(ray.farY  >> 2,time),scale_y,start_y);
+      const vfloat<N> upper_z = madd(node->template dequantize<N>(ray.farZ  >> 2,time),scale_z,start_z);
+#if defined (__AVX2__)
+      const vfloat<N> tNearX = msub(lower_x, ray.rdir.x, ray.org_rdir.x);
+      const vfloat<N> tNearY = msub(lower_y, ray.rdir.y, ray.org_rdir.y);
+      const vfloat<N> tNearZ = msub(lower_z, ray.rdir.z, ray.org_rdir.z);
+      const vfloat<N> tFarX  = msub(upper_x, ray.rdir.x, ray.org_rdir.x);
+      const vfloat<N> tFarY  = msub(upper_y, ray.rdir.y, ray.org_rdir.y);
+      const vfloat<N> tFarZ  = msub(upper_z, ray.rdir.z, ray.org_rdir.z);
+#else
+      const vfloat<N> tNearX = (lower_x - ray.org.x) * ray.rdir.x;
+      const vfloat<N> tNearY = (lower_y - ray.org.y) * ray.rdir.y;
+      const vfloat<N> tNearZ = (lower_z - ray.org.z) * ray.rdir.z;
+      const vfloat<N> tFarX  = (upper_x - ray.org.x) * ray.rdir.x;
+      const vfloat<N> tFarY  = (upper_y - ray.org.y) * ray.rdir.y;
+      const vfloat<N> tFarZ  = (upper_z - ray.org.z) * ray.rdir.z;
+#endif
+      const vfloat<N> tNear = max(tnear,tNearX,tNearY,tNearZ);
+      const vfloat<N> tFar  = min(tfar, tFarX ,tFarY ,tFarZ );
+      const vbool<N> vmask = tNear <= tFar;
+      const size_t mask = movemask(vmask);
+      dist = tNear;
+      return mask;
+    }
+
+    template<int N, int K>
+    __forceinline vbool<K> intersectNode(const typename BVHN<N>::QuantizedNodeMB* node, const size_t i, 
+                                         const Vec3<vfloat<K>>& org, const Vec3<vfloat<K>>& rdir, const Vec3<vfloat<K>>& org_rdir,
+                                         const vfloat<K>& tnear, const vfloat<K>& tfar, const vfloat<K>& time, vfloat<K>& dist)
+    {
+      Vec3<vfloat<K>> vlower, vupper;
+      node->bounds(i,time,vlower,vupper);
+
+#if defined(__AVX2__)
+      const vfloat<K> lclipMinX = msub(vlower.x,rdir.x,org_rdir.x);
+      const vfloat<K> lclipMinY = msub(vlower.y,rdir.y,org_rdir.y);
+      const vfloat<K> lclipMinZ = msub(vlower.z,rdir.z,org_rdir.z);
+      const vfloat<K> lclipMaxX = msub(vupper.x,rdir.x,org_rdir.x);
+      const vfloat<K> lclipMaxY = msub(vupper.y,rdir.y,org_rdir.y);
+      const vfloat<K> lclipMaxZ = msub(vupper.z,rdir.z,org_rdir.z);
+#else
+      const vfloat<K> lclipMinX = (vlower.x - org.x) * rdir.x;
+      const vfloat<K> lclipMinY = (vlower.y - org.y) * rdir.y;
+      const vfloat<K> lclipMinZ = (vlower.z - org.z) * rdir.z;
+      const vfloat<K> lclipMaxX = (vupper.x - org.x) * rdir.x;
+      const vfloat<K> lclipMaxY = (vupper.y - org.y) * rdir.y;
+      const vfloat<K> lclipMaxZ = (vupper.z - org.z) * rdir.z;
+#endif
+
+      const vfloat<K> lnearP = maxi(maxi(mini(lclipMinX, lclipMaxX), mini(lclipMinY, lclipMaxY)), mini(lclipMinZ, lclipMaxZ));
+      const vfloat<K> lfarP  = mini(mini(maxi(lclipMinX, lclipMaxX), maxi(lclipMinY, lclipMaxY)), maxi(lclipMinZ, lclipMaxZ));
+      const vbool<K>  lhit   = maxi(lnearP,tnear) <= mini(lfarP,tfar);
+      dist = lnearP;
+      return lhit;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////////////
+    // robust ray/BVHN::QuantizedNodeMB intersection
+    //////////////////////////////////////////////////////////////////////////////////////
+
+    template<int N>
+      __forceinline size_t intersectNodeRobust(const typename BVHN<N>::QuantizedNodeMB* node, const TravRay<N,N>& ray, const vfloat<N>& tnear, const vfloat<N>& tfar, const float time, vfloat<N>& dist)
+    {
+      const vfloat<N> start_x(node->start.x), scale_x(node->scale.x);
+      const vfloat<N> start_y(node->start.y), scale_y(node->scale.y);
+      const vfloat<N> start_z(node->start.z), scale_z(node->scale.z);
+      const vfloat<N> lower_x = madd(node->template dequantize<N>(ray.nearX >> 2,time),scale_x,start_x);
+      const vfloat<N> lower_y = madd(node->template dequantize<N>(ray.nearY >> 2,time),scale_y,start_y);
+      const vfloat<N> lower_z = madd(node->template dequantize<N>(ray.nearZ >> 2,time),scale_z,start_z);
+      const vfloat<N> upper_x = madd(node->template dequantize<N>(ray.farX  >> 2,time),scale_x,start_x);
+      const vfloat<N> upper_y = madd(node->template dequantize<N>(ray.farY  >> 2,time),scale_y,start_y);
+      const vfloat<N> upper_z = madd(node->template dequantize<N>(ray.farZ  >> 2,time),scale_z,start_z);
+      const vfloat<N> tNearX = (lower_x - ray.org.x) * ray.rdir.x;
+      const vfloat<N> tNearY = (lower_y - ray.org.y) * ray.rdir.y;
+      const vfloat<N> tNearZ = (lower_z - ray.org.z) * ray.rdir.z;
+      const vfloat<N> tFarX  = (upper_x - ray.org.x) * ray.rdir.x;
+      const vfloat<N> tFarY  = (upper_y - ray.org.y) * ray.rdir.y;
+      const vfloat<N> tFarZ  = (upper_z - ray.org.z) * ray.rdir.z;
+      const vfloat<N> tNear = max(tnear,tNearX,tNearY,tNearZ);
+      const vfloat<N> tFar  = min(tfar, tFarX ,tFarY ,tFarZ );
+      const float round_down = 1.0f-2.0f*float(ulp); // FIXME: use per instruction rounding for AVX512
+      const float round_up   = 1.0f+2.0f*float(ulp);
+      const size_t mask = movemask(round_down*tNear <= round_up*tFar);
+      dist = tNear;
+      return mask;
+    }
+
+    template<int N, int K>
+    __forceinline vbool<K> intersectNodeRobust(const typename BVHN<N>::QuantizedNodeMB* node, const size_t i, 
+                                               const Vec3<vfloat<K>>& org, const Vec3<vfloat<K>>& rdir, const Vec3<vfloat<K>>& org_rdir,
+                                               const vfloat<K>& tnear, const vfloat<K>& tfar, const vfloat<K>& time, vfloat<K>& dist)
+    {
+      Vec3<vfloat<K>> vlower, vupper;
+      node->bounds(i,time,vlower,vupper);
+
+      const vfloat<K> lclipMinX = (vlower.x - org.x) * rdir.x;
+      const vfloat<K> lclipMinY = (vlower.y - org.y) * rdir.y;
+      const vfloat<K> lclipMinZ = (vlower.z - org.z) * rdir.z;
+      const vfloat<K> lclipMaxX = (vupper.x - org.x) * rdir.x;
+      const vfloat<K> lclipMaxY = (vupper.y - org.y) * rdir.y;
+      const vfloat<K> lclipMaxZ = (vupper.z - org.z) * rdir.z;
+
+      const vfloat<K> lnearP = maxi(maxi(mini(lclipMinX, lclipMaxX), mini(lclipMinY, lclipMaxY)), mini(lclipMinZ, lclipMaxZ));
+      const vfloat<K> lfarP  = mini(mini(maxi(lclipMinX, lclipMaxX), maxi(lclipMinY, lclipMaxY)), maxi(lclipMinZ, lclipMaxZ));
+      const float round_down = 1.0f-2.0f*float(ulp);
+      const float round_up   = 1.0f+2.0f*float(ulp);
+      const vbool<K>  lhit   = round_down*maxi(lnearP,tnear) <= round_up*mini(lfarP,tfar);
+      dist = lnearP;
+      return lhit;
+    }
+
     //////////////////////////////////////////////////////////////////////////////////////
     // fast ray/BVHN::QuantizedNode intersection
     //////////////////////////////////////////////////////////////////////////////////////
@@ -799,6 +924,26 @@ namespace embree
       }
     };
 
+    template<int N, int Nx>
+      struct BVHNNodeIntersector1<N,Nx,BVH_QN2,false>
+    {
+      static __forceinline bool intersect(const typename BVHN<N>::NodeRef& node, const TravRay<N,Nx>& ray, const vfloat<N>& tnear, const vfloat<N>& tfar, const float time, vfloat<N>& dist, size_t& mask)
+      {
+        mask = intersectNode<N>(node.quantizedNodeMB(),ray,tnear,tfar,time,dist);
+        return true;
+      }
+    };
+
+    template<int N, int Nx>
+      struct BVHNNodeIntersector1<N,Nx,BVH_QN2,true>
+    {
+      static __forceinline bool intersect(const typename BVHN<N>::NodeRef& node, const TravRay<N,Nx>& ray, const vfloat<N>& tnear, const vfloat<N>& tfar, const float time, vfloat<N>& dist, size_t& mask)
+      {
+        mask = intersectNodeRobust<N>(node.quantizedNodeMB(),ray,tnear,tfar,time,dist);
+        return true;
+      }
+    };
+
     /*! Intersects N nodes with K rays */
     template<int N, int K, int types, bool robust>
     struct BVHNNodeIntersectorK;
@@ -846,6 +991,28 @@ namespace embree
         return true;
       }
     };
+
+    template<int N, int K>
+    struct BVHNNodeIntersectorK<N,K,BVH_QN2,false>
+    {
+      static __forceinline bool intersect(const typename BVHN<N>::NodeRef& node, const size_t i, const Vec3<vfloat<K>>& org, const Vec3<vfloat<K>>& rdir, const Vec3<vfloat<K>>& org_rdir,
+                                          const vfloat<K>& tnear, const vfloat<K>& tfar, const vfloat<K>& time, vfloat<K>& dist, vbool<K>& vmask)
+      {
+        vmask = intersectNode<N,K>(node.quantizedNodeMB(),i,org,rdir,org_rdir,tnear,tfar,time,dist);
+        return true;
+      }
+    };
+
+    template<int N, int K>
+    struct BVHNNodeIntersectorK<N,K,BVH_QN2,true>
+    {
+      static __forceinline bool intersect(const typename BVHN<N>::NodeRef& node, const size_t i, const Vec3<vfloat<K>>& org, const Vec3<vfloat<K>>& rdir, const Vec3<vfloat<K>>& org_rdir,
+                                          const vfloat<K>& tnear, const vfloat<K>& tfar, const vfloat<K>& time, vfloat<K>& dist, vbool<K>& vmask)
+      {
+        vmask = intersectNodeRobust<N,K>(node.quantizedNodeMB(),i,org,rdir,org_rdir,tnear,tfar,time,dist);
+        return true;
+      }
+    };
   }
 }
 
@@ -89,6 +89,7 @@ namespace embree
             /*! stop if we found a leaf node */
             if (unlikely(cur.isLeaf())) break;
             STAT3(normal.trav_nodes,1,1,1);
+            COST(CostCounters::nodes(context,1));
 
             /* intersect node */
             size_t mask = 0;
@@ -148,6 +149,7 @@ namespace embree
             /*! stop if we found a leaf node */
             if (unlikely(cur.isLeaf())) break;
             STAT3(shadow.trav_nodes,1,1,1);
+            COST(CostCounters::nodes(context,1));
 
             /* intersect node */
             size_t mask = 0;
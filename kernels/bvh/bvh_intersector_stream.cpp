@@ -30,6 +30,8 @@
 #include "../geometry/bezier1v_intersector.h"
 #include "../geometry/bezier1i_intersector.h"
 #include "../geometry/linei_intersector.h"
+#include "../geometry/pointv_intersector.h"
+#include "../geometry/trianglepairv_intersector.h"
 #include "../geometry/subdivpatch1eager_intersector.h"
 #include "../geometry/subdivpatch1cached_intersector.h"
 #include "../geometry/object_intersector.h"
@@ -139,6 +141,9 @@ namespace embree
       const size_t m_active = initPacketsAndFrusta(inputPackets, numOctantRays, packet, frusta);
       if (unlikely(m_active == 0)) return; 
 
+      /* only packets converted from AOS input are owned by the traversal and may be repacked */
+      const bool compact = context->flags == IntersectContext::INPUT_RAY_DATA_AOS;
+
       stack[0].mask    = m_active;
       stack[0].parent  = 0;
       stack[0].child   = bvh->root;
@@ -188,6 +193,7 @@ namespace embree
         {
           if (unlikely(cur.isLeaf())) break;
           const AlignedNode* __restrict__ const node = cur.alignedNode();
+          COST(CostCounters::nodes(context,__popcnt(m_trav_active)));
 
           __aligned(64) size_t maskK[N];
           for (size_t i = 0; i < N; i++) maskK[i] = m_trav_active;
@@ -209,6 +215,36 @@ namespace embree
         /*! intersect stream of rays with all primitives */
         size_t lazy_node = 0;
         STAT_USER(1,(__popcnt(bits)+K-1)/K*4);
+        const size_t numRays = __popcnt(bits);
+        const size_t numPackets = __popcnt(activePackets(bits));
+
+        /*! repack sparse streams into dense packets, the packets of SOA input are user data and stay in place */
+        if (unlikely(compact && compactRays(numRays,numPackets)))
+        {
+          STAT3(normal.trav_compactions,1,1,1);
+          STAT3(normal.trav_leaf_packets,(numRays+K-1)/K,numRays,(numRays+K-1)/K*K);
+          __aligned(64) RayK<K> compacted[MAX_RAYS/K];
+          size_t rayIDs[MAX_RAYS];
+          gatherRays(inputPackets,bits,compacted,rayIDs);
+
+          for (size_t i=0; i<numRays; i+=K)
+          {
+            RayK<K>& ray = compacted[i/K];
+            const vbool<K> m_valid = (vint<K>(step) < vint<K>(int(numRays-i))) & (ray.tnear <= ray.tfar);
+            PrimitiveIntersector::intersectK(m_valid, ray, context, prim, num, lazy_node);
+            for (size_t k=i; k<min(i+K,numRays); k++)
+            {
+              const size_t j = rayIDs[k];
+              Ray ray1; ray.get(k%K,ray1);
+              inputPackets[j/K]->set(j%K,ray1);
+              float& max_dist = packet[j/K].max_dist[j%K];
+              max_dist = min(max_dist,ray1.tfar);
+            }
+          }
+          continue;
+        }
+
+        STAT3(normal.trav_leaf_packets,numPackets,numRays,numPackets*K);
         do
         {
           size_t i = __bsf(bits) / K;
@@ -218,7 +254,7 @@ namespace embree
 
           vbool<K> m_valid = (inputPackets[i]->tnear <= inputPackets[i]->tfar);
           PrimitiveIntersector::intersectK(m_valid, *inputPackets[i], context, prim, num, lazy_node);
-          Packet &p = packet[i]; 
+          Packet &p = packet[i];
           p.max_dist = min(p.max_dist, inputPackets[i]->tfar);
         } while(bits);
 
@@ -242,6 +278,9 @@ namespace embree
       /* valid rays */
       if (unlikely(m_active == 0)) return; 
 
+      /* only packets converted from AOS input are owned by the traversal and may be repacked */
+      const bool compact = context->flags == IntersectContext::INPUT_RAY_DATA_AOS;
+
       stack[0].mask    = m_active;
       stack[0].parent  = 0;
       stack[0].child   = bvh->root;
@@ -294,6 +333,7 @@ namespace embree
         {
           if (unlikely(cur.isLeaf())) break;
           const AlignedNode* __restrict__ const node = cur.alignedNode();
+          COST(CostCounters::nodes(context,__popcnt(m_trav_active)));
 
           __aligned(64) size_t maskK[N];
           for (size_t i = 0; i < N; i++) maskK[i] = m_trav_active;
@@ -315,6 +355,35 @@ namespace embree
         /*! intersect stream of rays with all primitives */
         size_t lazy_node = 0;
         STAT_USER(1,(__popcnt(bits)+K-1)/K*4);
+        const size_t numRays = __popcnt(bits);
+        const size_t numPackets = __popcnt(activePackets(bits));
+
+        /*! repack sparse streams into dense packets, the packets of SOA input are user data and stay in place */
+        if (unlikely(compact && compactRays(numRays,numPackets)))
+        {
+          STAT3(shadow.trav_compactions,1,1,1);
+          STAT3(shadow.trav_leaf_packets,(numRays+K-1)/K,numRays,(numRays+K-1)/K*K);
+          __aligned(64) RayK<K> compacted[MAX_RAYS/K];
+          size_t rayIDs[MAX_RAYS];
+          gatherRays(inputPackets,bits,compacted,rayIDs);
+
+          for (size_t i=0; i<numRays; i+=K)
+          {
+            RayK<K>& ray = compacted[i/K];
+            const vbool<K> m_valid = (vint<K>(step) < vint<K>(int(numRays-i))) & (ray.tnear <= ray.tfar);
+            size_t m_hit = movemask(m_valid & PrimitiveIntersector::occludedK(m_valid, ray, context, prim, num, lazy_node));
+            while (m_hit)
+            {
+              const size_t j = rayIDs[i+__bscf(m_hit)];
+              inputPackets[j/K]->geomID[j%K] = 0;
+              m_active &= ~((size_t)1 << j);
+            }
+          }
+          if (unlikely(m_active == 0)) break;
+          continue;
+        }
+
+        STAT3(shadow.trav_leaf_packets,numPackets,numRays,numPackets*K);
         while(bits)
         {
           size_t i = __bsf(bits) / K;
@@ -413,6 +482,7 @@ namespace embree
             if (unlikely(cur.isLeaf())) break;
             const AlignedNode* __restrict__ const node = cur.alignedNode();
             assert(m_trav_active);
+            COST(CostCounters::nodes(context,__popcnt(m_trav_active)));
 
 #if defined(__AVX512F__)
             /* AVX512 path for up to 64 rays */
@@ -531,6 +601,7 @@ namespace embree
             assert(m_trav_active);
 
             const AlignedNode* __restrict__ const node = cur.alignedNode();
+            COST(CostCounters::nodes(context,__popcnt(m_trav_active)));
 
 #if defined(__AVX512F__) 
             /* AVX512 path for up to 64 rays */
@@ -624,6 +695,8 @@ namespace embree
 
 
     IF_ENABLED_LINES(DEFINE_INTERSECTORN(BVH4Line4iIntersectorStream,BVHNIntersectorStream<SIMD_MODE(4) COMMA VSIZEX COMMA BVH_AN1 COMMA false COMMA ArrayIntersector1<LineMiIntersector1<SIMD_MODE(4) COMMA true> > >));
+    IF_ENABLED_POINTS(DEFINE_INTERSECTORN(BVH4Point4vIntersectorStream,BVHNIntersectorStream<SIMD_MODE(4) COMMA VSIZEX COMMA BVH_AN1 COMMA false COMMA ArrayIntersector1<PointMvIntersector1<4 COMMA true> > >));
+    IF_ENABLED_TRIS(DEFINE_INTERSECTORN(BVH4TrianglePair4vIntersectorStream,BVHNIntersectorStream<SIMD_MODE(4) COMMA VSIZEX COMMA BVH_AN1 COMMA false COMMA ArrayIntersector1<TrianglePairMvIntersector1Moeller<4 COMMA true> > >));
     
     IF_ENABLED_HAIR(DEFINE_INTERSECTORN(BVH4Bezier1vIntersectorStream,BVHNIntersectorStream<SIMD_MODE(4) COMMA VSIZEX COMMA BVH_AN1 COMMA false COMMA ArrayIntersector1<Bezier1vIntersector1> >));
     IF_ENABLED_HAIR(DEFINE_INTERSECTORN(BVH4Bezier1iIntersectorStream,BVHNIntersectorStream<SIMD_MODE(4) COMMA VSIZEX COMMA BVH_AN1 COMMA false COMMA ArrayIntersector1<Bezier1iIntersector1> >));
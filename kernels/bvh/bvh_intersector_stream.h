@@ -633,12 +633,14 @@ namespace embree
                                                              const size_t m_active)
       {
         assert(m_active);
-        const size_t startPacketID = __bsf(m_active) / K;
-        const size_t endPacketID   = __bsr(m_active) / K;
+        size_t bits = m_active;
         size_t m_trav_active = 0;
-        for (size_t i = startPacketID; i <= endPacketID; i++)
+        /* packets without active rays are skipped */
+        while (bits)
         {
-          //STAT3(normal.trav_nodes,1,1,1);                          
+          //STAT3(normal.trav_nodes,1,1,1);
+          const size_t i = __bsf(bits) / K;
+          bits &= ~((((size_t)1 << K)-1) << (i*K));
           const Packet& p = packet[i];
           const vfloat<K> tminX = msub(minX, p.rdir.x, p.org_rdir.x);
           const vfloat<K> tminY = msub(minY, p.rdir.y, p.org_rdir.y);
@@ -824,6 +826,47 @@ namespace embree
       // =============================================================================================
       // =============================================================================================
 
+      /*! active rays reaching a leaf get repacked into dense packets
+       *  when less than this percentage of the lanes of their packets
+       *  is active */
+      static const size_t compactionOccupancy = 50;
+
+      /*! returns a mask with the first bit of each packet containing active rays set */
+      __forceinline static size_t activePackets(size_t bits)
+      {
+        size_t m_packets = 0;
+        while (bits)
+        {
+          const size_t i = __bsf(bits) / K;
+          const size_t m_packet = (((size_t)1 << K)-1) << (i*K);
+          bits &= ~m_packet;
+          m_packets |= (size_t)1 << (i*K);
+        }
+        return m_packets;
+      }
+
+      /*! returns true if repacking the active rays saves packet intersections */
+      __forceinline static bool compactRays(const size_t numRays, const size_t numPackets) {
+        return (numRays+K-1)/K < numPackets && 100*numRays < compactionOccupancy*numPackets*K;
+      }
+
+      /*! copies the active rays into dense packets, the stream index of each lane is stored in rayIDs */
+      __forceinline static size_t gatherRays(RayK<K>** inputPackets, size_t bits, RayK<K>* compacted, size_t* rayIDs)
+      {
+        size_t numRays = 0;
+        while (bits)
+        {
+          const size_t j = __bscf(bits);
+          Ray ray; inputPackets[j/K]->get(j%K,ray);
+          compacted[numRays/K].set(numRays%K,ray);
+          rayIDs[numRays++] = j;
+        }
+        /* unused lanes of the last packet duplicate its last ray */
+        for (size_t i=numRays; i%K; i++)
+          compacted[numRays/K].copy(i%K,(numRays-1)%K);
+        return numRays;
+      }
+
       static const size_t stackSizeChunk  = N*BVH::maxDepth+1;
       static const size_t stackSizeSingle = 1+(N-1)*BVH::maxDepth;
 
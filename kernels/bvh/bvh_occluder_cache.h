@@ -0,0 +1,70 @@
+// ======================================================================== //
+// Copyright 2009-2016 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#pragma once
+
+#include "../common/default.h"
+
+namespace embree
+{
+  /*! Small per-thread cache of the BVH leaves that occluded the most
+   *  recent shadow rays. Shadow rays of the same pixel or light
+   *  frequently hit the same occluder, thus testing the cached leaf
+   *  first often avoids the traversal altogether. Entries are tagged
+   *  with the BVH and its build generation, so leaves of rebuilt or
+   *  deleted BVHs are never accessed. */
+  struct OccluderCache
+  {
+    enum { SIZE = 8 };
+
+    struct Entry
+    {
+      const void* bvh;    //!< BVH the leaf belongs to
+      size_t generation;  //!< build generation of the BVH
+      size_t leaf;        //!< leaf node that occluded the last ray
+    };
+
+    /*! returns a unique generation for each newly built BVH */
+    static __forceinline size_t nextGeneration() {
+      return ++generationCounter;
+    }
+
+    /*! returns the cached leaf of the BVH or 0 if there is none */
+    static __forceinline size_t lookup(const void* bvh, size_t generation)
+    {
+      const Entry& entry = entries[slot(bvh)];
+      if (entry.bvh != bvh || entry.generation != generation) return 0;
+      return entry.leaf;
+    }
+
+    /*! remembers the leaf that occluded a ray */
+    static __forceinline void store(const void* bvh, size_t generation, size_t leaf)
+    {
+      Entry& entry = entries[slot(bvh)];
+      entry.bvh = bvh;
+      entry.generation = generation;
+      entry.leaf = leaf;
+    }
+
+  private:
+    static __forceinline size_t slot(const void* bvh) {
+      return (size_t(bvh) >> 6) % SIZE;
+    }
+
+    static std::atomic<size_t> generationCounter;
+    static __thread Entry entries[SIZE];
+  };
+}
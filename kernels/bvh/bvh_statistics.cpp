@@ -24,10 +24,13 @@ namespace embree
     double A = max(0.0f,halfArea(bvh->getBounds()));
     if (bvh->msmblur) 
     {
+      /* consecutive root slots may share the BVH of a temporal split */
       NodeRef* roots = (NodeRef*)(size_t)bvh->root;
-      for (size_t i=0; i<bvh->numTimeSteps-1; i++) {
-        const BBox1f t0t1(float(i+0)/float(bvh->numTimeSteps-1),
-                        float(i+1)/float(bvh->numTimeSteps-1));
+      const size_t numSlots = (bvh->numTimeSteps-1)*bvh->numTimeSplits;
+      for (size_t i=0, j=1; i<numSlots; i=j, j=i+1) {
+        while (j < numSlots && roots[j] == roots[i] && j%bvh->numTimeSplits) j++;
+        const BBox1f t0t1(float(i)/float(numSlots),
+                          float(j)/float(numSlots));
         stat = stat + statistics(roots[i],A,t0t1);
       }
     }
@@ -54,6 +57,7 @@ namespace embree
     if (stat.statUnalignedNodesMB.numNodes) stream << "  unaligneddNodesMB: "  << stat.statUnalignedNodesMB.toString(bvh,totalSAH,totalBytes) << std::endl;
     if (stat.statTransformNodes.numNodes  ) stream << "  transformNodes   : "  << stat.statTransformNodes.toString(bvh,totalSAH,totalBytes) << std::endl;
     if (stat.statQuantizedNodes.numNodes  ) stream << "  quantizedNodes   : "  << stat.statQuantizedNodes.toString(bvh,totalSAH,totalBytes) << std::endl;
+    if (stat.statQuantizedNodesMB.numNodes) stream << "  quantizedNodesMB : "  << stat.statQuantizedNodesMB.toString(bvh,totalSAH,totalBytes) << std::endl;
     if (true)                               stream << "  leaves           : "  << stat.statLeaf.toString(bvh,totalSAH,totalBytes) << std::endl;
     if (true)                               stream << "    histogram      : "  << stat.statLeaf.histToString() << std::endl;
     return stream.str();
@@ -135,6 +139,19 @@ namespace embree
       s.statQuantizedNodes.nodeSAH += dt*A;
       s.depth++;
     }
+    else if (node.isQuantizedNodeMB())
+    {
+      QuantizedNodeMB* n = node.quantizedNodeMB();
+      for (size_t i=0; i<N; i++) {
+        if (n->child(i) == BVH::emptyNode) continue;
+        s.statQuantizedNodesMB.numChildren++;
+        const double Ai = max(0.0f,halfArea(n->extend0(i)));
+        s = s + statistics(n->child(i),Ai,t0t1);
+      }
+      s.statQuantizedNodesMB.numNodes++;
+      s.statQuantizedNodesMB.nodeSAH += dt*A;
+      s.depth++;
+    }
     else if (node.isLeaf())
     {
       size_t num; const char* tri = node.leaf(num);
@@ -289,6 +289,7 @@ namespace embree
 #endif          
           leafType = node->type;
           context->geomID_to_instID = &node->instID;
+          COST(CostCounters::nodes(context,1));
 
 #if ENABLE_TRANSFORM_CACHE
           const vboolx xfm_hit = cacheTag == vintx(node->xfmID);
@@ -351,6 +352,7 @@ namespace embree
 #endif
           leafType = node->type;
           context->geomID_to_instID = &node->instID;
+          COST(CostCounters::nodes(context,1));
 
 #if ENABLE_TRANSFORM_CACHE
           const vboolx xfm_hit = cacheTag == vintx(node->xfmID);
@@ -444,5 +446,201 @@ namespace embree
     public:
       __forceinline explicit BVHNNodeTraverser1(const TravRay<N,Nx>& vray) : BVHNNodeTraverser1Transform<N, Nx, types, (bool)(types & BVH_FLAG_TRANSFORM_NODE)>(vray) {}
     };
+
+    /*! BVH node traversal for single rays using a short stack of
+     *  fixed size. When the stack overflows the oldest entries get
+     *  dropped. The restart trail stores for each level of the current
+     *  path which of the hit children (in traversal order) is
+     *  traversed, which allows to recover the dropped nodes by
+     *  restarting from the root without visiting any subtree twice. As
+     *  the ray distance only shrinks, children culled during a restart
+     *  always come last in traversal order, thus the trail stays
+     *  valid. Transformation nodes are not supported. */
+    template<int N, int Nx, int types, bool closest>
+      class BVHNShortStackTraverser1
+    {
+      typedef BVHN<N> BVH;
+      typedef typename BVH::NodeRef NodeRef;
+      typedef typename BVH::BaseNode BaseNode;
+
+      /*! number of stack entries, has to be a power of two */
+      static const size_t stackSize = 32;
+
+      struct StackItem
+      {
+        NodeRef ptr;          //!< node to traverse
+        float dist;           //!< distance of the ray to the node
+        unsigned short depth; //!< depth of the node
+        unsigned short rank;  //!< traversal order of the node among the hit children of its parent
+      };
+
+    public:
+
+      /*! the traversal starts by popping the root node */
+      __forceinline explicit BVHNShortStackTraverser1(NodeRef root)
+        : root(root), lazyDepth(0), depth(size_t(-1)), top(0), bottom(0), dropDepth(0)
+      {
+        push(root,neg_inf,0);
+      }
+
+      /*! continues with the first hit child and pushes the other hit children */
+      __forceinline void traverse(NodeRef& cur, size_t mask, const vfloat<Nx>& tNear)
+      {
+        assert(mask != 0);
+        const BaseNode* node = cur.baseNode(types);
+
+        /*! one child is hit, continue with that child */
+        size_t r0 = __bscf(mask);
+        if (likely(mask == 0))
+          cur = node->child(r0);
+
+        else
+        {
+          /*! two children are hit, push far child, and continue with closer child */
+          size_t r1 = __bscf(mask);
+          if (likely(mask == 0))
+          {
+            if (closest && tNear[r1] < tNear[r0]) std::swap(r0,r1);
+            push(node->child(r1),tNear[r1],1);
+            cur = node->child(r0);
+          }
+
+          /*! more children are hit, sort them into traversal order */
+          else
+          {
+            unsigned char children[N];
+            const size_t num = order(mask | ((size_t)1 << r0) | ((size_t)1 << r1),tNear,children);
+            for (size_t r=num-1; r>0; r--)
+              push(node->child(children[r]),tNear[children[r]],r);
+            cur = node->child(children[0]);
+          }
+        }
+
+        assert(depth < BVH::maxDepth);
+        trail[++depth] = 0;
+        cur.prefetch(types);
+      }
+
+      /*! pushes the root of a lazily built subtree of the current leaf */
+      __forceinline void pushLazy(NodeRef lazyNode)
+      {
+        assert(depth < BVH::maxDepth);
+        lazyRoot = lazyNode;
+        lazyDepth = depth+1;
+        push(lazyNode,neg_inf,0);
+      }
+
+      /*! pops the next node closer than tfar, returns false when the
+       *  traversal is finished, nodes get intersected using the
+       *  intersectNode function when the traversal restarts */
+      template<typename NodeIntersector>
+      __forceinline bool pop(NodeRef& cur, const float tfar, const NodeIntersector& intersectNode)
+      {
+        while (true)
+        {
+          if (unlikely(top == bottom))
+          {
+            if (likely(dropDepth == 0)) return false;
+            restart(intersectNode);
+            continue;
+          }
+
+          const StackItem& item = stack[--top & (stackSize-1)];
+          if (unlikely(item.dist > tfar)) continue;
+          depth = item.depth;
+          trail[depth] = (unsigned char) item.rank;
+          cur = item.ptr;
+          return true;
+        }
+      }
+
+    private:
+
+      /*! sorts the indices of the hit children into traversal order,
+       *  closest hit traversal orders by distance and breaks ties by
+       *  child index, any hit traversal orders by child index only */
+      static __forceinline size_t order(size_t mask, const vfloat<Nx>& tNear, unsigned char* children)
+      {
+        size_t num = 0;
+        for (; mask; num++)
+        {
+          const size_t i = __bscf(mask);
+          size_t j = num;
+          if (closest) {
+            for (; j>0 && tNear[i] < tNear[children[j-1]]; j--)
+              children[j] = children[j-1];
+          }
+          children[j] = (unsigned char) i;
+        }
+        return num;
+      }
+
+      /*! pushes a child of the current node, the oldest entry gets dropped if the stack is full */
+      __forceinline void push(NodeRef node, const float dist, const size_t rank)
+      {
+        if (unlikely(top-bottom == stackSize)) {
+          dropDepth = max(dropDepth,(size_t)stack[bottom & (stackSize-1)].depth);
+          bottom++;
+        }
+        StackItem& item = stack[top++ & (stackSize-1)];
+        item.ptr = node;
+        item.dist = dist;
+        item.depth = (unsigned short) (depth+1);
+        item.rank = (unsigned short) rank;
+      }
+
+      /*! walks the trail from the root down to the deepest dropped
+       *  node and pushes all hit children not traversed yet. As nodes
+       *  are pushed in depth order, the dropped nodes are the
+       *  shallowest ones and the current path passes through their
+       *  parents. */
+      template<typename NodeIntersector>
+      __noinline void restart(const NodeIntersector& intersectNode)
+      {
+        if (closest) { STAT3(normal.trav_restarts,1,1,1); }
+        else         { STAT3(shadow.trav_restarts,1,1,1); }
+
+        assert(dropDepth <= depth);
+        const size_t pathDepth = dropDepth;
+        dropDepth = 0;
+        NodeRef cur = root;
+        for (depth=0; depth<pathDepth; depth++)
+        {
+          const size_t rank = trail[depth+1];
+
+          /* leaves only occur on the path when they have a lazy subtree */
+          if (unlikely(cur.isLeaf())) {
+            assert(lazyDepth == depth+1 && rank == 0);
+            cur = lazyRoot;
+            continue;
+          }
+
+          size_t mask = 0;
+          vfloat<Nx> tNear;
+          intersectNode(cur,tNear,mask);
+          unsigned char children[N];
+          const size_t num = order(mask,tNear,children);
+
+          /* the path and all later children got culled */
+          if (rank >= num) break;
+
+          const BaseNode* node = cur.baseNode(types);
+          for (size_t r=num-1; r>rank; r--)
+            push(node->child(children[r]),tNear[children[r]],r);
+          cur = node->child(children[rank]);
+        }
+      }
+
+    private:
+      NodeRef root;                          //!< root node to restart from
+      NodeRef lazyRoot;                      //!< root of the lazily built subtree on the current path
+      size_t lazyDepth;                      //!< depth of the lazily built subtree root
+      size_t depth;                          //!< depth of the current node
+      size_t top;                            //!< number of pushed entries
+      size_t bottom;                         //!< number of dropped entries
+      size_t dropDepth;                      //!< maximal depth of the nodes dropped since the last restart
+      StackItem stack[stackSize];            //!< ring buffer of pending nodes
+      unsigned char trail[BVH::maxDepth+1];  //!< traversal order of the node at each depth of the current path
+    };
   }
 }
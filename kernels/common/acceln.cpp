@@ -22,7 +22,7 @@
 namespace embree
 {
   AccelN::AccelN () 
-    : Accel(AccelData::TY_ACCELN), accels(nullptr), validAccels(nullptr), validIntersectorN(false) {}
+    : Accel(AccelData::TY_ACCELN), accels(nullptr), validAccels(nullptr), validBounds(empty), validIntersectorN(false) {}
 
   AccelN::~AccelN() 
   {
@@ -39,32 +39,94 @@ namespace embree
     accels.push_back(accel);
   }
   
+  /*! calculates the entry distance of a ray into the bounds of some acceleration structure, returns false if the bounds are missed */
+  __forceinline bool intersectBounds(const BBox3fa& bounds, const Vec3fa& org, const Vec3fa& rdir, const float tnear, const float tfar, float& dist)
+  {
+    const Vec3fa t0 = (bounds.lower-org)*rdir;
+    const Vec3fa t1 = (bounds.upper-org)*rdir;
+    const float tNear = max(reduce_max(min(t0,t1)),tnear);
+    const float tFar  = min(reduce_min(max(t0,t1)),tfar);
+    /* enlarge the interval slightly to never cull a hit due to rounding */
+    dist = tNear - 4.0f*float(ulp)*abs(tNear);
+    return dist <= tFar + 4.0f*float(ulp)*abs(tFar);
+  }
+
+  /*! sorts the acceleration structures hit by the ray by their entry distance */
+  __forceinline size_t sortAccels(AccelN* This, const Vec3fa& org, const Vec3fa& dir, const float tnear, const float tfar, float* dist, size_t* order)
+  {
+    const Vec3fa rdir = Vec3fa(one)/zero_fix(dir);
+    size_t num = 0;
+    for (size_t i=0; i<This->validAccels.size(); i++)
+    {
+      float d; 
+      if (!intersectBounds(This->validBounds[i],org,rdir,tnear,tfar,d)) continue;
+      size_t j = num++;
+      for (; j>0 && dist[j-1] > d; j--) {
+        dist[j] = dist[j-1]; order[j] = order[j-1];
+      }
+      dist[j] = d; order[j] = i;
+    }
+    return num;
+  }
+
+  /*! calculates the valid mask of all rays of the packet that hit the bounds of the i'th acceleration structure */
+  template<int K, typename RTCRayK>
+  __forceinline bool intersectBoundsK(AccelN* This, const size_t i, const int* valid, const RTCRayK& ray, int* valid_o)
+  {
+    bool any = false;
+    for (size_t k=0; k<K; k++)
+    {
+      valid_o[k] = 0;
+      if (valid[k] == 0) continue;
+      const Vec3fa org(ray.orgx[k],ray.orgy[k],ray.orgz[k]);
+      const Vec3fa dir(ray.dirx[k],ray.diry[k],ray.dirz[k]);
+      float d;
+      if (!intersectBounds(This->validBounds[i],org,Vec3fa(one)/zero_fix(dir),ray.tnear[k],ray.tfar[k],d)) continue;
+      valid_o[k] = -1; any = true;
+    }
+    return any;
+  }
+  
   void AccelN::intersect (void* ptr, RTCRay& ray, IntersectContext* context) 
   {
     AccelN* This = (AccelN*)ptr;
-    for (size_t i=0; i<This->validAccels.size(); i++)
-      This->validAccels[i]->intersect(ray,context);
+    float dist[16]; size_t order[16];
+    const Vec3fa org(ray.org[0],ray.org[1],ray.org[2]);
+    const Vec3fa dir(ray.dir[0],ray.dir[1],ray.dir[2]);
+    const size_t num = sortAccels(This,org,dir,ray.tnear,ray.tfar,dist,order);
+
+    /* traverse acceleration structures front to back and skip the ones behind the closest hit */
+    for (size_t i=0; i<num; i++) {
+      if (dist[i] > ray.tfar) break;
+      This->validAccels[order[i]]->intersect(ray,context);
+    }
   }
 
   void AccelN::intersect4 (const void* valid, void* ptr, RTCRay4& ray, IntersectContext* context) 
   {
     AccelN* This = (AccelN*)ptr;
+    __aligned(16) int valid_i[4];
     for (size_t i=0; i<This->validAccels.size(); i++)
-      This->validAccels[i]->intersect4(valid,ray,context);
+      if (intersectBoundsK<4>(This,i,(const int*)valid,ray,valid_i))
+        This->validAccels[i]->intersect4(valid_i,ray,context);
   }
 
   void AccelN::intersect8 (const void* valid, void* ptr, RTCRay8& ray, IntersectContext* context) 
   {
     AccelN* This = (AccelN*)ptr;
+    __aligned(32) int valid_i[8];
     for (size_t i=0; i<This->validAccels.size(); i++)
-      This->validAccels[i]->intersect8(valid,ray,context);
+      if (intersectBoundsK<8>(This,i,(const int*)valid,ray,valid_i))
+        This->validAccels[i]->intersect8(valid_i,ray,context);
   }
 
   void AccelN::intersect16 (const void* valid, void* ptr, RTCRay16& ray, IntersectContext* context) 
   {
     AccelN* This = (AccelN*)ptr;
+    __aligned(64) int valid_i[16];
     for (size_t i=0; i<This->validAccels.size(); i++)
-      This->validAccels[i]->intersect16(valid,ray,context);
+      if (intersectBoundsK<16>(This,i,(const int*)valid,ray,valid_i))
+        This->validAccels[i]->intersect16(valid_i,ray,context);
   }
 
   void AccelN::intersectN (void* ptr, RTCRay** ray, const size_t N, IntersectContext* context)
@@ -77,8 +139,13 @@ namespace embree
   void AccelN::occluded (void* ptr, RTCRay& ray, IntersectContext* context) 
   {
     AccelN* This = (AccelN*)ptr;
-    for (size_t i=0; i<This->validAccels.size(); i++) {
-      This->validAccels[i]->occluded(ray,context); 
+    float dist[16]; size_t order[16];
+    const Vec3fa org(ray.org[0],ray.org[1],ray.org[2]);
+    const Vec3fa dir(ray.dir[0],ray.dir[1],ray.dir[2]);
+    const size_t num = sortAccels(This,org,dir,ray.tnear,ray.tfar,dist,order);
+
+    for (size_t i=0; i<num; i++) {
+      This->validAccels[order[i]]->occluded(ray,context); 
       if (ray.geomID == 0) break;
     }
   }
@@ -86,8 +153,10 @@ namespace embree
   void AccelN::occluded4 (const void* valid, void* ptr, RTCRay4& ray, IntersectContext* context) 
   {
     AccelN* This = (AccelN*)ptr;
+    __aligned(16) int valid_i[4];
     for (size_t i=0; i<This->validAccels.size(); i++) {
-      This->validAccels[i]->occluded4(valid,ray,context);
+      if (!intersectBoundsK<4>(This,i,(const int*)valid,ray,valid_i)) continue;
+      This->validAccels[i]->occluded4(valid_i,ray,context);
 #if defined(__SSE2__)
       vbool4 valid0 = ((vbool4*)valid)[0];
       vbool4 hit0   = ((vint4*)ray.geomID)[0] == vint4(0);
@@ -99,8 +168,10 @@ namespace embree
   void AccelN::occluded8 (const void* valid, void* ptr, RTCRay8& ray, IntersectContext* context) 
   {
     AccelN* This = (AccelN*)ptr;
+    __aligned(32) int valid_i[8];
     for (size_t i=0; i<This->validAccels.size(); i++) {
-      This->validAccels[i]->occluded8(valid,ray,context);
+      if (!intersectBoundsK<8>(This,i,(const int*)valid,ray,valid_i)) continue;
+      This->validAccels[i]->occluded8(valid_i,ray,context);
 #if defined(__SSE2__)
       vbool4 valid0 = ((vbool4*)valid)[0];
       vbool4 hit0   = ((vint4*)ray.geomID)[0] == vint4(0);
@@ -114,8 +185,10 @@ namespace embree
   void AccelN::occluded16 (const void* valid, void* ptr, RTCRay16& ray, IntersectContext* context) 
   {
     AccelN* This = (AccelN*)ptr;
+    __aligned(64) int valid_i[16];
     for (size_t i=0; i<This->validAccels.size(); i++) {
-      This->validAccels[i]->occluded16(valid,ray,context);
+      if (!intersectBoundsK<16>(This,i,(const int*)valid,ray,valid_i)) continue;
+      This->validAccels[i]->occluded16(valid_i,ray,context);
 #if defined(__AVX512F__) // FIXME: this code gets never compiler with __AVX512F__ enabled
       vbool16 valid0 = ((vbool16*)valid)[0];
       vbool16 hit0   = ((vint16*)ray.geomID)[0] == vint16(0);
@@ -161,12 +234,28 @@ namespace embree
         accels[i]->build(threadIndex,threadCount);
       });
 
+    updateValidAccels();
+  }
+
+  void AccelN::build_sequential () 
+  {
+    /* build all acceleration structures on the calling thread */
+    for (size_t i=0; i<accels.size(); i++)
+      accels[i]->build(0,0);
+
+    updateValidAccels();
+  }
+
+  void AccelN::updateValidAccels ()
+  {
     /* create list of non-empty acceleration structures */
     validAccels.clear();
+    validBounds.clear();
     validIntersectorN = true;
     for (size_t i=0; i<accels.size(); i++) {
       if (accels[i]->bounds.empty()) continue;
       validAccels.push_back(accels[i]);
+      validBounds.push_back(accels[i]->getBounds());
       if (!accels[i]->intersectors.intersectorN) validIntersectorN = false;
     }
 
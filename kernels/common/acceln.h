@@ -20,7 +20,9 @@
 
 namespace embree
 {
-  /*! merges N acceleration structures together, by processing them in order */
+  /*! merges N acceleration structures together, the bounds of the
+   *  acceleration structures act as a shared top level that culls
+   *  structures missed by a ray and traverses them front to back */
   class AccelN : public Accel
   {
   public:
@@ -48,14 +50,19 @@ namespace embree
     void print(size_t ident);
     void immutable();
     void build (size_t threadIndex, size_t threadCount);
+    void build_sequential ();
     void select(bool filter4, bool filter8, bool filter16, bool filterN);
     void deleteGeometry(size_t geomID);
     void clear ();
     __forceinline bool validIsecN() { return validIntersectorN; }
 
+  private:
+    void updateValidAccels ();
+
   public:
     darray_t<Accel*,16> accels;
     darray_t<Accel*,16> validAccels;
+    darray_t<BBox3fa,16> validBounds; //!< merged bounds over time of all valid acceleration structures
     bool validIntersectorN;
   };
 }
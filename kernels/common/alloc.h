@@ -239,6 +239,20 @@ namespace embree
       if (MAX_THREAD_USED_BLOCK_SLOTS >= 8 && bytesAllocate > 16*maxAllocationSize) slotMask = 0x7;
     }
 
+    /*! initializes the allocator with a single block of exactly the
+     *  specified size, used by builds that allocate only once */
+    void init_exact(size_t bytes) 
+    {
+      internal_fix_used_blocks();
+      if (usedBlocks.load() || freeBlocks.load()) { reset(); return; }
+      freeBlocks = Block::create_exact(device,bytes);
+      use_single_mode = false;
+      defaultBlockSize = clamp(bytes/4,size_t(128),size_t(PAGE_SIZE));
+      growSize = PAGE_SIZE;
+      log2_grow_size_scale = 0;
+      slotMask = 0x0;
+    }
+
     /*! frees state not required after build */
     __forceinline void cleanup() 
     {
@@ -463,8 +477,19 @@ namespace embree
         return (Block*) ptr;
       }
 
-      Block (size_t bytesAllocate, size_t bytesReserve, Block* next) 
-      : cur(0), allocEnd(bytesAllocate), reserveEnd(bytesReserve), next(next) 
+      /*! creates a block on the heap that does not get rounded to full pages */
+      static Block* create_exact(MemoryMonitorInterface* device, size_t bytes, Block* next = nullptr)
+      {
+        const size_t sizeof_Header = offsetof(Block,data[0]);
+        bytes = (bytes+maxAlignment-1) & ~(maxAlignment-1);
+        if (device) device->memoryMonitor(sizeof_Header+bytes,false);
+        void* ptr = alignedMalloc(sizeof_Header+bytes,maxAlignment);
+        new (ptr) Block(bytes,bytes,next,true);
+        return (Block*) ptr;
+      }
+
+      Block (size_t bytesAllocate, size_t bytesReserve, Block* next, bool heap = false) 
+      : cur(0), allocEnd(bytesAllocate), reserveEnd(bytesReserve), next(next), heap(heap) 
       {
         //for (size_t i=0; i<allocEnd; i+=defaultBlockSize) data[i] = 0;
       }
@@ -474,7 +499,8 @@ namespace embree
         const size_t sizeof_Header = offsetof(Block,data[0]);
         size_t sizeof_This = sizeof_Header+reserveEnd;
         const ssize_t sizeof_Alloced = sizeof_Header+getBlockAllocatedBytes();
-        os_free(this,sizeof_This);
+        if (heap) alignedFree(this);
+        else      os_free(this,sizeof_This);
         if (device) device->memoryMonitor(-sizeof_Alloced,true);
       }
       
@@ -509,6 +535,10 @@ namespace embree
 
       void shrink (MemoryMonitorInterface* device) 
       {
+        if (heap) {
+          if (next) next->shrink(device);
+          return;
+        }
         const size_t sizeof_Header = offsetof(Block,data[0]);
         size_t newSize = os_shrink(this,sizeof_Header+getBlockUsedBytes(),reserveEnd+sizeof_Header);
         if (device) device->memoryMonitor(newSize-sizeof_Header-allocEnd,true);
@@ -558,7 +588,8 @@ namespace embree
       std::atomic<size_t> allocEnd;   //!< end of the allocated memory region
       std::atomic<size_t> reserveEnd; //!< end of the reserved memory region
       Block* next;               //!< pointer to next block in list
-      char align[maxAlignment-4*sizeof(size_t)]; //!< align data to maxAlignment
+      bool heap;                 //!< block got allocated on the heap instead of by the OS
+      char align[maxAlignment-4*sizeof(size_t)-sizeof(bool)]; //!< align data to maxAlignment
       char data[1];              //!< here starts memory to use for allocations
     };
 
@@ -502,6 +502,18 @@ namespace embree
     case RTC_CONFIG_USER_GEOMETRY: return 0;
 #endif
 
+#if defined(EMBREE_GEOMETRY_POINTS)
+    case RTC_CONFIG_POINT_GEOMETRY: return 1;
+#else
+    case RTC_CONFIG_POINT_GEOMETRY: return 0;
+#endif
+
+#if defined(EMBREE_COST_COUNTERS)
+    case RTC_CONFIG_COST_COUNTERS: return 1;
+#else
+    case RTC_CONFIG_COST_COUNTERS: return 0;
+#endif
+
     default: throw_RTCError(RTC_INVALID_ARGUMENT, "unknown readable parameter"); break;
     };
   }
@@ -29,7 +29,7 @@ namespace embree
   public:
 
     /*! type of geometry */
-    enum Type { TRIANGLE_MESH = 1, USER_GEOMETRY = 2, BEZIER_CURVES = 4, SUBDIV_MESH = 8, INSTANCE = 16, QUAD_MESH = 32, LINE_SEGMENTS = 64 };
+    enum Type { TRIANGLE_MESH = 1, USER_GEOMETRY = 2, BEZIER_CURVES = 4, SUBDIV_MESH = 8, INSTANCE = 16, QUAD_MESH = 32, LINE_SEGMENTS = 64, POINTS = 128 };
 
   public:
     
@@ -209,6 +209,9 @@ namespace embree
       throw_RTCError(RTC_INVALID_OPERATION,"operation not supported for this geometry"); 
     }
 
+    /*! Returns the instanced scene of scene instances */
+    virtual Scene* getInstancedScene() const { return nullptr; }
+
     /*! for user geometries only */
   public:
 
@@ -301,6 +304,31 @@ namespace embree
     template<typename simd> __forceinline bool hasISPCIntersectionFilter() const;
     template<typename simd> __forceinline bool hasISPCOcclusionFilter() const;
 
+    /*! Sets opacity mask that is looked up before invoking filter functions. */
+    void setOpacityMask (const void* mask, unsigned level);
+
+    __forceinline bool hasOpacityMask() const { return opacityMask != nullptr; }
+
+    /*! returns opacity state of the sub-triangle (or sub-quad for quad meshes) that contains the hit location */
+    __forceinline RTCOpacityState getOpacityState(unsigned primID, float u, float v) const
+    {
+      const int N = 1 << opacityMaskLevel;
+      const float fu = u*float(N), fv = v*float(N);
+      int iu = clamp(int(fu),0,N-1);
+      int iv = clamp(int(fv),0,N-1);
+      size_t index;
+      if (type == QUAD_MESH) 
+        index = iv*N+iu;
+      else {
+        iu = min(iu,N-1-iv);
+        const bool flip = (fu-float(iu)) + (fv-float(iv)) >= 1.0f && iu+iv < N-1;
+        index = iv*(2*N-iv) + 2*iu + flip;
+      }
+      const unsigned char* prim = opacityMask + size_t(primID)*opacityMaskBytes;
+      const unsigned state = (prim[index>>2] >> (2*(index&3))) & 3;
+      return state < RTC_OPACITY_UNKNOWN ? (RTCOpacityState) state : RTC_OPACITY_UNKNOWN;
+    }
+
   public:
 
     /*! calculates the linear bounds of a primitive at the itimeGlobal'th time segment */
@@ -424,6 +452,25 @@ namespace embree
       return true;
     }
 
+    /*! gathers 4 vertices into SOA layout, returns which of them have finite coordinates */
+    template<typename VertexPtr>
+    __forceinline static vbool4 gatherVertices4(const VertexPtr& vertexPtr, const vint4& index, Vec3vf4& v, vfloat4& w)
+    {
+      const vfloat4 v0 = vfloat4::loadu((const float*)vertexPtr(index[0]));
+      const vfloat4 v1 = vfloat4::loadu((const float*)vertexPtr(index[1]));
+      const vfloat4 v2 = vfloat4::loadu((const float*)vertexPtr(index[2]));
+      const vfloat4 v3 = vfloat4::loadu((const float*)vertexPtr(index[3]));
+      transpose(v0,v1,v2,v3,v.x,v.y,v.z,w);
+      const vfloat4 lower(-FLT_LARGE), upper(+FLT_LARGE);
+      return (v.x > lower) & (v.x < upper) & (v.y > lower) & (v.y < upper) & (v.z > lower) & (v.z < upper);
+    }
+
+    template<typename VertexPtr>
+    __forceinline static vbool4 gatherVertices4(const VertexPtr& vertexPtr, const vint4& index, Vec3vf4& v)
+    {
+      vfloat4 w; return gatherVertices4(vertexPtr,index,v,w);
+    }
+
     /*! checks if a primitive is valid at the itimeGlobal'th time segment */
     template<typename ValidFunc>
     __forceinline static bool validLinearBounds(const ValidFunc& valid, size_t itimeGlobal, size_t numTimeStepsGlobal, size_t numTimeSteps)
@@ -493,6 +540,11 @@ namespace embree
     int hasOcclusionFilterMask;
     int ispcIntersectionFilterMask;
     int ispcOcclusionFilterMask;
+
+  public:
+    const unsigned char* opacityMask; //!< 2 bit opacity state per sub-triangle of each primitive
+    unsigned opacityMaskLevel;        //!< number of subdivisions of each primitive for the opacity mask
+    unsigned opacityMaskBytes;        //!< bytes of opacity mask per primitive
   };
 
 #if defined(__SSE__)
@@ -107,6 +107,92 @@ namespace embree
     Vec3fa upper;     //!< upper bounds and primID
   };
 
+  /*! A compact 16 byte primitive reference that stores the bounds of
+   *  the primitive quantized to a 10 bit grid together with its
+   *  IDs. The bounds and centroids returned are in grid space. */
+  struct __aligned(16) PrimRefCompact
+  {
+    static const unsigned int GRID_BITS = 10;
+    static const unsigned int GRID_SIZE = 1 << GRID_BITS;
+    static const unsigned int GRID_MASK = GRID_SIZE-1;
+
+    /*! isotropic mapping of some bounds to the quantization grid */
+    struct Grid
+    {
+      __forceinline Grid () {}
+
+      __forceinline Grid (const BBox3fa& bounds)
+      {
+        const float extent = reduce_max(bounds.size());
+        ofs = bounds.lower;
+        scale = extent > 0.0f ? float(GRID_MASK)/extent : 0.0f;
+      }
+
+    public:
+      Vec3fa ofs;
+      float scale;
+    };
+
+    __forceinline PrimRefCompact () {}
+
+    /*! quantizes a primitive reference, lower bounds are rounded down and upper bounds up */
+    __forceinline PrimRefCompact (const PrimRef& prim, const Grid& grid)
+    {
+      const Vec3fa maxCoord = Vec3fa(float(GRID_MASK));
+      const Vec3fa lower = min(max(floor((prim.lower-grid.ofs)*grid.scale),Vec3fa(zero)),maxCoord);
+      const Vec3fa upper = min(max(ceil ((prim.upper-grid.ofs)*grid.scale),Vec3fa(zero)),maxCoord);
+      const Vec3ia ilower(lower.m128);
+      const Vec3ia iupper(upper.m128);
+      qbounds = 
+        (uint64_t(ilower.x) << (0*GRID_BITS)) | (uint64_t(ilower.y) << (1*GRID_BITS)) | (uint64_t(ilower.z) << (2*GRID_BITS)) |
+        (uint64_t(iupper.x) << (3*GRID_BITS)) | (uint64_t(iupper.y) << (4*GRID_BITS)) | (uint64_t(iupper.z) << (5*GRID_BITS));
+      geomID_ = prim.geomID();
+      primID_ = prim.primID();
+    }
+
+    /*! returns the i'th quantized coordinate */
+    __forceinline float coord(const unsigned int i) const {
+      return float((qbounds >> (i*GRID_BITS)) & GRID_MASK);
+    }
+
+    /*! return the bounding box of the primitive in grid space */
+    __forceinline const BBox3fa bounds() const {
+      return BBox3fa(Vec3fa(coord(0),coord(1),coord(2)),Vec3fa(coord(3),coord(4),coord(5)));
+    }
+
+    /*! returns bounds and centroid used for binning */
+    __forceinline void binBoundsAndCenter(BBox3fa& bounds_o, Vec3fa& center_o) const 
+    {
+      bounds_o = bounds();
+      center_o = embree::center2(bounds_o);
+    }
+
+    /*! returns the geometry ID */
+    __forceinline unsigned geomID() const { 
+      return geomID_;
+    }
+
+    /*! returns the primitive ID */
+    __forceinline unsigned primID() const { 
+      return primID_;
+    }
+
+    /*! special function for operator< */
+    __forceinline uint64_t ID64() const {
+      return (((uint64_t)primID()) << 32) + (uint64_t)geomID();
+    }
+    
+    /*! allows sorting the primrefs by ID */
+    friend __forceinline bool operator<(const PrimRefCompact& p0, const PrimRefCompact& p1) {
+      return p0.ID64() < p1.ID64();
+    }
+
+  public:
+    uint64_t qbounds;       //!< quantized lower and upper bounds
+    unsigned int geomID_;   //!< geometry ID
+    unsigned int primID_;   //!< primitive ID
+  };
+
   /*! fast exchange for PrimRefs */
   __forceinline void xchg(PrimRef& a, PrimRef& b)
   {
@@ -258,6 +258,45 @@ namespace embree
     RTCORE_CATCH_END(scene->device);
   }
 
+  RTCORE_API size_t rtcEvictLazyInstances (RTCScene hscene) 
+  {
+    Scene* scene = (Scene*) hscene;
+    RTCORE_CATCH_BEGIN;
+    RTCORE_TRACE(rtcEvictLazyInstances);
+    RTCORE_VERIFY_HANDLE(hscene);
+    return scene->evictLazyInstances();
+    RTCORE_CATCH_END(scene->device);
+    return 0;
+  }
+
+  RTCORE_API size_t rtcGetCosts(RTCScene hscene, RTCCosts* geometryCosts, size_t numGeometries, RTCCosts* sceneCosts)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTCORE_CATCH_BEGIN;
+    RTCORE_TRACE(rtcGetCosts);
+    RTCORE_VERIFY_HANDLE(hscene);
+    if (numGeometries && geometryCosts == nullptr) throw_RTCError(RTC_INVALID_ARGUMENT,"invalid geometry costs array");
+    if (geometryCosts == nullptr && sceneCosts == nullptr) return scene->size();
+    std::vector<CostCounters::Costs> costs(numGeometries);
+    CostCounters::Costs scosts;
+#if defined(EMBREE_COST_COUNTERS)
+    CostCounters::merge(scene,costs.data(),numGeometries,scosts);
+#endif
+    for (size_t i=0; i<numGeometries; i++) {
+      geometryCosts[i].nodes   = costs[i].nodes;
+      geometryCosts[i].prims   = costs[i].prims;
+      geometryCosts[i].filters = costs[i].filters;
+    }
+    if (sceneCosts) {
+      sceneCosts->nodes   = scosts.nodes;
+      sceneCosts->prims   = scosts.prims;
+      sceneCosts->filters = scosts.filters;
+    }
+    return scene->size();
+    RTCORE_CATCH_END(scene->device);
+    return 0;
+  }
+
   RTCORE_API void rtcGetBounds(RTCScene hscene, RTCBounds& bounds_o)
   {
     Scene* scene = (Scene*) hscene;
@@ -791,6 +830,22 @@ namespace embree
     return -1;
   }
 
+  RTCORE_API unsigned rtcNewLazyInstance (RTCScene htarget, RTCScene hsource, const RTCBounds* bounds, size_t numTimeSteps) 
+  {
+    Scene* target = (Scene*) htarget;
+    Scene* source = (Scene*) hsource;
+    RTCORE_CATCH_BEGIN;
+    RTCORE_TRACE(rtcNewLazyInstance);
+    RTCORE_VERIFY_HANDLE(htarget);
+    RTCORE_VERIFY_HANDLE(hsource);
+    if (target->device != source->device) throw_RTCError(RTC_INVALID_OPERATION,"scenes do not belong to the same device");
+    if (bounds == nullptr) throw_RTCError(RTC_INVALID_ARGUMENT,"lazy instances require bounds");
+    const BBox3fa lbounds(Vec3fa(bounds->lower_x,bounds->lower_y,bounds->lower_z),Vec3fa(bounds->upper_x,bounds->upper_y,bounds->upper_z));
+    return target->newLazyInstance(source,lbounds,numTimeSteps);
+    RTCORE_CATCH_END(target->device);
+    return -1;
+  }
+
   /*RTCORE_API unsigned rtcNewGeometryInstance (RTCScene hscene, unsigned geomID) 
   {
     Scene* scene = (Scene*) hscene;
@@ -950,6 +1005,28 @@ namespace embree
     return -1;
   }
 
+  RTCORE_API unsigned rtcNewSphereGeometry (RTCScene hscene, RTCGeometryFlags flags, size_t numSpheres, size_t numTimeSteps)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTCORE_CATCH_BEGIN;
+    RTCORE_TRACE(rtcNewSphereGeometry);
+    RTCORE_VERIFY_HANDLE(hscene);
+    return scene->newPoints(Points::SPHERES,flags,numSpheres,numTimeSteps);
+    RTCORE_CATCH_END(scene->device);
+    return -1;
+  }
+
+  RTCORE_API unsigned rtcNewDiscGeometry (RTCScene hscene, RTCGeometryFlags flags, size_t numDiscs, size_t numTimeSteps)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTCORE_CATCH_BEGIN;
+    RTCORE_TRACE(rtcNewDiscGeometry);
+    RTCORE_VERIFY_HANDLE(hscene);
+    return scene->newPoints(Points::DISCS,flags,numDiscs,numTimeSteps);
+    RTCORE_CATCH_END(scene->device);
+    return -1;
+  }
+
   RTCORE_API unsigned rtcNewSubdivisionMesh (RTCScene hscene, RTCGeometryFlags flags, size_t numFaces, size_t numEdges, size_t numVertices, 
                                              size_t numEdgeCreases, size_t numVertexCreases, size_t numHoles, size_t numTimeSteps) 
   {
@@ -1404,6 +1481,17 @@ namespace embree
     RTCORE_CATCH_END(scene->device);
   }
 
+  RTCORE_API void rtcSetOpacityMask (RTCScene hscene, unsigned geomID, const void* mask, unsigned level) 
+  {
+    Scene* scene = (Scene*) hscene;
+    RTCORE_CATCH_BEGIN;
+    RTCORE_TRACE(rtcSetOpacityMask);
+    RTCORE_VERIFY_HANDLE(hscene);
+    RTCORE_VERIFY_GEOMID(geomID);
+    scene->get_locked(geomID)->setOpacityMask(mask,level);
+    RTCORE_CATCH_END(scene->device);
+  }
+
   RTCORE_API void rtcInterpolate(RTCScene hscene, unsigned geomID, unsigned primID, float u, float v, 
                                  RTCBufferType buffer,
                                  float* P, float* dPdu, float* dPdv, size_t numFloats)
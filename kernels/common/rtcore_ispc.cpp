@@ -116,6 +116,10 @@ namespace embree
     return rtcCommitThread(scene,threadID,numThreads);
   }
 
+  extern "C" size_t ispcEvictLazyInstances (RTCScene scene) {
+    return rtcEvictLazyInstances(scene);
+  }
+
   extern "C" void ispcGetBounds(RTCScene scene, RTCBounds& bounds_o) {
     rtcGetBounds(scene,bounds_o);
   }
@@ -200,6 +204,10 @@ namespace embree
     return rtcNewInstance2(target,source,numTimeSteps);
   }
 
+  extern "C" unsigned ispcNewLazyInstance (RTCScene target, RTCScene source, const RTCBounds* bounds, size_t numTimeSteps) {
+    return rtcNewLazyInstance(target,source,bounds,numTimeSteps);
+  }
+
   /*extern "C" unsigned ispcNewGeometryInstance (RTCScene scene, unsigned geomID) {
     return rtcNewGeometryInstance(scene,geomID);
     }*/
@@ -236,6 +244,14 @@ namespace embree
     return rtcNewLineSegments(scene,flags,numSegments,numVertices,numTimeSteps);
   }
 
+  extern "C" unsigned ispcNewSphereGeometry (RTCScene scene, RTCGeometryFlags flags, size_t numSpheres, size_t numTimeSteps) {
+    return rtcNewSphereGeometry(scene,flags,numSpheres,numTimeSteps);
+  }
+
+  extern "C" unsigned ispcNewDiscGeometry (RTCScene scene, RTCGeometryFlags flags, size_t numDiscs, size_t numTimeSteps) {
+    return rtcNewDiscGeometry(scene,flags,numDiscs,numTimeSteps);
+  }
+
   extern "C" unsigned ispcNewHairGeometry (RTCScene scene, RTCGeometryFlags flags, size_t numCurves, size_t numVertices, size_t numTimeSteps) {
     return rtcNewHairGeometry(scene,flags,numCurves,numVertices,numTimeSteps);
   }
@@ -571,6 +587,10 @@ namespace embree
     RTCORE_CATCH_END(scene->device);
   }
 
+  extern "C" void ispcSetOpacityMask (RTCScene scene, unsigned geomID, const void* mask, unsigned level) {
+    rtcSetOpacityMask(scene,geomID,mask,level);
+  }
+
   extern "C" void ispcSetDisplacementFunction (RTCScene hscene, unsigned int geomID, void* func, RTCBounds* bounds)
   {
     Scene* scene = (Scene*) hscene;
@@ -40,6 +40,7 @@ namespace embree
       needQuadIndices(false), needQuadVertices(false), 
       needBezierIndices(false), needBezierVertices(false),
       needLineIndices(false), needLineVertices(false),
+      needPointVertices(false),
       needSubdivIndices(false), needSubdivVertices(false),
       is_build(false), modified(true),
       progressInterface(this), progress_monitor_function(nullptr), progress_monitor_ptr(nullptr), progress_monitor_counter(0), 
@@ -68,6 +69,7 @@ namespace embree
       needQuadVertices = true;      
       needBezierVertices = true;
       needLineVertices = true;
+      needPointVertices = true;
       needSubdivVertices = true;
     }
 
@@ -81,9 +83,10 @@ namespace embree
     createHairMBAccel();
     createLineAccel();
     createLineMBAccel();
+    createPointAccel();
 
 #if defined(EMBREE_GEOMETRY_TRIANGLES)
-    accels.add(device->bvh4_factory->BVH4InstancedBVH4Triangle4ObjectSplit(this));
+    accels.add(device->bvh4_factory->BVH4InstancedBVH4ObjectSplit(this));
 #endif
 
     // has to be the last as the instID field of a hit instance is not invalidated by other hit geometry
@@ -100,6 +103,17 @@ namespace embree
         int mode =  2*(int)isCompact() + 1*(int)isRobust(); 
         switch (mode) {
         case /*0b00*/ 0: 
+          /* paired triangles have no high quality builder, and for BVH8 no stream intersector */
+          if (device->tri_pairs && !isHighQuality())
+          {
+#if defined (__TARGET_AVX__)
+            if (device->hasISA(AVX) && !isStreamMode())
+              accels.add(device->bvh8_factory->BVH8TrianglePair4v(this));
+            else
+#endif
+              accels.add(device->bvh4_factory->BVH4TrianglePair4v(this));
+            break;
+          }
 #if defined (__TARGET_AVX__)
           if (device->hasISA(AVX))
 	  {
@@ -175,11 +189,13 @@ namespace embree
     else if (device->tri_accel == "bvh4.triangle4v")      accels.add(device->bvh4_factory->BVH4Triangle4v(this));
     else if (device->tri_accel == "bvh4.triangle4i")      accels.add(device->bvh4_factory->BVH4Triangle4i(this));
     else if (device->tri_accel == "qbvh4.triangle4i")     accels.add(device->bvh4_factory->BVH4QuantizedTriangle4i(this));
+    else if (device->tri_accel == "bvh4.trianglepair4v")  accels.add(device->bvh4_factory->BVH4TrianglePair4v(this));
 
 #if defined (__TARGET_AVX__)
     else if (device->tri_accel == "bvh8.triangle4")       accels.add(device->bvh8_factory->BVH8Triangle4 (this));
     else if (device->tri_accel == "bvh8.triangle4i")      accels.add(device->bvh8_factory->BVH8Triangle4i(this));
     else if (device->tri_accel == "qbvh8.triangle4i")     accels.add(device->bvh8_factory->BVH8QuantizedTriangle4i(this));
+    else if (device->tri_accel == "bvh8.trianglepair4v")  accels.add(device->bvh8_factory->BVH8TrianglePair4v(this));
 #endif
     else throw_RTCError(RTC_INVALID_ARGUMENT,"unknown triangle acceleration structure "+device->tri_accel);
 #endif
@@ -198,8 +214,8 @@ namespace embree
         switch (mode) {
         case /*0b00*/ 0: accels.add(device->bvh8_factory->BVH8Triangle4iMB(this,BVH8Factory::BuildVariant::STATIC,BVH8Factory::IntersectVariant::FAST  )); break;
         case /*0b01*/ 1: accels.add(device->bvh8_factory->BVH8Triangle4iMB(this,BVH8Factory::BuildVariant::STATIC,BVH8Factory::IntersectVariant::ROBUST)); break;
-        case /*0b10*/ 2: accels.add(device->bvh4_factory->BVH4Triangle4iMB(this,BVH4Factory::BuildVariant::STATIC,BVH4Factory::IntersectVariant::FAST  )); break;
-        case /*0b11*/ 3: accels.add(device->bvh4_factory->BVH4Triangle4iMB(this,BVH4Factory::BuildVariant::STATIC,BVH4Factory::IntersectVariant::ROBUST)); break;
+        case /*0b10*/ 2: accels.add(device->bvh4_factory->BVH4QuantizedTriangle4iMB(this,BVH4Factory::IntersectVariant::FAST  )); break;
+        case /*0b11*/ 3: accels.add(device->bvh4_factory->BVH4QuantizedTriangle4iMB(this,BVH4Factory::IntersectVariant::ROBUST)); break;
         }
       }
       else
@@ -208,13 +224,14 @@ namespace embree
         switch (mode) {
         case /*0b00*/ 0: accels.add(device->bvh4_factory->BVH4Triangle4iMB(this,BVH4Factory::BuildVariant::STATIC,BVH4Factory::IntersectVariant::FAST  )); break;
         case /*0b01*/ 1: accels.add(device->bvh4_factory->BVH4Triangle4iMB(this,BVH4Factory::BuildVariant::STATIC,BVH4Factory::IntersectVariant::ROBUST)); break;
-        case /*0b10*/ 2: accels.add(device->bvh4_factory->BVH4Triangle4iMB(this,BVH4Factory::BuildVariant::STATIC,BVH4Factory::IntersectVariant::FAST  )); break;
-        case /*0b11*/ 3: accels.add(device->bvh4_factory->BVH4Triangle4iMB(this,BVH4Factory::BuildVariant::STATIC,BVH4Factory::IntersectVariant::ROBUST)); break;
+        case /*0b10*/ 2: accels.add(device->bvh4_factory->BVH4QuantizedTriangle4iMB(this,BVH4Factory::IntersectVariant::FAST  )); break;
+        case /*0b11*/ 3: accels.add(device->bvh4_factory->BVH4QuantizedTriangle4iMB(this,BVH4Factory::IntersectVariant::ROBUST)); break;
         }
       }
     }
     else if (device->tri_accel_mb == "bvh4.triangle4vmb") accels.add(device->bvh4_factory->BVH4Triangle4vMB(this));
     else if (device->tri_accel_mb == "bvh4.triangle4imb") accels.add(device->bvh4_factory->BVH4Triangle4iMB(this));
+    else if (device->tri_accel_mb == "qbvh4.triangle4imb") accels.add(device->bvh4_factory->BVH4QuantizedTriangle4iMB(this));
 #if defined (__TARGET_AVX__)
     else if (device->tri_accel_mb == "bvh8.triangle4vmb") accels.add(device->bvh8_factory->BVH8Triangle4vMB(this));
     else if (device->tri_accel_mb == "bvh8.triangle4imb") accels.add(device->bvh8_factory->BVH8Triangle4iMB(this));
@@ -313,11 +330,12 @@ namespace embree
           accels.add(device->bvh4_factory->BVH4Quad4iMB(this,BVH4Factory::BuildVariant::STATIC,BVH4Factory::IntersectVariant::ROBUST));
         break;
 
-      case /*0b10*/ 2: accels.add(device->bvh4_factory->BVH4Quad4iMB(this,BVH4Factory::BuildVariant::STATIC,BVH4Factory::IntersectVariant::FAST  )); break;
-      case /*0b11*/ 3: accels.add(device->bvh4_factory->BVH4Quad4iMB(this,BVH4Factory::BuildVariant::STATIC,BVH4Factory::IntersectVariant::ROBUST)); break;
+      case /*0b10*/ 2: accels.add(device->bvh4_factory->BVH4QuantizedQuad4iMB(this,BVH4Factory::IntersectVariant::FAST  )); break;
+      case /*0b11*/ 3: accels.add(device->bvh4_factory->BVH4QuantizedQuad4iMB(this,BVH4Factory::IntersectVariant::ROBUST)); break;
       }
     }
     else if (device->quad_accel_mb == "bvh4.quad4imb") accels.add(device->bvh4_factory->BVH4Quad4iMB(this));
+    else if (device->quad_accel_mb == "qbvh4.quad4imb") accels.add(device->bvh4_factory->BVH4QuantizedQuad4iMB(this));
 #if defined (__TARGET_AVX__)
     else if (device->quad_accel_mb == "bvh8.quad4imb") accels.add(device->bvh8_factory->BVH8Quad4iMB(this));
 #endif
@@ -447,6 +465,27 @@ namespace embree
 #endif
   }
 
+  void Scene::createPointAccel()
+  {
+#if defined(EMBREE_GEOMETRY_POINTS)
+    if (device->point_accel == "default")
+    {
+#if defined (__TARGET_AVX__)
+      /* the BVH8 point accel has no stream intersector yet */
+      if (device->hasISA(AVX) && !isCompact() && !isStreamMode())
+        accels.add(device->bvh8_factory->BVH8Point4v(this));
+      else
+#endif
+        accels.add(device->bvh4_factory->BVH4Point4v(this));
+    }
+    else if (device->point_accel == "bvh4.point4v") accels.add(device->bvh4_factory->BVH4Point4v(this));
+#if defined (__TARGET_AVX__)
+    else if (device->point_accel == "bvh8.point4v") accels.add(device->bvh8_factory->BVH8Point4v(this));
+#endif
+    else throw_RTCError(RTC_INVALID_ARGUMENT,"unknown point acceleration structure "+device->point_accel);
+#endif
+  }
+
   void Scene::createSubdivAccel()
   {
 #if defined(EMBREE_GEOMETRY_SUBDIV)
@@ -508,6 +547,8 @@ namespace embree
     for (size_t i=0; i<geometries.size(); i++)
       delete geometries[i];
 
+    COST(CostCounters::clear(this));
+
 #if defined(TASKING_TBB) || defined(TASKING_PPL)
     delete group; group = nullptr;
 #endif
@@ -542,6 +583,22 @@ namespace embree
     Geometry* geom = Instance::create(this,scene,numTimeSteps);
     return geom->id;
   }
+
+  unsigned Scene::newLazyInstance (Scene* scene, const BBox3fa& bounds, size_t numTimeSteps) 
+  {
+    if (numTimeSteps == 0 || numTimeSteps > RTC_MAX_TIME_STEPS) {
+      throw_RTCError(RTC_INVALID_OPERATION,"maximal number of timesteps exceeded");
+      return -1;
+    }
+
+    if (scene->isStatic()) {
+      throw_RTCError(RTC_INVALID_OPERATION,"lazily instanced scenes cannot be static");
+      return -1;
+    }
+
+    Geometry* geom = Instance::create(this,scene,numTimeSteps,&bounds);
+    return geom->id;
+  }
   
   unsigned Scene::newGeometryInstance (Geometry* geom) 
   {
@@ -636,6 +693,22 @@ namespace embree
     return geom->id;
   }
 
+  unsigned Scene::newPoints (Points::SubType subtype, RTCGeometryFlags gflags, size_t numPoints, size_t numTimeSteps)
+  {
+    if (isStatic() && (gflags != RTC_GEOMETRY_STATIC)) {
+      throw_RTCError(RTC_INVALID_OPERATION,"static scenes can only contain static geometries");
+      return -1;
+    }
+
+    if (numTimeSteps != 1) {
+      throw_RTCError(RTC_INVALID_OPERATION,"motion blur is not supported for point geometries");
+      return -1;
+    }
+
+    Geometry* geom = new Points(this,subtype,gflags,numPoints,numTimeSteps);
+    return geom->id;
+  }
+
   unsigned Scene::add(Geometry* geometry) 
   {
     Lock<SpinLock> lock(geometriesMutex);
@@ -692,7 +765,7 @@ namespace embree
     commitCounter++;
   }
 
-  void Scene::build_task ()
+  void Scene::build_task (bool sequential)
   {
     progress_monitor_counter = 0;
 
@@ -703,7 +776,8 @@ namespace embree
                   numIntersectionFiltersN);
   
     /* build all hierarchies of this scene */
-    accels.build(0,0);
+    if (sequential) accels.build_sequential();
+    else            accels.build(0,0);
 
     /* make static geometry immutable */
     if (isStatic()) 
@@ -733,10 +807,84 @@ namespace embree
     setModified(false);
   }
 
+  size_t Scene::evictLazyInstances ()
+  {
+    /* a scene can only get evicted if all its instances are lazy and did not get accessed */
+    std::map<Scene*,bool> evictable;
+    for (size_t i=0; i<geometries.size(); i++)
+    {
+      Geometry* geom = geometries[i];
+      if (!geom || !geom->getInstancedScene()) continue;
+      Instance* instance = (Instance*) geom;
+      const bool unused = instance->lazy && !instance->resetLazyUsed();
+      auto e = evictable.find(instance->object);
+      if (e == evictable.end()) evictable[instance->object] = unused;
+      else e->second = e->second && unused;
+    }
+
+    size_t numEvicted = 0;
+    for (auto& e : evictable) {
+      if (!e.second || e.first->isModified()) continue;
+      e.first->evict();
+      numEvicted++;
+    }
+    return numEvicted;
+  }
+
+  void Scene::evict ()
+  {
+    for (size_t i=0; i<geometries.size(); i++)
+      if (geometries[i] && geometries[i]->isEnabled()) geometries[i]->update();
+
+    accels.clear();
+    setModified(true);
+  }
+
+  bool Scene::isTiny() const
+  {
+    /* only the SAH builders of static triangle and quad meshes build tiny scenes without spawning tasks */
+    const size_t numTrianglesQuads = world.numTriangles + world.numQuads;
+    return isStatic() && !isHighQuality() && !device->tri_pairs &&
+      numTrianglesQuads <= device->tiny_scene_threshold && numTrianglesQuads == numPrimitives();
+  }
+
+  void Scene::build_tiny ()
+  {
+    Lock<MutexSys> lock(buildMutex);
+
+    /* scene may got build by another thread meanwhile */
+    if (!isModified()) 
+      return;
+
+    if (!ready())
+      throw_RTCError(RTC_INVALID_OPERATION,"not all buffers are unmapped");
+
+    /* for best performance set FTZ and DAZ flags in the MXCSR control and status register */
+    unsigned int mxcsr = _mm_getcsr();
+    _mm_setcsr(mxcsr | /* FTZ */ (1<<15) | /* DAZ */ (1<<6));
+
+    try {
+      build_task(true);
+    }
+    catch (...) {
+      _mm_setcsr(mxcsr);
+      accels.clear();
+      updateInterface();
+      throw;
+    }
+    _mm_setcsr(mxcsr);
+  }
+
 #if defined(TASKING_INTERNAL)
 
   void Scene::build (size_t threadIndex, size_t threadCount) 
   {
+    /* tiny scenes are cheaper to build without a task scheduler */
+    if (threadCount == 0 && isTiny()) {
+      build_tiny();
+      return;
+    }
+
     Lock<MutexSys> buildLock(buildMutex,false);
 
     /* allocates own taskscheduler for each build */
@@ -789,6 +937,12 @@ namespace embree
 
   void Scene::build (size_t threadIndex, size_t threadCount) 
   {
+    /* tiny scenes are cheaper to build without a task scheduler */
+    if (threadCount == 0 && isTiny()) {
+      build_tiny();
+      return;
+    }
+
     /* let threads wait for build to finish in rtcCommitThread mode */
     if (threadCount != 0) {
       if (threadIndex > 0) {
@@ -25,6 +25,7 @@
 #include "scene_geometry_instance.h"
 #include "scene_bezier_curves.h"
 #include "scene_line_segments.h"
+#include "scene_points.h"
 #include "scene_subdiv_mesh.h"
 
 #include "../subdiv/tessellation_cache.h"
@@ -111,6 +112,7 @@ namespace embree
     void createHairMBAccel();
     void createLineAccel();
     void createLineMBAccel();
+    void createPointAccel();
     void createSubdivAccel();
     void createSubdivMBAccel();
     void createUserGeometryAccel();
@@ -128,6 +130,9 @@ namespace embree
     /*! Creates a new scene instance. */
     unsigned int newInstance (Scene* scene, size_t numTimeSteps);
 
+    /*! Creates a new scene instance that builds the scene on first access. */
+    unsigned int newLazyInstance (Scene* scene, const BBox3fa& bounds, size_t numTimeSteps);
+
     /*! Creates a new geometry instance. */
     unsigned int newGeometryInstance (Geometry* geom);
 
@@ -143,6 +148,9 @@ namespace embree
     /*! Creates a new collection of line segments. */
     unsigned int newLineSegments (RTCGeometryFlags flags, size_t maxSegments, size_t maxVertices, size_t numTimeSteps);
 
+    /*! Creates a new collection of spheres or discs. */
+    unsigned int newPoints (Points::SubType subtype, RTCGeometryFlags flags, size_t maxPoints, size_t numTimeSteps);
+
     /*! Creates a new subdivision mesh. */
     unsigned int newSubdivisionMesh (RTCGeometryFlags flags, size_t numFaces, size_t numEdges, size_t numVertices, size_t numEdgeCreases, size_t numVertexCreases, size_t numHoles, size_t numTimeSteps);
 
@@ -151,7 +159,19 @@ namespace embree
 
     /*! Builds acceleration structure for the scene. */
     void build (size_t threadIndex, size_t threadCount);
-    void build_task ();
+    void build_task (bool sequential = false);
+
+    /*! Tests if the scene is small enough to get build by the calling thread without a task scheduler. */
+    bool isTiny() const;
+
+    /*! Builds a tiny scene by the calling thread. */
+    void build_tiny ();
+
+    /*! Frees the acceleration structures of lazily instanced scenes not accessed since the last call. */
+    size_t evictLazyInstances ();
+
+    /*! Frees the acceleration structure, the next build rebuilds all geometries. */
+    void evict ();
 
     void updateInterface();
 
@@ -267,6 +287,19 @@ namespace embree
       return (LineSegments*) geometries[i];
     }
 
+    __forceinline Points* getPoints(size_t i) {
+      assert(i < geometries.size());
+      assert(geometries[i]);
+      assert(geometries[i]->getType() == Geometry::POINTS);
+      return (Points*) geometries[i];
+    }
+    __forceinline const Points* getPoints(size_t i) const {
+      assert(i < geometries.size());
+      assert(geometries[i]);
+      assert(geometries[i]->getType() == Geometry::POINTS);
+      return (Points*) geometries[i];
+    }
+
     /* test if this is a static scene */
     __forceinline bool isStatic() const { return embree::isStatic(flags); }
 
@@ -311,12 +344,13 @@ namespace embree
     bool needBezierVertices;
     bool needLineIndices;
     bool needLineVertices;
+    bool needPointVertices;
     bool needSubdivIndices;
     bool needSubdivVertices;
     MutexSys buildMutex;
     SpinLock geometriesMutex;
     bool is_build;
-    bool modified;                   //!< true if scene got modified
+    std::atomic<bool> modified;      //!< true if scene got modified
     
     /*! global lock step task scheduler */
 #if defined(TASKING_INTERNAL) 
@@ -349,16 +383,17 @@ namespace embree
     struct GeometryCounts 
     {
       __forceinline GeometryCounts()
-        : numTriangles(0), numQuads(0), numBezierCurves(0), numLineSegments(0), numSubdivPatches(0), numUserGeometries(0) {}
+        : numTriangles(0), numQuads(0), numBezierCurves(0), numLineSegments(0), numPoints(0), numSubdivPatches(0), numUserGeometries(0) {}
 
       __forceinline size_t size() const {
-        return numTriangles + numQuads + numBezierCurves + numLineSegments + numSubdivPatches + numUserGeometries;
+        return numTriangles + numQuads + numBezierCurves + numLineSegments + numPoints + numSubdivPatches + numUserGeometries;
       }
 
       std::atomic<size_t> numTriangles;             //!< number of enabled triangles
       std::atomic<size_t> numQuads;                 //!< number of enabled quads
       std::atomic<size_t> numBezierCurves;          //!< number of enabled curves
       std::atomic<size_t> numLineSegments;          //!< number of enabled line segments
+      std::atomic<size_t> numPoints;                //!< number of enabled spheres and discs
       std::atomic<size_t> numSubdivPatches;         //!< number of enabled subdivision patches
       std::atomic<size_t> numUserGeometries;        //!< number of enabled user geometries
     };
@@ -401,6 +436,8 @@ namespace embree
   template<> __forceinline size_t Scene::getNumPrimitives<BezierCurves,true>() const { return worldMB.numBezierCurves; }
   template<> __forceinline size_t Scene::getNumPrimitives<LineSegments,false>() const { return world.numLineSegments; }
   template<> __forceinline size_t Scene::getNumPrimitives<LineSegments,true>() const { return worldMB.numLineSegments; }
+  template<> __forceinline size_t Scene::getNumPrimitives<Points,false>() const { return world.numPoints; }
+  template<> __forceinline size_t Scene::getNumPrimitives<Points,true>() const { return worldMB.numPoints; }
   template<> __forceinline size_t Scene::getNumPrimitives<SubdivMesh,false>() const { return world.numSubdivPatches; }
   template<> __forceinline size_t Scene::getNumPrimitives<SubdivMesh,true>() const { return worldMB.numSubdivPatches; }
   template<> __forceinline size_t Scene::getNumPrimitives<AccelSet,false>() const { return world.numUserGeometries; }
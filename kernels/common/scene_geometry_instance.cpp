@@ -31,6 +31,7 @@ namespace embree
     {
       switch (geom->type) {
       case TRIANGLE_MESH: parent->instanced.numTriangles      += f*ssize_t(geom->size()); break;
+      case QUAD_MESH    : parent->instanced.numQuads          += f*ssize_t(geom->size()); break;
       case USER_GEOMETRY: parent->instanced.numUserGeometries += f*ssize_t(geom->size()); break;
       case BEZIER_CURVES: parent->instanced.numBezierCurves   += f*ssize_t(geom->size()); break;
       case SUBDIV_MESH  : parent->instanced.numSubdivPatches  += f*ssize_t(geom->size()); break;
@@ -41,6 +42,7 @@ namespace embree
     {
       switch (geom->type) {
       case TRIANGLE_MESH: parent->instancedMB.numTriangles      += f*ssize_t(geom->size()); break;
+      case QUAD_MESH    : parent->instancedMB.numQuads          += f*ssize_t(geom->size()); break;
       case USER_GEOMETRY: parent->instancedMB.numUserGeometries += f*ssize_t(geom->size()); break;
       case BEZIER_CURVES: parent->instancedMB.numBezierCurves   += f*ssize_t(geom->size()); break;
       case SUBDIV_MESH  : parent->instancedMB.numSubdivPatches  += f*ssize_t(geom->size()); break;
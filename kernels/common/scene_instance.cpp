@@ -38,8 +38,8 @@ namespace embree
 #endif
   }
 
-  Instance::Instance (Scene* parent, Scene* object, size_t numTimeSteps) 
-    : AccelSet(parent,RTC_GEOMETRY_STATIC,1,numTimeSteps), object(object)
+  Instance::Instance (Scene* parent, Scene* object, size_t numTimeSteps, const BBox3fa* lazyBounds) 
+    : AccelSet(parent,RTC_GEOMETRY_STATIC,1,numTimeSteps), object(object), lazy(lazyBounds != nullptr), lazyBounds(lazyBounds ? *lazyBounds : BBox3fa(empty)), lazyUsed(false)
   {
     world2local0 = one;
     for (size_t i=0; i<numTimeSteps; i++) local2world[i] = one;
@@ -53,6 +53,17 @@ namespace embree
     intersectors.intersector1M = parent->device->instance_factory->InstanceIntersector1M;
   }
   
+  Scene* Instance::getLazyObject() const
+  {
+    if (!lazyUsed.load(std::memory_order_relaxed)) lazyUsed = true;
+
+    /* the first ray builds the scene, concurrent rays join that build */
+    if (unlikely(object->isModified()))
+      object->build(0,0);
+
+    return object;
+  }
+  
   void Instance::setTransform(const AffineSpace3fa& xfm, size_t timeStep)
   {
     if (parent->isStatic() && parent->isBuild())
@@ -37,15 +37,32 @@ namespace embree
   {
     ALIGNED_STRUCT;
   public:
-    static Instance* create (Scene* parent, Scene* object, size_t numTimeSteps) {
-      return ::new (alignedMalloc(sizeof(Instance)+(numTimeSteps-1)*sizeof(AffineSpace3fa))) Instance(parent,object,numTimeSteps);
+    static Instance* create (Scene* parent, Scene* object, size_t numTimeSteps, const BBox3fa* lazyBounds = nullptr) {
+      return ::new (alignedMalloc(sizeof(Instance)+(numTimeSteps-1)*sizeof(AffineSpace3fa))) Instance(parent,object,numTimeSteps,lazyBounds);
     }
   private:
-    Instance (Scene* parent, Scene* object, size_t numTimeSteps); 
+    Instance (Scene* parent, Scene* object, size_t numTimeSteps, const BBox3fa* lazyBounds); 
   public:
     virtual void setTransform(const AffineSpace3fa& local2world, size_t timeStep);
     virtual void setMask (unsigned mask);
     virtual void build(size_t threadIndex, size_t threadCount) {}
+    virtual Scene* getInstancedScene() const { return object; }
+
+  public:
+
+    /*! returns the instanced scene, lazy instances build it on first access */
+    __forceinline Scene* getObject() const {
+      if (unlikely(lazy)) return getLazyObject();
+      return object;
+    }
+
+    /*! returns true if the instanced scene got accessed since the last call */
+    __forceinline bool resetLazyUsed() const {
+      return lazyUsed.exchange(false);
+    }
+
+  private:
+    Scene* getLazyObject() const;
 
   public:
 
@@ -88,6 +105,9 @@ namespace embree
     
   public:
     Scene* object;                 //!< pointer to instanced acceleration structure
+    bool lazy;                     //!< true if the instanced scene gets build on first access
+    BBox3fa lazyBounds;            //!< user provided local space bounds of lazily build scene
+    mutable std::atomic<bool> lazyUsed; //!< true if lazily build scene got accessed since last eviction
     AffineSpace3fa world2local0;   //!< transformation from world space to local space for timestep 0
     AffineSpace3fa local2world[1]; //!< transformation from local space to world space for each timestep
   };
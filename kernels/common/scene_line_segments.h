@@ -143,6 +143,29 @@ namespace embree
       return true;
     }
 
+    /*! calculates the build bounds of the num<=4 primitives starting at the i'th primitive, returns which of them are valid */
+    __forceinline vbool4 buildBounds4(size_t i, size_t num, Vec3vf4& lower, Vec3vf4& upper) const
+    {
+      assert(numTimeSteps == 1 && num > 0 && num <= 4);
+      const vint4 i0(segment(i+0),segment(i+min(size_t(1),num-1)),segment(i+min(size_t(2),num-1)),segment(i+min(size_t(3),num-1)));
+
+      /* indices are unsigned, thus out of range indices are either negative or too large */
+      vbool4 valid = vint4(step) < vint4(int(num));
+      valid &= (i0 >= vint4(zero)) & (i0 < vint4(int(numVertices())-1));
+      if (none(valid)) return valid;
+
+      const auto ptr = [&] (int j) { return vertexPtr(j); };
+      const vint4 index = select(valid,i0,vint4(zero));
+      Vec3vf4 v0, v1; vfloat4 r0, r1;
+      valid &= gatherVertices4(ptr,index,v0,r0);
+      valid &= gatherVertices4(ptr,index+1,v1,r1);
+      valid &= (r0 >= 0.0f) & (r0 < vfloat4(+FLT_LARGE)) & (r1 >= 0.0f) & (r1 < vfloat4(+FLT_LARGE));
+      const vfloat4 r = max(r0,r1);
+      lower = min(v0,v1)-Vec3vf4(r);
+      upper = max(v0,v1)+Vec3vf4(r);
+      return valid;
+    }
+
     /*! calculates the build bounds of the i'th primitive at the itime'th time segment, if it's valid */
     __forceinline bool buildBounds(size_t i, size_t itime, BBox3fa& bbox) const
     {
@@ -0,0 +1,184 @@
+// ======================================================================== //
+// Copyright 2009-2016 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#include "scene_points.h"
+#include "scene.h"
+
+namespace embree
+{
+  Points::Points (Scene* parent, SubType subtype, RTCGeometryFlags flags, size_t numPrimitives, size_t numTimeSteps)
+    : Geometry(parent,POINTS,numPrimitives,numTimeSteps,flags), subtype(subtype)
+  {
+    vertices.resize(numTimeSteps);
+    for (size_t i=0; i<numTimeSteps; i++) {
+      vertices[i].init(parent->device,numPrimitives,sizeof(Vec3fa));
+    }
+    enabling();
+  }
+
+  void Points::enabling()
+  {
+    if (numTimeSteps == 1) parent->world.numPoints += numPrimitives;
+    else                   parent->worldMB.numPoints += numPrimitives;
+  }
+
+  void Points::disabling()
+  {
+    if (numTimeSteps == 1) parent->world.numPoints -= numPrimitives;
+    else                   parent->worldMB.numPoints -= numPrimitives;
+  }
+
+  void Points::setMask (unsigned mask)
+  {
+    if (parent->isStatic() && parent->isBuild())
+      throw_RTCError(RTC_INVALID_OPERATION,"static geometries cannot get modified");
+
+    this->mask = mask;
+    Geometry::update();
+  }
+
+  void Points::setBuffer(RTCBufferType type, void* ptr, size_t offset, size_t stride)
+  {
+    if (parent->isStatic() && parent->isBuild())
+      throw_RTCError(RTC_INVALID_OPERATION,"static geometries cannot get modified");
+
+    /* verify that all accesses are 4 bytes aligned */
+    if (((size_t(ptr) + offset) & 0x3) || (stride & 0x3))
+      throw_RTCError(RTC_INVALID_OPERATION,"data must be 4 bytes aligned");
+
+    if (type >= RTC_VERTEX_BUFFER0 && type < RTCBufferType(RTC_VERTEX_BUFFER0 + numTimeSteps)) 
+    {
+      size_t t = type - RTC_VERTEX_BUFFER0;
+      vertices[t].set(ptr,offset,stride); 
+      vertices[t].checkPadding16();
+      vertices0 = vertices[0];
+    } 
+    else 
+    {
+      switch (type) {
+      case RTC_USER_VERTEX_BUFFER0: 
+        if (userbuffers[0] == nullptr) userbuffers[0].reset(new APIBuffer<char>(parent->device,numVertices(),stride)); 
+        userbuffers[0]->set(ptr,offset,stride);  
+        userbuffers[0]->checkPadding16();
+        break;
+      case RTC_USER_VERTEX_BUFFER1: 
+        if (userbuffers[1] == nullptr) userbuffers[1].reset(new APIBuffer<char>(parent->device,numVertices(),stride)); 
+        userbuffers[1]->set(ptr,offset,stride);  
+        userbuffers[1]->checkPadding16();
+        break;
+        
+      default: 
+        throw_RTCError(RTC_INVALID_ARGUMENT,"unknown buffer type");
+      }
+    }
+  }
+
+  void* Points::map(RTCBufferType type)
+  {
+    if (parent->isStatic() && parent->isBuild()) {
+      throw_RTCError(RTC_INVALID_OPERATION,"static geometries cannot get modified");
+      return nullptr;
+    }
+
+    if (type >= RTC_VERTEX_BUFFER0 && type < RTCBufferType(RTC_VERTEX_BUFFER0 + numTimeSteps)) {
+      return vertices[type - RTC_VERTEX_BUFFER0].map(parent->numMappedBuffers);
+    }
+    else {
+      throw_RTCError(RTC_INVALID_ARGUMENT,"unknown buffer type"); 
+      return nullptr;
+    }
+  }
+
+  void Points::unmap(RTCBufferType type)
+  {
+    if (parent->isStatic() && parent->isBuild())
+      throw_RTCError(RTC_INVALID_OPERATION,"static geometries cannot get modified");
+
+    if (type >= RTC_VERTEX_BUFFER0 && type < RTCBufferType(RTC_VERTEX_BUFFER0 + numTimeSteps)) {
+      vertices[type - RTC_VERTEX_BUFFER0].unmap(parent->numMappedBuffers);
+      vertices0 = vertices[0];
+    }
+    else {
+      throw_RTCError(RTC_INVALID_ARGUMENT,"unknown buffer type"); 
+    }
+  }
+
+  void Points::immutable ()
+  {
+    /* the point leaves store a copy of the vertices */
+    const bool freeVertices = !parent->needPointVertices;
+    if (freeVertices)
+      for (auto& buffer : vertices)
+        buffer.free();
+  }
+
+  bool Points::verify ()
+  { 
+    /*! verify consistent size of vertex arrays */
+    if (vertices.size() == 0) return false;
+    for (const auto& buffer : vertices)
+      if (vertices[0].size() != buffer.size())
+        return false;
+
+    /*! verify vertices */
+    for (const auto& buffer : vertices) {
+      for (size_t i=0; i<buffer.size(); i++) {
+	if (!isvalid(buffer[i].x)) return false;
+        if (!isvalid(buffer[i].y)) return false;
+        if (!isvalid(buffer[i].z)) return false;
+        if (!isvalid(buffer[i].w)) return false;
+        if (buffer[i].w < 0.0f) return false;
+      }
+    }
+    return true;
+  }
+
+  void Points::interpolate(unsigned primID, float u, float v, RTCBufferType buffer, float* P, float* dPdu, float* dPdv, float* ddPdudu, float* ddPdvdv, float* ddPdudv, size_t numFloats)
+  {
+    /* test if interpolation is enabled */
+#if defined(DEBUG)
+    if ((parent->aflags & RTC_INTERPOLATE) == 0)
+      throw_RTCError(RTC_INVALID_OPERATION,"rtcInterpolate can only get called when RTC_INTERPOLATE is enabled for the scene");
+#endif
+
+    /* calculate base pointer and stride */
+    assert((buffer >= RTC_VERTEX_BUFFER0 && buffer < RTCBufferType(RTC_VERTEX_BUFFER0 + numTimeSteps)) ||
+           (buffer >= RTC_USER_VERTEX_BUFFER0 && buffer <= RTC_USER_VERTEX_BUFFER1));
+    const char* src = nullptr;
+    size_t stride = 0;
+    if (buffer >= RTC_USER_VERTEX_BUFFER0) {
+      src    = userbuffers[buffer&0xFFFF]->getPtr();
+      stride = userbuffers[buffer&0xFFFF]->getStride();
+    } else {
+      src    = vertices[buffer&0xFFFF].getPtr();
+      stride = vertices[buffer&0xFFFF].getStride();
+    }
+
+    /* points are constant over their surface */
+    for (size_t i=0; i<numFloats; i+=VSIZEX)
+    {
+      const size_t ofs = i*sizeof(float);
+      const vboolx valid = vintx((int)i)+vintx(step) < vintx(numFloats);
+      const vfloatx p0 = vfloatx::loadu(valid,(float*)&src[primID*stride+ofs]);
+      if (P      ) vfloatx::storeu(valid,P+i,p0);
+      if (dPdu   ) vfloatx::storeu(valid,dPdu+i,vfloatx(zero));
+      if (dPdv   ) vfloatx::storeu(valid,dPdv+i,vfloatx(zero));
+      if (ddPdudu) vfloatx::storeu(valid,ddPdudu+i,vfloatx(zero));
+      if (ddPdvdv) vfloatx::storeu(valid,ddPdvdv+i,vfloatx(zero));
+      if (ddPdudv) vfloatx::storeu(valid,ddPdudv+i,vfloatx(zero));
+    }
+  }
+}
@@ -0,0 +1,125 @@
+// ======================================================================== //
+// Copyright 2009-2016 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#pragma once
+
+#include "default.h"
+#include "geometry.h"
+#include "primref.h"
+#include "buffer.h"
+
+namespace embree
+{
+  /*! represents an array of spheres or ray facing discs */
+  struct Points : public Geometry
+  {
+    /*! type of this geometry */
+    static const Geometry::Type geom_type = Geometry::POINTS;
+
+    /*! this geometry represents spheres or discs */
+    enum SubType { SPHERES = 0, DISCS = 1 };
+
+  public:
+
+    /*! points construction */
+    Points (Scene* parent, SubType subtype, RTCGeometryFlags flags, size_t numPrimitives, size_t numTimeSteps);
+
+  public:
+    void enabling();
+    void disabling();
+    void setMask (unsigned mask);
+    void setBuffer(RTCBufferType type, void* ptr, size_t offset, size_t stride);
+    void* map(RTCBufferType type);
+    void unmap(RTCBufferType type);
+    void immutable ();
+    bool verify ();
+    void interpolate(unsigned primID, float u, float v, RTCBufferType buffer, float* P, float* dPdu, float* dPdv, float* ddPdudu, float* ddPdvdv, float* ddPdudv, size_t numFloats);
+
+  public:
+
+    /*! returns number of points */
+    __forceinline size_t size() const {
+      return vertices[0].size();
+    }
+
+    /*! returns the number of vertices */
+    __forceinline size_t numVertices() const {
+      return vertices[0].size();
+    }
+
+    /*! returns i'th vertex of the first time step */
+    __forceinline Vec3fa vertex(size_t i) const {
+      return vertices0[i];
+    }
+
+    /*! returns i'th vertex of the first time step */
+    __forceinline const char* vertexPtr(size_t i) const {
+      return vertices0.getPtr(i);
+    }
+
+    /*! returns i'th radius of the first time step */
+    __forceinline float radius(size_t i) const {
+      return vertices0[i].w;
+    }
+
+    /*! returns i'th vertex of itime'th timestep */
+    __forceinline Vec3fa vertex(size_t i, size_t itime) const {
+      return vertices[itime][i];
+    }
+
+    /*! returns i'th radius of itime'th timestep */
+    __forceinline float radius(size_t i, size_t itime) const {
+      return vertices[itime][i].w;
+    }
+
+    /*! calculates bounding box of i'th point */
+    __forceinline BBox3fa bounds(size_t i) const
+    {
+      const Vec3fa v = vertex(i);
+      return enlarge(BBox3fa(v),Vec3fa(v.w));
+    }
+
+    /*! calculates bounding box of i'th point for the itime'th time step */
+    __forceinline BBox3fa bounds(size_t i, size_t itime) const
+    {
+      const Vec3fa v = vertex(i,itime);
+      return enlarge(BBox3fa(v),Vec3fa(v.w));
+    }
+
+    /*! check if the i'th primitive is valid at the itime'th time step */
+    __forceinline bool valid(size_t i, size_t itime) const
+    {
+      const Vec3fa v = vertex(i,itime); 
+      if (unlikely(!isvalid((vfloat4)v))) return false;
+      if (v.w < 0.0f) return false;
+      return true;
+    }
+
+    /*! calculates the build bounds of the i'th primitive, if it's valid */
+    __forceinline bool buildBounds(size_t i, BBox3fa* bbox) const
+    {
+      if (!valid(i,0)) return false;
+      *bbox = bounds(i); 
+      return true;
+    }
+
+  public:
+    SubType subtype;                                  //!< spheres or discs
+    BufferRefT<Vec3fa> vertices0;                     //!< fast access to first vertex buffer
+    vector<APIBuffer<Vec3fa>> vertices;               //!< vertex array for each timestep
+    array_t<std::unique_ptr<APIBuffer<char>>,2> userbuffers; //!< user buffers // FIXME: no std::unique_ptr here
+  };
+}
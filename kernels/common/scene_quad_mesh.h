@@ -168,6 +168,37 @@ namespace embree
       return true;
     }
 
+    /*! calculates the build bounds of the num<=4 primitives starting at the i'th primitive, returns which of them are valid */
+    __forceinline vbool4 buildBounds4(size_t i, size_t num, Vec3vf4& lower, Vec3vf4& upper) const
+    {
+      assert(numTimeSteps == 1 && num > 0 && num <= 4);
+      const Quad& q0 = quad(i+0);
+      const Quad& q1 = quad(i+min(size_t(1),num-1));
+      const Quad& q2 = quad(i+min(size_t(2),num-1));
+      const Quad& q3 = quad(i+min(size_t(3),num-1));
+      const vint4 i0(q0.v[0],q1.v[0],q2.v[0],q3.v[0]);
+      const vint4 i1(q0.v[1],q1.v[1],q2.v[1],q3.v[1]);
+      const vint4 i2(q0.v[2],q1.v[2],q2.v[2],q3.v[2]);
+      const vint4 i3(q0.v[3],q1.v[3],q2.v[3],q3.v[3]);
+
+      /* indices are unsigned, thus out of range indices are either negative or too large */
+      const vint4 nv = vint4(int(numVertices()));
+      vbool4 valid = vint4(step) < vint4(int(num));
+      valid &= (i0 >= vint4(zero)) & (i0 < nv) & (i1 >= vint4(zero)) & (i1 < nv);
+      valid &= (i2 >= vint4(zero)) & (i2 < nv) & (i3 >= vint4(zero)) & (i3 < nv);
+      if (none(valid)) return valid;
+
+      const auto ptr = [&] (int j) { return vertexPtr(j); };
+      Vec3vf4 v0, v1, v2, v3;
+      valid &= gatherVertices4(ptr,select(valid,i0,vint4(zero)),v0);
+      valid &= gatherVertices4(ptr,select(valid,i1,vint4(zero)),v1);
+      valid &= gatherVertices4(ptr,select(valid,i2,vint4(zero)),v2);
+      valid &= gatherVertices4(ptr,select(valid,i3,vint4(zero)),v3);
+      lower = min(min(v0,v1),min(v2,v3));
+      upper = max(max(v0,v1),max(v2,v3));
+      return valid;
+    }
+
     /*! calculates the build bounds of the i'th primitive at the itime'th time segment, if it's valid */
     __forceinline bool buildBounds(size_t i, size_t itime, BBox3fa& bbox) const
     {
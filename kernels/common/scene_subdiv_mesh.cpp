@@ -25,6 +25,19 @@
 
 namespace embree
 {
+  /*! unique identifiers of half edge structures, 0 marks an empty stencil cache */
+  static std::atomic<size_t> nextTopologyID(1);
+
+  /*! per thread cache of the stencil of the last interpolated face */
+  struct InterpolationStencilCache
+  {
+    size_t topologyID;
+    unsigned primID;
+    bool regular;
+    BSplineStencil stencil;
+  };
+  static __thread InterpolationStencilCache interpolationStencilCache;
+
   SubdivMesh::SubdivMesh (Scene* parent, RTCGeometryFlags flags, size_t numFaces, size_t numEdges, size_t numVertices, 
 			  size_t numEdgeCreases, size_t numVertexCreases, size_t numHoles, size_t numTimeSteps)
     : Geometry(parent,SUBDIV_MESH,numFaces,numTimeSteps,flags), 
@@ -40,7 +53,8 @@ namespace embree
       faceStartEdge(parent->device),
       halfEdges(parent->device),
       invalid_face(parent->device),
-      levelUpdate(false)
+      levelUpdate(false),
+      topologyID(nextTopologyID++)
   {
     vertices.resize(numTimeSteps);
     vertex_buffer_tags.resize(numTimeSteps);
@@ -485,6 +499,11 @@ namespace embree
     /* now either recalculate or update the half edges */
     if (recalculate) calculateHalfEdges();
     else if (update) updateHalfEdges();
+    if (recalculate || update) topologyID = nextTopologyID++;
+
+    /* grid stencils are kept per face and get calculated by the builders */
+    if (useGridStencils()) grid_stencils.resize(numFaces);
+    else grid_stencils.clear();
 
     /* create interpolation cache mapping for interpolatable meshes */
     if (parent->isInterpolatable()) 
@@ -584,6 +603,22 @@ namespace embree
     return true;
   }
 
+  bool SubdivMesh::useGridStencils() const {
+    return isDeformable() && parent->device->subdiv_stencil_tables && !displFunc && !displFunc2 && patch_eval_trees.size() == 0;
+  }
+
+  const BSplineStencil* SubdivMesh::getInterpolationStencil(unsigned primID) const
+  {
+    InterpolationStencilCache& cache = interpolationStencilCache;
+    if (cache.topologyID != topologyID || cache.primID != primID) 
+    {
+      cache.topologyID = topologyID;
+      cache.primID = primID;
+      cache.regular = cache.stencil.init(getHalfEdge(primID));
+    }
+    return cache.regular ? &cache.stencil : nullptr;
+  }
+
   void SubdivMesh::interpolate(unsigned primID, float u, float v, RTCBufferType buffer, float* P, float* dPdu, float* dPdv, float* ddPdudu, float* ddPdvdv, float* ddPdudv, size_t numFloats) 
   {
     /* test if interpolation is enabled */
@@ -609,17 +644,29 @@ namespace embree
       baseEntry = &vertex_buffer_tags[bufID];
     }
 
+    /* regular faces are evaluated directly from the buffer, without going through the tessellation cache */
+    const BSplineStencil* stencil = getInterpolationStencil(primID);
+
     for (size_t i=0; i<numFloats; i+=4)
     {
       vfloat4 Pt, dPdut, dPdvt, ddPdudut, ddPdvdvt, ddPdudvt;
-      isa::PatchEval<vfloat4,vfloat4>(baseEntry->at(interpolationSlot(primID,i/4,stride)),parent->commitCounterSubdiv,
-                                      getHalfEdge(primID),src+i*sizeof(float),stride,u,v,
-                                      P ? &Pt : nullptr, 
-                                      dPdu ? &dPdut : nullptr, 
-                                      dPdv ? &dPdvt : nullptr,
-                                      ddPdudu ? &ddPdudut : nullptr, 
-                                      ddPdvdv ? &ddPdvdvt : nullptr, 
-                                      ddPdudv ? &ddPdudvt : nullptr);
+      if (stencil)
+        BSplinePatchT<vfloat4,vfloat4>(*stencil,src+i*sizeof(float),stride).eval(u,v,
+                                                                                 P ? &Pt : nullptr, 
+                                                                                 dPdu ? &dPdut : nullptr, 
+                                                                                 dPdv ? &dPdvt : nullptr,
+                                                                                 ddPdudu ? &ddPdudut : nullptr, 
+                                                                                 ddPdvdv ? &ddPdvdvt : nullptr, 
+                                                                                 ddPdudv ? &ddPdudvt : nullptr);
+      else
+        isa::PatchEval<vfloat4,vfloat4>(baseEntry->at(interpolationSlot(primID,i/4,stride)),parent->commitCounterSubdiv,
+                                        getHalfEdge(primID),src+i*sizeof(float),stride,u,v,
+                                        P ? &Pt : nullptr, 
+                                        dPdu ? &dPdut : nullptr, 
+                                        dPdv ? &dPdvt : nullptr,
+                                        ddPdudu ? &ddPdudut : nullptr, 
+                                        ddPdvdv ? &ddPdvdvt : nullptr, 
+                                        ddPdudv ? &ddPdudvt : nullptr);
 
       if (P) {
         for (size_t j=i; j<min(i+4,numFloats); j++) 
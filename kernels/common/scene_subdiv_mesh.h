@@ -147,6 +147,9 @@ namespace embree
       return &halfEdges[faceStartEdge[f]]; 
     }    
 
+    /*! returns the per thread cached stencil of a regular interior face, or nullptr for all other faces */
+    const BSplineStencil* getInterpolationStencil(unsigned primID) const;
+
     /*! returns the vertex buffer for some time step */
     __forceinline const BufferRefT<Vec3fa>& getVertexBuffer( const size_t t = 0 ) const {
       return vertices[t];
@@ -249,6 +252,57 @@ namespace embree
     std::vector<std::vector<SharedLazyTessellationCache::CacheEntry>> vertex_buffer_tags;
     std::vector<SharedLazyTessellationCache::CacheEntry> user_buffer_tags[2];
     std::vector<Patch3fa::Ref> patch_eval_trees;
+
+    /*! identifies the current half edge structure, used to validate cached interpolation stencils */
+    size_t topologyID;
+
+    /*! limit stencils of all vertices of the tessellation grid of some sub patch */
+    struct GridStencil
+    {
+      GridStencil () 
+        : topologyID(0), width(0), height(0), valid(false) {}
+
+      /*! tests if the stencil got calculated for the specified half edge structure and tessellation levels */
+      __forceinline bool matches(size_t topologyID, const float level[4]) const {
+        return this->topologyID == topologyID && 
+          this->level[0] == level[0] && this->level[1] == level[1] && this->level[2] == level[2] && this->level[3] == level[3];
+      }
+
+    public:
+      size_t topologyID;              //!< half edge structure the stencil got calculated for
+      float level[4];                 //!< tessellation levels the stencil got calculated for
+      unsigned width, height;         //!< resolution of the tessellation grid
+      bool valid;                     //!< false if the sub patch cannot be represented by a stencil
+      std::vector<unsigned> indices;  //!< control vertices the sub patch depends on
+      avector<float> weights;         //!< for each control vertex one row with the weights of all grid vertices
+      avector<float> grid_u;          //!< u coordinates of all grid vertices
+      avector<float> grid_v;          //!< v coordinates of all grid vertices
+    };
+
+    /*! checks if grid stencils get precomputed for this mesh */
+    bool useGridStencils() const;
+
+    /*! returns the grid stencil of some sub patch for modification */
+    __forceinline GridStencil& gridStencil(size_t prim, size_t subPatch) 
+    {
+      std::vector<GridStencil>& stencils = grid_stencils[prim];
+      if (subPatch >= stencils.size()) stencils.resize(subPatch+1);
+      return stencils[subPatch];
+    }
+
+    /*! returns the valid grid stencil of some sub patch for the specified tessellation levels, or nullptr */
+    __forceinline const GridStencil* getGridStencil(size_t prim, size_t subPatch, const float level[4]) const
+    {
+      if (grid_stencils.size() == 0 || displFunc || displFunc2) return nullptr;
+      const std::vector<GridStencil>& stencils = grid_stencils[prim];
+      if (subPatch >= stencils.size()) return nullptr;
+      const GridStencil& stencil = stencils[subPatch];
+      if (!stencil.valid || !stencil.matches(topologyID,level)) return nullptr;
+      return &stencil;
+    }
+
+    /*! grid stencils of all sub patches of each face, only used for deformable meshes */
+    std::vector<std::vector<GridStencil>> grid_stencils;
       
     /*! the following data is only required during construction of the
      *  half edge structure and can be cleared for static scenes */
@@ -49,19 +49,31 @@ namespace embree
       baseEntry = &vertex_buffer_tags[bufID];
     }
 
+    /* regular faces are evaluated directly from the buffer, without going through the tessellation cache */
+    const BSplineStencil* stencil = getInterpolationStencil(primID);
+
     for (size_t i=0,slot=0; i<numFloats; slot++)
     {
       if (i+4 >= numFloats)
       {
         vfloat4 Pt, dPdut, dPdvt, ddPdudut, ddPdvdvt, ddPdudvt;; 
-        isa::PatchEval<vfloat4>(baseEntry->at(interpolationSlot(primID,slot,stride)),parent->commitCounterSubdiv,
-                                getHalfEdge(primID),src+i*sizeof(float),stride,u,v,
-                                P ? &Pt : nullptr, 
-                                dPdu ? &dPdut : nullptr, 
-                                dPdv ? &dPdvt : nullptr,
-                                ddPdudu ? &ddPdudut : nullptr, 
-                                ddPdvdv ? &ddPdvdvt : nullptr, 
-                                ddPdudv ? &ddPdudvt : nullptr);
+        if (stencil)
+          BSplinePatchT<vfloat4,vfloat4>(*stencil,src+i*sizeof(float),stride).eval(u,v,
+                                                                                   P ? &Pt : nullptr, 
+                                                                                   dPdu ? &dPdut : nullptr, 
+                                                                                   dPdv ? &dPdvt : nullptr,
+                                                                                   ddPdudu ? &ddPdudut : nullptr, 
+                                                                                   ddPdvdv ? &ddPdvdvt : nullptr, 
+                                                                                   ddPdudv ? &ddPdudvt : nullptr);
+        else
+          isa::PatchEval<vfloat4>(baseEntry->at(interpolationSlot(primID,slot,stride)),parent->commitCounterSubdiv,
+                                  getHalfEdge(primID),src+i*sizeof(float),stride,u,v,
+                                  P ? &Pt : nullptr, 
+                                  dPdu ? &dPdut : nullptr, 
+                                  dPdv ? &dPdvt : nullptr,
+                                  ddPdudu ? &ddPdudut : nullptr, 
+                                  ddPdvdv ? &ddPdvdvt : nullptr, 
+                                  ddPdudv ? &ddPdudvt : nullptr);
         
         if (P) {
           for (size_t j=i; j<min(i+4,numFloats); j++) 
@@ -87,14 +99,23 @@ namespace embree
       else
       {
         vfloat8 Pt, dPdut, dPdvt, ddPdudut, ddPdvdvt, ddPdudvt; 
-        isa::PatchEval<vfloat8>(baseEntry->at(interpolationSlot(primID,slot,stride)),parent->commitCounterSubdiv,
-                                getHalfEdge(primID),src+i*sizeof(float),stride,u,v,
-                                P ? &Pt : nullptr, 
-                                dPdu ? &dPdut : nullptr, 
-                                dPdv ? &dPdvt : nullptr,
-                                ddPdudu ? &ddPdudut : nullptr, 
-                                ddPdvdv ? &ddPdvdvt : nullptr, 
-                                ddPdudv ? &ddPdudvt : nullptr);
+        if (stencil)
+          BSplinePatchT<vfloat8,vfloat8>(*stencil,src+i*sizeof(float),stride).eval(u,v,
+                                                                                   P ? &Pt : nullptr, 
+                                                                                   dPdu ? &dPdut : nullptr, 
+                                                                                   dPdv ? &dPdvt : nullptr,
+                                                                                   ddPdudu ? &ddPdudut : nullptr, 
+                                                                                   ddPdvdv ? &ddPdvdvt : nullptr, 
+                                                                                   ddPdudv ? &ddPdudvt : nullptr);
+        else
+          isa::PatchEval<vfloat8>(baseEntry->at(interpolationSlot(primID,slot,stride)),parent->commitCounterSubdiv,
+                                  getHalfEdge(primID),src+i*sizeof(float),stride,u,v,
+                                  P ? &Pt : nullptr, 
+                                  dPdu ? &dPdut : nullptr, 
+                                  dPdv ? &dPdvt : nullptr,
+                                  ddPdudu ? &ddPdudut : nullptr, 
+                                  ddPdvdv ? &ddPdvdvt : nullptr, 
+                                  ddPdudv ? &ddPdudvt : nullptr);
                                     
         if (P) {
           for (size_t j=i; j<i+8; j++) 
@@ -16,12 +16,14 @@
 
 #include "scene_triangle_mesh.h"
 #include "scene.h"
+#include "../../common/algorithms/parallel_sort.h"
+#include "../../common/algorithms/parallel_for.h"
 
 namespace embree
 {
 
   TriangleMesh::TriangleMesh (Scene* parent, RTCGeometryFlags flags, size_t numTriangles, size_t numVertices, size_t numTimeSteps)
-    : Geometry(parent,TRIANGLE_MESH,numTriangles,numTimeSteps,flags)
+    : Geometry(parent,TRIANGLE_MESH,numTriangles,numTimeSteps,flags), trianglePairs(parent->device)
   {
     triangles.init(parent->device,numTriangles,sizeof(Triangle));
     vertices.resize(numTimeSteps);
@@ -130,11 +132,128 @@ namespace embree
     const bool freeTriangles = !parent->needTriangleIndices;
     const bool freeVertices  = !parent->needTriangleVertices;
     if (freeTriangles) triangles.free(); 
+    clearTrianglePairs();
     if (freeVertices )
       for (auto& buffer : vertices)
         buffer.free();
   }
 
+  void TriangleMesh::buildTrianglePairs()
+  {
+    const size_t blockSize = 4096;
+    const size_t numTriangles = size();
+    const size_t numEdges = 3*numTriangles;
+    
+    /* allocate temporary arrays */
+    std::vector<KeyEdge> edges0(numEdges);
+    std::vector<KeyEdge> edges1(numEdges);
+    std::vector<uint32_t> opposite(numEdges);
+    std::vector<char> done(numTriangles);
+
+    /* create all half edges, edges of invalid triangles never match */
+    parallel_for( size_t(0), numTriangles, blockSize, [&](const range<size_t>& r) 
+    {
+      for (size_t i=r.begin(); i<r.end(); i++)
+      {
+        const Triangle& tri = triangle(i);
+        const bool valid = buildBounds(i);
+        done[i] = !valid;
+        
+        for (size_t j=0; j<3; j++)
+        {
+          const uint32_t v0 = tri.v[j];
+          const uint32_t v1 = tri.v[j<2 ? j+1 : 0];
+          const uint64_t key = valid && v0 != v1 ? Edge(v0,v1).e : std::numeric_limits<uint64_t>::max();
+          edges1[3*i+j] = KeyEdge(key,unsigned(3*i+j));
+          opposite[3*i+j] = -1;
+        }
+      }
+    });
+
+    /* sort half edges to find adjacent triangles */
+    radix_sort_u64(edges1.data(),edges0.data(),numEdges);
+
+    /* link all edges shared by exactly two consistently oriented triangles */
+    parallel_for( size_t(0), numEdges, blockSize, [&](const range<size_t>& r) 
+    {
+      /* skip if start of adjacent edges was not in our range */
+      size_t e=r.begin();
+      if (e != 0 && (edges1[e].key == edges1[e-1].key)) {
+        const uint64_t key = edges1[e].key;
+        while (e<r.end() && edges1[e].key == key) e++;
+      }
+
+      /* process all adjacent edges starting in our range */
+      while (e<r.end())
+      {
+        const uint64_t key = edges1[e].key;
+        if (key == std::numeric_limits<uint64_t>::max()) break;
+        size_t N=1; while (e+N<numEdges && edges1[e+N].key == key) N++;
+
+        if (N == 2)
+        {
+          const uint32_t e0 = edges1[e+0].edge;
+          const uint32_t e1 = edges1[e+1].edge;
+          if (triangle(e0/3).v[e0%3] != triangle(e1/3).v[e1%3]) {
+            opposite[e0] = e1;
+            opposite[e1] = e0;
+          }
+        }
+        e+=N;
+      }
+    });
+
+    /* greedily pair each triangle with its first unpaired neighbour */
+    static const uint32_t next[5] = { 1, 2, 0, 1, 2 };
+    trianglePairs.resize(numTriangles);
+    size_t numPairs = 0;
+
+    for (size_t i=0; i<numTriangles; i++)
+    {
+      if (done[i]) continue;
+      done[i] = true;
+
+      const Triangle& tri0 = triangle(i);
+      TrianglePair& pair = trianglePairs[numPairs++];
+      pair.primID[0] = unsigned(i);
+
+      size_t j=0;
+      for (; j<3; j++) {
+        const uint32_t o = opposite[3*i+j];
+        if (o != uint32_t(-1) && !done[o/3]) break;
+      }
+
+      /* unpaired triangles keep their vertex order and get a degenerated second triangle */
+      if (j == 3)
+      {
+        pair.v[0] = tri0.v[0];
+        pair.v[1] = tri0.v[1];
+        pair.v[2] = tri0.v[2];
+        pair.v[3] = tri0.v[2];
+        pair.primID[1] = -1;
+        pair.rotation = 1 | (1 << 2);
+        continue;
+      }
+
+      /* rotate both triangles such that the shared edge becomes v1 v3 */
+      const uint32_t o = opposite[3*i+j];
+      const uint32_t k = o%3;
+      const Triangle& tri1 = triangle(o/3);
+      done[o/3] = true;
+      pair.v[0] = tri0.v[next[j+1]];
+      pair.v[1] = tri0.v[j];
+      pair.v[2] = tri1.v[next[k+1]];
+      pair.v[3] = tri0.v[next[j]];
+      pair.primID[1] = o/3;
+      pair.rotation = uint32_t(j) | (k << 2);
+    }
+    trianglePairs.resize(numPairs);
+  }
+
+  void TriangleMesh::clearTrianglePairs() {
+    trianglePairs.clear();
+  }
+
   bool TriangleMesh::verify () 
   {
     /*! verify consistent size of vertex arrays */
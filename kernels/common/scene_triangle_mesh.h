@@ -96,6 +96,32 @@ namespace embree
       return -1;
     }
 
+    /*! half edge with sort key, used to find adjacent triangles */
+    struct KeyEdge
+    {
+      KeyEdge() {}
+
+      KeyEdge (uint64_t key, uint32_t edge)
+      : key(key), edge(edge) {}
+
+      __forceinline operator uint64_t() const {
+        return key;
+      }
+
+    public:
+      uint64_t key;
+      uint32_t edge; //!< 3*primID plus index of edge inside triangle
+    };
+
+    /*! two triangles sharing an edge stored in quad layout, the
+     *  first triangle is (v0,v1,v3) and the second one (v2,v3,v1) */
+    struct TrianglePair
+    {
+      uint32_t v[4];      //!< quad vertex indices
+      uint32_t primID[2]; //!< IDs of both triangles, second is -1 for an unpaired triangle
+      uint32_t rotation;  //!< rotation of first (bits 0-1) and second (bits 2-3) triangle relative to its original vertex order
+    };
+
   public:
 
     /*! triangle mesh construction */
@@ -114,6 +140,14 @@ namespace embree
     void interpolate(unsigned primID, float u, float v, RTCBufferType buffer, float* P, float* dPdu, float* dPdv, float* ddPdudu, float* ddPdvdv, float* ddPdudv, size_t numFloats);
     // FIXME: implement interpolateN
 
+  public:
+
+    /*! greedily pairs adjacent triangles, unpaired triangles are stored as degenerated pairs */
+    void buildTrianglePairs();
+
+    /*! releases the triangle pairs */
+    void clearTrianglePairs();
+
   public:
 
     /*! returns number of triangles */
@@ -151,6 +185,27 @@ namespace embree
       return vertices[itime].getPtr(i);
     }
 
+    /*! returns number of triangle pairs */
+    __forceinline size_t numTrianglePairs() const {
+      return trianglePairs.size();
+    }
+
+    /*! returns i'th triangle pair */
+    __forceinline const TrianglePair& trianglePair(size_t i) const {
+      return trianglePairs[i];
+    }
+
+    /*! calculates the bounds of the i'th triangle pair */
+    __forceinline BBox3fa trianglePairBounds(size_t i) const
+    {
+      const TrianglePair& pair = trianglePair(i);
+      const Vec3fa v0 = vertex(pair.v[0]);
+      const Vec3fa v1 = vertex(pair.v[1]);
+      const Vec3fa v2 = vertex(pair.v[2]);
+      const Vec3fa v3 = vertex(pair.v[3]);
+      return BBox3fa(min(v0,v1,v2,v3),max(v0,v1,v2,v3));
+    }
+
     /*! calculates the bounds of the i'th triangle */
     __forceinline BBox3fa bounds(size_t i) const 
     {
@@ -218,6 +273,34 @@ namespace embree
       return true;
     }
 
+    /*! calculates the build bounds of the num<=4 primitives starting at the i'th primitive, returns which of them are valid */
+    __forceinline vbool4 buildBounds4(size_t i, size_t num, Vec3vf4& lower, Vec3vf4& upper) const
+    {
+      assert(numTimeSteps == 1 && num > 0 && num <= 4);
+      const Triangle& t0 = triangle(i+0);
+      const Triangle& t1 = triangle(i+min(size_t(1),num-1));
+      const Triangle& t2 = triangle(i+min(size_t(2),num-1));
+      const Triangle& t3 = triangle(i+min(size_t(3),num-1));
+      const vint4 i0(t0.v[0],t1.v[0],t2.v[0],t3.v[0]);
+      const vint4 i1(t0.v[1],t1.v[1],t2.v[1],t3.v[1]);
+      const vint4 i2(t0.v[2],t1.v[2],t2.v[2],t3.v[2]);
+
+      /* indices are unsigned, thus out of range indices are either negative or too large */
+      const vint4 nv = vint4(int(numVertices()));
+      vbool4 valid = vint4(step) < vint4(int(num));
+      valid &= (i0 >= vint4(zero)) & (i0 < nv) & (i1 >= vint4(zero)) & (i1 < nv) & (i2 >= vint4(zero)) & (i2 < nv);
+      if (none(valid)) return valid;
+
+      const auto ptr = [&] (int j) { return vertexPtr(j); };
+      Vec3vf4 v0, v1, v2;
+      valid &= gatherVertices4(ptr,select(valid,i0,vint4(zero)),v0);
+      valid &= gatherVertices4(ptr,select(valid,i1,vint4(zero)),v1);
+      valid &= gatherVertices4(ptr,select(valid,i2,vint4(zero)),v2);
+      lower = min(min(v0,v1),v2);
+      upper = max(max(v0,v1),v2);
+      return valid;
+    }
+
     /*! calculates the build bounds of the i'th primitive at the itime'th time segment, if it's valid */
     __forceinline bool buildBounds(size_t i, size_t itime, BBox3fa& bbox) const
     {
@@ -256,5 +339,6 @@ namespace embree
     BufferRefT<Vec3fa> vertices0;                     //!< fast access to first vertex buffer
     vector<APIBuffer<Vec3fa>> vertices;               //!< vertex array for each timestep
     array_t<std::unique_ptr<APIBuffer<char>>,2> userbuffers; //!< user buffers // FIXME: no std::unique_ptr here
+    mvector<TrianglePair> trianglePairs;              //!< adjacent triangles paired up for the triangle pair accels
   };
 }
@@ -15,6 +15,7 @@
 // ======================================================================== //
 
 #include "stat.h"
+#include "context.h"
 
 namespace embree
 {
@@ -45,6 +46,9 @@ namespace embree
 
     cout << "    #stack nodes  = " << float(cntrs.code.normal.trav_stack_nodes )*1E-6 << "M" << std::endl;
     cout << "    #stack pop    = " << float(cntrs.code.normal.trav_stack_pop )*1E-6 << "M" << std::endl;
+    cout << "    #leaf packets = " << float(cntrs.code.normal.trav_leaf_packets)*1E-6 << "M" << std::endl;
+    cout << "    #compactions  = " << float(cntrs.code.normal.trav_compactions )*1E-6 << "M" << std::endl;
+    cout << "    #restarts     = " << float(cntrs.code.normal.trav_restarts    )*1E-6 << "M" << std::endl;
 
     size_t normal_box_hits = 0;
     size_t weighted_box_hits = 0;
@@ -74,6 +78,11 @@ namespace embree
 
       cout << "    #stack nodes = " << float(cntrs.code.shadow.trav_stack_nodes )*1E-6 << "M" << std::endl;
       cout << "    #stack pop   = " << float(cntrs.code.shadow.trav_stack_pop )*1E-6 << "M" << std::endl;
+      cout << "    #leaf packets = " << float(cntrs.code.shadow.trav_leaf_packets)*1E-6 << "M" << std::endl;
+      cout << "    #compactions  = " << float(cntrs.code.shadow.trav_compactions )*1E-6 << "M" << std::endl;
+      cout << "    #restarts     = " << float(cntrs.code.shadow.trav_restarts    )*1E-6 << "M" << std::endl;
+      cout << "    #cache tests  = " << float(cntrs.code.shadow.trav_cache_tests )*1E-6 << "M" << std::endl;
+      cout << "    #cache hits   = " << float(cntrs.code.shadow.trav_cache_hits  )*1E-6 << "M" << std::endl;
 
       size_t shadow_box_hits = 0;
       size_t weighted_shadow_box_hits = 0;
@@ -108,6 +117,10 @@ namespace embree
     cout << "    #prim_hits    = " << float(cntrs.all.normal.trav_prim_hits  )/float(cntrs.all.normal.travs) << ", " << 100.0f*active_normal_trav_prim_hits   << "% active" << std::endl;
     cout << "    #stack_pop    = " << float(cntrs.all.normal.trav_stack_pop  )/float(cntrs.all.normal.travs) << ", " << 100.0f*active_normal_trav_stack_pop   << "% active" << std::endl;
 
+    /* lane occupancy of the ray packets intersected with leaves by the stream traversal */
+    if (cntrs.all.normal.trav_leaf_packets)
+      cout << "    #leaf_packets = " << float(cntrs.code.normal.trav_leaf_packets) << ", " << 100.0f*float(cntrs.active.normal.trav_leaf_packets)/float(cntrs.all.normal.trav_leaf_packets) << "% active" << std::endl;
+
     if (cntrs.all.shadow.travs) {
       float active_shadow_travs       = float(cntrs.active.shadow.travs      )/float(cntrs.all.shadow.travs      );
       float active_shadow_trav_nodes  = float(cntrs.active.shadow.trav_nodes )/float(cntrs.all.shadow.trav_nodes );
@@ -124,6 +137,8 @@ namespace embree
       cout << "    #prim_hits  = " << float(cntrs.all.shadow.trav_prim_hits  )/float(cntrs.all.shadow.travs) << ", " << 100.0f*active_shadow_trav_prim_hits   << "% active" << std::endl;
 
     }
+    if (cntrs.all.shadow.trav_leaf_packets)
+      cout << "  #shadow_leaf_packets = " << float(cntrs.code.shadow.trav_leaf_packets) << ", " << 100.0f*float(cntrs.active.shadow.trav_leaf_packets)/float(cntrs.all.shadow.trav_leaf_packets) << "% active" << std::endl;
     cout << std::endl;
 
      /* print user counters for performance tuning */
@@ -136,4 +151,128 @@ namespace embree
     cout << "#user7/user3 " << 100.0f*float(cntrs.user[7])/float(cntrs.user[3]) << "%" << std::endl;
     cout << std::endl;
   }
+
+  /*! costs of one scene gathered by one thread */
+  struct SceneCosts
+  {
+    __forceinline CostCounters::Costs& geometry(unsigned geomID) 
+    {
+      if (unlikely(geomID >= geometries.size())) geometries.resize(geomID+1);
+      return geometries[geomID];
+    }
+
+  public:
+    CostCounters::Costs scene;
+    std::vector<CostCounters::Costs> geometries;
+  };
+
+  /*! costs of all scenes gathered by one thread */
+  struct ThreadCosts
+  {
+    ThreadCosts () 
+      : lastScene(nullptr), last(nullptr), instScene(nullptr), instID(-1) {}
+
+    __forceinline SceneCosts& get(Scene* scene)
+    {
+      if (likely(scene == lastScene)) return *last;
+      Lock<SpinLock> lock(mutex);
+      last = &scenes[scene];
+      lastScene = scene;
+      return *last;
+    }
+
+  public:
+    SpinLock mutex;                     //!< protects the scene map against concurrent clears
+    std::map<Scene*,SceneCosts> scenes; //!< costs per scene
+    Scene* lastScene;                   //!< most recently charged scene
+    SceneCosts* last;                   //!< costs of most recently charged scene
+    Scene* instScene;                   //!< scene of outermost active instance
+    unsigned instID;                    //!< ID of outermost active instance
+  };
+
+  static MutexSys g_thread_costs_mutex;
+  static std::vector<ThreadCosts*> g_thread_costs;
+  static __thread ThreadCosts* t_thread_costs = nullptr;
+
+  static __forceinline ThreadCosts& threadCosts()
+  {
+    if (unlikely(t_thread_costs == nullptr)) 
+    {
+      t_thread_costs = new ThreadCosts;
+      Lock<MutexSys> lock(g_thread_costs_mutex);
+      g_thread_costs.push_back(t_thread_costs);
+    }
+    return *t_thread_costs;
+  }
+
+  /*! returns the costs of the geometry or instance that gets charged for the specified geometry */
+  static __forceinline CostCounters::Costs& geometryCosts(ThreadCosts& costs, const IntersectContext* context, unsigned geomID)
+  {
+    if (costs.instScene) return costs.get(costs.instScene).geometry(costs.instID);
+    if (context->geomID_to_instID) return costs.get(context->scene).geometry(context->geomID_to_instID[0]);
+    return costs.get(context->scene).geometry(geomID);
+  }
+
+  void CostCounters::nodes(const IntersectContext* context, size_t n)
+  {
+    ThreadCosts& costs = threadCosts();
+    if (costs.instScene || context->geomID_to_instID) geometryCosts(costs,context,-1).nodes += n;
+    else costs.get(context->scene).scene.nodes += n;
+  }
+
+  void CostCounters::prims(const IntersectContext* context, unsigned geomID, size_t n) {
+    geometryCosts(threadCosts(),context,geomID).prims += n;
+  }
+
+  void CostCounters::filters(const IntersectContext* context, unsigned geomID, size_t n) {
+    geometryCosts(threadCosts(),context,geomID).filters += n;
+  }
+
+  CostCounters::Instance::Instance (Scene* scene, unsigned instID)
+  {
+    ThreadCosts& costs = threadCosts();
+    active = costs.instScene == nullptr;
+    if (!active) return;
+    costs.instScene = scene;
+    costs.instID = instID;
+  }
+
+  CostCounters::Instance::~Instance () 
+  {
+    if (active) t_thread_costs->instScene = nullptr;
+  }
+
+  void CostCounters::merge(Scene* scene, Costs* geometries, size_t numGeometries, Costs& scene_o)
+  {
+    Lock<MutexSys> lock(g_thread_costs_mutex);
+    for (ThreadCosts* costs : g_thread_costs)
+    {
+      Lock<SpinLock> lock(costs->mutex);
+      auto i = costs->scenes.find(scene);
+      if (i == costs->scenes.end()) continue;
+
+      /* counters get reset instead of erased to keep the cached scene valid */
+      SceneCosts& scosts = i->second;
+      scene_o += scosts.scene;
+      scosts.scene = Costs();
+      for (size_t g=0; g<scosts.geometries.size(); g++) {
+        if (g < numGeometries) geometries[g] += scosts.geometries[g];
+        scosts.geometries[g] = Costs();
+      }
+    }
+  }
+
+  void CostCounters::clear(Scene* scene)
+  {
+    Lock<MutexSys> lock(g_thread_costs_mutex);
+    for (ThreadCosts* costs : g_thread_costs)
+    {
+      Lock<SpinLock> lock(costs->mutex);
+      costs->scenes.erase(scene);
+      if (costs->lastScene == scene) {
+        costs->lastScene = nullptr;
+        costs->last = nullptr;
+      }
+    }
+  }
 }
@@ -32,8 +32,18 @@
 #  define STAT_USER(i,x) 
 #endif
 
+/* Makros to gather traversal costs per geometry */
+#ifdef EMBREE_COST_COUNTERS
+#  define COST(x) x
+#else
+#  define COST(x)
+#endif
+
 namespace embree
 {
+  class Scene;
+  struct IntersectContext;
+
   /*! Gathers ray tracing statistics. We count 1) how often a code
    *  location is reached, 2) how many SIMD lanes are active, 3) how
    *  many SIMD lanes reach the code location */
@@ -76,6 +86,11 @@ namespace embree
 	    std::atomic<size_t> trav_stack_pop;
 	    std::atomic<size_t> trav_stack_nodes; 
             std::atomic<size_t> trav_xfm_nodes; 
+            std::atomic<size_t> trav_leaf_packets;
+            std::atomic<size_t> trav_compactions;
+            std::atomic<size_t> trav_restarts;
+            std::atomic<size_t> trav_cache_tests;
+            std::atomic<size_t> trav_cache_hits;
 	  } normal, shadow;
 	} all, active, code; 
 
@@ -100,4 +115,57 @@ namespace embree
   private:
     static Stat instance;
   };
+
+  /*! Gathers traversal costs per geometry. Each thread accumulates
+   *  node visits, primitive tests, and filter invocations into its
+   *  own counters, which get merged and cleared by rtcGetCosts after
+   *  a frame. Work done inside an instanced scene is charged to the
+   *  outermost instance, node visits of the top level BVH are charged
+   *  to the scene itself. */
+  class CostCounters
+  {
+  public:
+
+    struct Costs 
+    {
+      __forceinline Costs () 
+        : nodes(0), prims(0), filters(0) {}
+
+      __forceinline Costs& operator+= (const Costs& other) {
+        nodes += other.nodes; prims += other.prims; filters += other.filters; return *this;
+      }
+
+    public:
+      size_t nodes;    //!< number of ray/node tests
+      size_t prims;    //!< number of ray/primitive tests
+      size_t filters;  //!< number of filter function and opacity mask invocations
+    };
+
+    /*! charges n ray/node tests */
+    static void nodes(const IntersectContext* context, size_t n);
+
+    /*! charges n ray/primitive tests of the specified geometry */
+    static void prims(const IntersectContext* context, unsigned geomID, size_t n);
+
+    /*! charges n filter invocations of the specified geometry */
+    static void filters(const IntersectContext* context, unsigned geomID, size_t n);
+
+    /*! charges all work done in its lifetime to the specified
+     *  instance, unless an outer instance is already active */
+    class Instance
+    {
+    public:
+      Instance (Scene* scene, unsigned instID);
+      ~Instance ();
+
+    private:
+      bool active;
+    };
+
+    /*! merges and clears the counters of all threads for the specified scene */
+    static void merge(Scene* scene, Costs* geometries, size_t numGeometries, Costs& scene_o);
+
+    /*! drops the counters of all threads for the specified scene */
+    static void clear(Scene* scene);
+  };
 }
@@ -71,6 +71,9 @@ namespace embree
     line_accel_mb = "default";
     line_builder_mb = "default";
     line_traverser_mb = "default";
+
+    point_accel = "default";
+    point_builder = "default";
     
     hair_accel = "default";
     hair_builder = "default";
@@ -89,6 +92,13 @@ namespace embree
     object_accel_mb_max_leaf_size = 1;
 
     max_spatial_split_replications = 2.0f;
+    compact_build_threshold = 0;
+    sweep_build_threshold = 64*1024;
+    max_time_splits = 1;
+    short_stack_traversal = false;
+    occluder_cache = false;
+    tri_pairs = false;
+    tiny_scene_threshold = 16;
 
     tessellation_cache_size = 128*1024*1024;
 
@@ -101,6 +111,7 @@ namespace embree
 
     subdiv_accel = "default";
     subdiv_accel_mb = "default";
+    subdiv_stencil_tables = true;
 
     float_exceptions = false;
     scene_flags = -1;
@@ -288,6 +299,11 @@ namespace embree
         line_builder_mb = cin->get().Identifier();
       else if ((tok == Token::Id("line_traverser_mb")) && cin->trySymbol("="))
         line_traverser_mb = cin->get().Identifier();
+
+      else if ((tok == Token::Id("point_accel")) && cin->trySymbol("="))
+        point_accel = cin->get().Identifier();
+      else if ((tok == Token::Id("point_builder")) && cin->trySymbol("="))
+        point_builder = cin->get().Identifier();
       
       else if (tok == Token::Id("hair_accel") && cin->trySymbol("="))
         hair_accel = cin->get().Identifier();
@@ -321,6 +337,8 @@ namespace embree
         subdiv_accel = cin->get().Identifier();
       else if (tok == Token::Id("subdiv_accel_mb") && cin->trySymbol("="))
         subdiv_accel_mb = cin->get().Identifier();
+      else if (tok == Token::Id("subdiv_stencil_tables") && cin->trySymbol("="))
+        subdiv_stencil_tables = cin->get().Int();
       
       else if (tok == Token::Id("verbose") && cin->trySymbol("="))
         verbose = cin->get().Int();
@@ -345,6 +363,20 @@ namespace embree
 
       else if (tok == Token::Id("max_spatial_split_replications") && cin->trySymbol("="))
         max_spatial_split_replications = cin->get().Float();
+      else if (tok == Token::Id("compact_build_threshold") && cin->trySymbol("="))
+        compact_build_threshold = cin->get().Int();
+      else if (tok == Token::Id("sweep_build_threshold") && cin->trySymbol("="))
+        sweep_build_threshold = cin->get().Int();
+      else if (tok == Token::Id("max_time_splits") && cin->trySymbol("="))
+        max_time_splits = cin->get().Int();
+      else if (tok == Token::Id("short_stack_traversal") && cin->trySymbol("="))
+        short_stack_traversal = cin->get().Int();
+      else if (tok == Token::Id("occluder_cache") && cin->trySymbol("="))
+        occluder_cache = cin->get().Int();
+      else if (tok == Token::Id("tri_pairs") && cin->trySymbol("="))
+        tri_pairs = cin->get().Int();
+      else if (tok == Token::Id("tiny_scene_threshold") && cin->trySymbol("="))
+        tiny_scene_threshold = cin->get().Int();
 
       else if (tok == Token::Id("tessellation_cache_size") && cin->trySymbol("="))
         tessellation_cache_size = size_t(cin->get().Float()*1024.0f*1024.0f);
@@ -368,6 +400,13 @@ namespace embree
     std::cout << "  verbosity     = " << verbose << std::endl;
     std::cout << "  cache_size    = " << float(tessellation_cache_size)*1E-6 << " MB" << std::endl;
     std::cout << "  max_spatial_split_replications = " << max_spatial_split_replications << std::endl;
+    std::cout << "  compact_build_threshold = " << compact_build_threshold << std::endl;
+    std::cout << "  sweep_build_threshold = " << sweep_build_threshold << std::endl;
+    std::cout << "  max_time_splits = " << max_time_splits << std::endl;
+    std::cout << "  short_stack_traversal = " << short_stack_traversal << std::endl;
+    std::cout << "  occluder_cache = " << occluder_cache << std::endl;
+    std::cout << "  tri_pairs = " << tri_pairs << std::endl;
+    std::cout << "  tiny_scene_threshold = " << tiny_scene_threshold << std::endl;
     
     std::cout << "triangles:" << std::endl;
     std::cout << "  accel         = " << tri_accel << std::endl;
@@ -398,6 +437,10 @@ namespace embree
     std::cout << "  accel         = " << line_accel_mb << std::endl;
     std::cout << "  builder       = " << line_builder_mb << std::endl;
     std::cout << "  traverser     = " << line_traverser_mb << std::endl;
+
+    std::cout << "points:" << std::endl;
+    std::cout << "  accel         = " << point_accel << std::endl;
+    std::cout << "  builder       = " << point_builder << std::endl;
     
     std::cout << "hair:" << std::endl;
     std::cout << "  accel         = " << hair_accel << std::endl;
@@ -411,6 +454,7 @@ namespace embree
     
     std::cout << "subdivision surfaces:" << std::endl;
     std::cout << "  accel         = " << subdiv_accel << std::endl;
+    std::cout << "  stencil_tables = " << subdiv_stencil_tables << std::endl;
 
     std::cout << "object_accel:" << std::endl;
     std::cout << "  min_leaf_size = " << object_accel_min_leaf_size << std::endl;
@@ -80,6 +80,10 @@ namespace embree
     std::string line_builder_mb;           //!< builder to use for motion blur line segments
     std::string line_traverser_mb;         //!< traverser to use for motion blur line segments
 
+  public:
+    std::string point_accel;               //!< acceleration structure to use for spheres and discs
+    std::string point_builder;             //!< builder to use for spheres and discs
+
   public:
     std::string hair_accel;                //!< hair acceleration structure to use
     std::string hair_builder;              //!< builder to use for hair
@@ -103,9 +107,17 @@ namespace embree
   public:
     std::string subdiv_accel;              //!< acceleration structure to use for subdivision surfaces
     std::string subdiv_accel_mb;           //!< acceleration structure to use for subdivision surfaces
+    bool subdiv_stencil_tables;            //!< deformable subdivision meshes precompute the limit stencils of their tessellation grids
 
   public:
     float max_spatial_split_replications;  //!< maximally replications*N many primitives in accel for spatial splits
+    size_t compact_build_threshold;        //!< SAH builds with more primitives build their upper levels using compact primrefs (0 disables)
+    size_t sweep_build_threshold;          //!< high quality builds find object splits of nodes with at least this many primitives by a full SAH sweep (0 disables)
+    size_t max_time_splits;                //!< maximal number of temporal splits per time segment of motion blur SAH builds (1 disables)
+    bool short_stack_traversal;            //!< single ray traversal uses a short stack with restarts instead of a full traversal stack
+    bool occluder_cache;                   //!< single ray occlusion queries first test the leaf that occluded the previous ray of the thread
+    bool tri_pairs;                        //!< default static triangle accel pairs adjacent triangles of a mesh into quad leaves
+    size_t tiny_scene_threshold;           //!< static scenes with at most this many triangles and quads get build by the calling thread into a single node (0 disables)
     size_t tessellation_cache_size;        //!< size of the shared tessellation cache 
 
   public:
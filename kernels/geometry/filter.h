@@ -37,7 +37,7 @@ namespace embree
   typedef void (*ISPCFilterFunc16)(void* ptr, RTCRay16& ray, __m128i valid); // mask passed as 16 bytes
 #endif
 
-    __forceinline bool runIntersectionFilter1(const Geometry* const geometry, Ray& ray, IntersectContext* context,
+    __forceinline bool invokeIntersectionFilter1(const Geometry* const geometry, Ray& ray, IntersectContext* context,
                                               const float& u, const float& v, const float& t, const Vec3fa& Ng, const int geomID, const int primID)
     {
       if (likely(geometry->intersectionFilter1)) // old code for compatibility
@@ -79,7 +79,7 @@ namespace embree
       }
     }
     
-    __forceinline bool runOcclusionFilter1(const Geometry* const geometry, Ray& ray, IntersectContext* context,
+    __forceinline bool invokeOcclusionFilter1(const Geometry* const geometry, Ray& ray, IntersectContext* context,
                                            const float& u, const float& v, const float& t, const Vec3fa& Ng, const int geomID, const int primID)
     {
       if (likely(geometry->occlusionFilter1)) // old code for compatibility
@@ -119,7 +119,7 @@ namespace embree
       }
     }
 
-    __forceinline vbool4 runIntersectionFilter(const vbool4& valid, const Geometry* const geometry, Ray4& ray, IntersectContext* context,
+    __forceinline vbool4 invokeIntersectionFilter(const vbool4& valid, const Geometry* const geometry, Ray4& ray, IntersectContext* context,
                                                const vfloat4& u, const vfloat4& v, const vfloat4& t, const Vec3vf4& Ng, const int geomID, const int primID)
     {
       RTCFilterFunc4  filter4 = geometry->intersectionFilter4;
@@ -168,7 +168,7 @@ namespace embree
       }
   }
     
-    __forceinline vbool4 runOcclusionFilter(const vbool4& valid, const Geometry* const geometry, Ray4& ray, IntersectContext* context,
+    __forceinline vbool4 invokeOcclusionFilter(const vbool4& valid, const Geometry* const geometry, Ray4& ray, IntersectContext* context,
                                             const vfloat4& u, const vfloat4& v, const vfloat4& t, const Vec3vf4& Ng, const int geomID, const int primID)
     {
       RTCFilterFunc4 filter4 = geometry->occlusionFilter4;
@@ -212,7 +212,7 @@ namespace embree
       }
     }
     
-    __forceinline bool runIntersectionFilter(const Geometry* const geometry, Ray4& ray, const size_t k, IntersectContext* context,
+    __forceinline bool invokeIntersectionFilter(const Geometry* const geometry, Ray4& ray, const size_t k, IntersectContext* context,
                                              const float& u, const float& v, const float& t, const Vec3fa& Ng, const int geomID, const int primID)
     {
       const vbool4 valid(1 << k);
@@ -259,7 +259,7 @@ namespace embree
       }
     }
     
-    __forceinline bool runOcclusionFilter(const Geometry* const geometry, Ray4& ray, const size_t k, IntersectContext* context,
+    __forceinline bool invokeOcclusionFilter(const Geometry* const geometry, Ray4& ray, const size_t k, IntersectContext* context,
                                           const float& u, const float& v, const float& t, const Vec3fa& Ng, const int geomID, const int primID)
     {
       const vbool4 valid(1 << k);
@@ -303,7 +303,7 @@ namespace embree
     }
     
 #if defined(__AVX__)
-    __forceinline vbool8 runIntersectionFilter(const vbool8& valid, const Geometry* const geometry, Ray8& ray, IntersectContext* context,
+    __forceinline vbool8 invokeIntersectionFilter(const vbool8& valid, const Geometry* const geometry, Ray8& ray, IntersectContext* context,
                                              const vfloat8& u, const vfloat8& v, const vfloat8& t, const Vec3vf8& Ng, const int geomID, const int primID)
     {
       RTCFilterFunc8  filter8 = geometry->intersectionFilter8;    
@@ -351,7 +351,7 @@ namespace embree
       }
     }
     
-    __forceinline vbool8 runOcclusionFilter(const vbool8& valid, const Geometry* const geometry, Ray8& ray, IntersectContext* context,
+    __forceinline vbool8 invokeOcclusionFilter(const vbool8& valid, const Geometry* const geometry, Ray8& ray, IntersectContext* context,
                                           const vfloat8& u, const vfloat8& v, const vfloat8& t, const Vec3vf8& Ng, const int geomID, const int primID)
     {
       RTCFilterFunc8 filter8 = geometry->occlusionFilter8;
@@ -394,7 +394,7 @@ namespace embree
       }
     }
     
-    __forceinline bool runIntersectionFilter(const Geometry* const geometry, Ray8& ray, const size_t k, IntersectContext* context,
+    __forceinline bool invokeIntersectionFilter(const Geometry* const geometry, Ray8& ray, const size_t k, IntersectContext* context,
                                              const float& u, const float& v, const float& t, const Vec3fa& Ng, const int geomID, const int primID)
     {
       const vbool8 valid(1 << k);
@@ -440,7 +440,7 @@ namespace embree
       }
     }
     
-    __forceinline bool runOcclusionFilter(const Geometry* const geometry, Ray8& ray, const size_t k, IntersectContext* context,
+    __forceinline bool invokeOcclusionFilter(const Geometry* const geometry, Ray8& ray, const size_t k, IntersectContext* context,
                                           const float& u, const float& v, const float& t, const Vec3fa& Ng, const int geomID, const int primID)
     {
       const vbool8 valid(1 << k);
@@ -488,7 +488,7 @@ namespace embree
 
 
 #if defined(__AVX512F__)
-    __forceinline vbool16 runIntersectionFilter(const vbool16& valid, const Geometry* const geometry, Ray16& ray, IntersectContext* context,
+    __forceinline vbool16 invokeIntersectionFilter(const vbool16& valid, const Geometry* const geometry, Ray16& ray, IntersectContext* context,
                                              const vfloat16& u, const vfloat16& v, const vfloat16& t, const Vec3vf16& Ng, const int geomID, const int primID)
     {
       RTCFilterFunc16  filter16 = geometry->intersectionFilter16;
@@ -536,7 +536,7 @@ namespace embree
       }
     }
     
-    __forceinline vbool16 runOcclusionFilter(const vbool16& valid, const Geometry* const geometry, Ray16& ray, IntersectContext* context,
+    __forceinline vbool16 invokeOcclusionFilter(const vbool16& valid, const Geometry* const geometry, Ray16& ray, IntersectContext* context,
                                              const vfloat16& u, const vfloat16& v, const vfloat16& t, const Vec3vf16& Ng, const int geomID, const int primID)
     {
       RTCFilterFunc16 filter16 = geometry->occlusionFilter16;
@@ -579,7 +579,7 @@ namespace embree
       }
     }
       
-    __forceinline bool runIntersectionFilter(const Geometry* const geometry, Ray16& ray, const size_t k, IntersectContext* context,
+    __forceinline bool invokeIntersectionFilter(const Geometry* const geometry, Ray16& ray, const size_t k, IntersectContext* context,
                                              const float& u, const float& v, const float& t, const Vec3fa& Ng, const int geomID, const int primID)
     {
       const vbool16 valid(1 << k);
@@ -625,7 +625,7 @@ namespace embree
       }
     }
     
-    __forceinline bool runOcclusionFilter(const Geometry* const geometry, Ray16& ray, const size_t k, IntersectContext* context,
+    __forceinline bool invokeOcclusionFilter(const Geometry* const geometry, Ray16& ray, const size_t k, IntersectContext* context,
                                           const float& u, const float& v, const float& t, const Vec3fa& Ng, const int geomID, const int primID)
     {
       const vbool16 valid(1 << k);
@@ -670,5 +670,133 @@ namespace embree
     }    
 #endif
 
+
+    /*! The run*Filter functions first look up the opacity mask of the
+     *  geometry. Hits in transparent regions get rejected and hits in
+     *  opaque regions get accepted right away, only hits in unknown
+     *  regions invoke the filter functions. */
+
+    __forceinline bool runIntersectionFilter1(const Geometry* const geometry, Ray& ray, IntersectContext* context,
+                                              const float& u, const float& v, const float& t, const Vec3fa& Ng, const int geomID, const int primID)
+    {
+      COST(CostCounters::filters(context,geomID,1));
+      if (unlikely(geometry->hasOpacityMask()))
+      {
+        const RTCOpacityState state = geometry->getOpacityState(primID,u,v);
+        if (state == RTC_OPACITY_TRANSPARENT) return false;
+        if (state == RTC_OPACITY_OPAQUE) {
+          ray.u = u;
+          ray.v = v;
+          ray.tfar = t;
+          ray.geomID = geomID;
+          ray.primID = primID;
+          ray.Ng = Ng;
+          return true;
+        }
+      }
+      return invokeIntersectionFilter1(geometry,ray,context,u,v,t,Ng,geomID,primID);
+    }
+
+    __forceinline bool runOcclusionFilter1(const Geometry* const geometry, Ray& ray, IntersectContext* context,
+                                           const float& u, const float& v, const float& t, const Vec3fa& Ng, const int geomID, const int primID)
+    {
+      COST(CostCounters::filters(context,geomID,1));
+      if (unlikely(geometry->hasOpacityMask()))
+      {
+        const RTCOpacityState state = geometry->getOpacityState(primID,u,v);
+        if (state != RTC_OPACITY_UNKNOWN) return state == RTC_OPACITY_OPAQUE;
+      }
+      return invokeOcclusionFilter1(geometry,ray,context,u,v,t,Ng,geomID,primID);
+    }
+
+    /*! returns the active rays that hit opaque regions and removes all rays that hit transparent or opaque regions from valid */
+    template<int K>
+      __forceinline vbool<K> resolveOpacityMask(vbool<K>& valid, const Geometry* const geometry, const int primID, const vfloat<K>& u, const vfloat<K>& v)
+    {
+      vbool<K> opaque = false;
+      size_t m = movemask(valid);
+      while (m) 
+      {
+        const size_t i = __bscf(m);
+        const RTCOpacityState state = geometry->getOpacityState(primID,u[i],v[i]);
+        if (state == RTC_OPACITY_UNKNOWN) continue;
+        if (state == RTC_OPACITY_OPAQUE) set(opaque,i);
+        clear(valid,i);
+      }
+      return opaque;
+    }
+
+    template<int K>
+      __forceinline vbool<K> runIntersectionFilter(const vbool<K>& valid_i, const Geometry* const geometry, RayK<K>& ray, IntersectContext* context,
+                                                   const vfloat<K>& u, const vfloat<K>& v, const vfloat<K>& t, const Vec3<vfloat<K>>& Ng, const int geomID, const int primID)
+    {
+      COST(CostCounters::filters(context,geomID,popcnt(valid_i)));
+      if (likely(!geometry->hasOpacityMask()))
+        return invokeIntersectionFilter(valid_i,geometry,ray,context,u,v,t,Ng,geomID,primID);
+
+      vbool<K> valid = valid_i;
+      const vbool<K> opaque = resolveOpacityMask(valid,geometry,primID,u,v);
+      vfloat<K>::store(opaque,&ray.u,u);
+      vfloat<K>::store(opaque,&ray.v,v);
+      vfloat<K>::store(opaque,&ray.tfar,t);
+      vint<K>::store(opaque,&ray.geomID,geomID);
+      vint<K>::store(opaque,&ray.primID,primID);
+      vfloat<K>::store(opaque,&ray.Ng.x,Ng.x);
+      vfloat<K>::store(opaque,&ray.Ng.y,Ng.y);
+      vfloat<K>::store(opaque,&ray.Ng.z,Ng.z);
+      if (none(valid)) return opaque;
+      return opaque | invokeIntersectionFilter(valid,geometry,ray,context,u,v,t,Ng,geomID,primID);
+    }
+
+    template<int K>
+      __forceinline vbool<K> runOcclusionFilter(const vbool<K>& valid_i, const Geometry* const geometry, RayK<K>& ray, IntersectContext* context,
+                                                const vfloat<K>& u, const vfloat<K>& v, const vfloat<K>& t, const Vec3<vfloat<K>>& Ng, const int geomID, const int primID)
+    {
+      COST(CostCounters::filters(context,geomID,popcnt(valid_i)));
+      if (likely(!geometry->hasOpacityMask()))
+        return invokeOcclusionFilter(valid_i,geometry,ray,context,u,v,t,Ng,geomID,primID);
+
+      vbool<K> valid = valid_i;
+      const vbool<K> opaque = resolveOpacityMask(valid,geometry,primID,u,v);
+      if (none(valid)) return opaque;
+      return opaque | invokeOcclusionFilter(valid,geometry,ray,context,u,v,t,Ng,geomID,primID);
+    }
+
+    template<int K>
+      __forceinline bool runIntersectionFilter(const Geometry* const geometry, RayK<K>& ray, const size_t k, IntersectContext* context,
+                                               const float& u, const float& v, const float& t, const Vec3fa& Ng, const int geomID, const int primID)
+    {
+      COST(CostCounters::filters(context,geomID,1));
+      if (unlikely(geometry->hasOpacityMask()))
+      {
+        const RTCOpacityState state = geometry->getOpacityState(primID,u,v);
+        if (state == RTC_OPACITY_TRANSPARENT) return false;
+        if (state == RTC_OPACITY_OPAQUE) {
+          ray.u[k] = u;
+          ray.v[k] = v;
+          ray.tfar[k] = t;
+          ray.geomID[k] = geomID;
+          ray.primID[k] = primID;
+          ray.Ng.x[k] = Ng.x;
+          ray.Ng.y[k] = Ng.y;
+          ray.Ng.z[k] = Ng.z;
+          return true;
+        }
+      }
+      return invokeIntersectionFilter(geometry,ray,k,context,u,v,t,Ng,geomID,primID);
+    }
+
+    template<int K>
+      __forceinline bool runOcclusionFilter(const Geometry* const geometry, RayK<K>& ray, const size_t k, IntersectContext* context,
+                                            const float& u, const float& v, const float& t, const Vec3fa& Ng, const int geomID, const int primID)
+    {
+      COST(CostCounters::filters(context,geomID,1));
+      if (unlikely(geometry->hasOpacityMask()))
+      {
+        const RTCOpacityState state = geometry->getOpacityState(primID,u,v);
+        if (state != RTC_OPACITY_UNKNOWN) return state == RTC_OPACITY_OPAQUE;
+      }
+      return invokeOcclusionFilter(geometry,ray,k,context,u,v,t,Ng,geomID,primID);
+    }
   }
 }
@@ -98,6 +98,7 @@ namespace embree
         const size_t dim_offset    = pre.grid->dim_offset;
         const size_t line_offset   = pre.grid->width;
         const float* const grid_x  = pre.grid->decodeLeaf(0,prim);
+        COST(CostCounters::prims(context,pre.grid->geomID,8*popcnt(valid_i)));
         const float* const grid_y  = grid_x + 1 * dim_offset;
         const float* const grid_z  = grid_x + 2 * dim_offset;
         const float* const grid_uv = grid_x + 3 * dim_offset;
@@ -126,6 +127,7 @@ namespace embree
         const size_t dim_offset    = pre.grid->dim_offset;
         const size_t line_offset   = pre.grid->width;
         const float* const grid_x  = pre.grid->decodeLeaf(0,prim);
+        COST(CostCounters::prims(context,pre.grid->geomID,8*popcnt(valid_i)));
         const float* const grid_y  = grid_x + 1 * dim_offset;
         const float* const grid_z  = grid_x + 2 * dim_offset;
         const float* const grid_uv = grid_x + 3 * dim_offset;
@@ -190,6 +192,7 @@ namespace embree
       {
         const size_t line_offset   = pre.grid->width;
         const float* const grid_x  = pre.grid->decodeLeaf(0,prim);
+        COST(CostCounters::prims(context,pre.grid->geomID,8));
 
 #if defined(__AVX__)
         intersect<GridSOA::Gather3x3>( ray, k, context, grid_x, line_offset, pre);
@@ -204,6 +207,7 @@ namespace embree
       {
         const size_t line_offset   = pre.grid->width;
         const float* const grid_x  = pre.grid->decodeLeaf(0,prim);
+        COST(CostCounters::prims(context,pre.grid->geomID,8));
 
 #if defined(__AVX__)
         return occluded<GridSOA::Gather3x3>( ray, k, context, grid_x, line_offset, pre);
@@ -288,6 +292,7 @@ namespace embree
 
         const size_t line_offset   = pre.grid->width;
         const float* const grid_x  = pre.grid->decodeLeaf(itime,prim);
+        COST(CostCounters::prims(context,pre.grid->geomID,8));
 
 #if defined(__AVX__)
         intersect<GridSOA::Gather3x3>( ray, k, ftime, context, grid_x, line_offset, pre);
@@ -305,6 +310,7 @@ namespace embree
 
         const size_t line_offset   = pre.grid->width;
         const float* const grid_x  = pre.grid->decodeLeaf(itime,prim);
+        COST(CostCounters::prims(context,pre.grid->geomID,8));
 
 #if defined(__AVX__)
         return occluded<GridSOA::Gather3x3>( ray, k, ftime, context, grid_x, line_offset, pre);
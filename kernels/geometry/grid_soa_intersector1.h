@@ -88,6 +88,7 @@ namespace embree
       {
         const size_t line_offset   = pre.grid->width;
         const float* const grid_x  = pre.grid->decodeLeaf(0,prim);
+        COST(CostCounters::prims(context,pre.grid->geomID,8));
         
 #if defined(__AVX__)
         intersect<GridSOA::Gather3x3>( ray, context, grid_x, line_offset, pre);
@@ -102,6 +103,7 @@ namespace embree
       {
         const size_t line_offset   = pre.grid->width;
         const float* const grid_x  = pre.grid->decodeLeaf(0,prim);
+        COST(CostCounters::prims(context,pre.grid->geomID,8));
         
 #if defined(__AVX__)
         return occluded<GridSOA::Gather3x3>( ray, context, grid_x, line_offset, pre);
@@ -186,6 +188,7 @@ namespace embree
 
         const size_t line_offset   = pre.grid->width;
         const float* const grid_x  = pre.grid->decodeLeaf(itime,prim);
+        COST(CostCounters::prims(context,pre.grid->geomID,8));
         
 #if defined(__AVX__)
         intersect<GridSOA::Gather3x3>( ray, ftime, context, grid_x, line_offset, pre);
@@ -203,6 +206,7 @@ namespace embree
 
         const size_t line_offset   = pre.grid->width;
         const float* const grid_x  = pre.grid->decodeLeaf(itime,prim);
+        COST(CostCounters::prims(context,pre.grid->geomID,8));
         
 #if defined(__AVX__)
         return occluded<GridSOA::Gather3x3>( ray, ftime, context, grid_x, line_offset, pre);
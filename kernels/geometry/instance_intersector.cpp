@@ -45,6 +45,7 @@ namespace embree
       typedef Vec3<vfloat<K>> Vec3vfK;
       typedef AffineSpaceT<LinearSpace3<Vec3vfK>> AffineSpace3vfK;
       
+      COST(CostCounters::Instance costs(instance->parent,instance->id));
       AffineSpace3vfK world2local;
       const vbool<K> valid = *validi == vint<K>(-1);
       if (likely(instance->numTimeSteps == 1)) world2local = instance->getWorld2Local();
@@ -58,8 +59,9 @@ namespace embree
       ray.dir = xfmVector(world2local,ray_dir);
       ray.geomID = RTC_INVALID_GEOMETRY_ID;
       ray.instID = instance->id;
-      IntersectContext context(instance->object,nullptr); 
-      intersectObject(validi,instance->object,&context,ray);
+      Scene* object = instance->getObject();
+      IntersectContext context(object,nullptr); 
+      intersectObject(validi,object,&context,ray);
       ray.org = ray_org;
       ray.dir = ray_dir;
       vbool<K> nohit = ray.geomID == vint<K>(RTC_INVALID_GEOMETRY_ID);
@@ -73,6 +75,7 @@ namespace embree
       typedef Vec3<vfloat<K>> Vec3vfK;
       typedef AffineSpaceT<LinearSpace3<Vec3vfK>> AffineSpace3vfK;
 
+      COST(CostCounters::Instance costs(instance->parent,instance->id));
       AffineSpace3vfK world2local;
       const vbool<K> valid = *validi == vint<K>(-1);
       if (likely(instance->numTimeSteps == 1)) world2local = instance->getWorld2Local();
@@ -83,8 +86,9 @@ namespace embree
       ray.org = xfmPoint (world2local,ray_org);
       ray.dir = xfmVector(world2local,ray_dir);
       ray.instID = instance->id;
-      IntersectContext context(instance->object,nullptr);
-      occludedObject(validi,instance->object,&context,ray);
+      Scene* object = instance->getObject();
+      IntersectContext context(object,nullptr);
+      occludedObject(validi,object,&context,ray);
       ray.org = ray_org;
       ray.dir = ray_dir;
     }
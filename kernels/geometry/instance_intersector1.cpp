@@ -25,7 +25,10 @@ namespace embree
     {
       assert(itime < instance->numTimeSteps);
       unsigned num_time_segments = instance->numTimeSegments();
-      if (num_time_segments == 0) {
+      if (instance->lazy) {
+        bounds_o = xfmBounds(instance->local2world[itime],instance->lazyBounds);
+      }
+      else if (num_time_segments == 0) {
         bounds_o = xfmBounds(instance->local2world[itime],instance->object->bounds.bounds());
       }
       else {
@@ -39,6 +42,7 @@ namespace embree
 
     void FastInstanceIntersector1::intersect(const Instance* instance, Ray& ray, size_t item)
     {
+      COST(CostCounters::Instance costs(instance->parent,instance->id));
       const AffineSpace3fa world2local = 
         likely(instance->numTimeSteps == 1) ? instance->getWorld2Local() : instance->getWorld2Local(ray.time);
       const Vec3fa ray_org = ray.org;
@@ -49,8 +53,9 @@ namespace embree
       ray.dir = xfmVector(world2local,ray_dir);
       ray.geomID = RTC_INVALID_GEOMETRY_ID;
       ray.instID = instance->id;
-      IntersectContext context(instance->object,nullptr);
-      instance->object->intersect((RTCRay&)ray,&context);
+      Scene* object = instance->getObject();
+      IntersectContext context(object,nullptr);
+      object->intersect((RTCRay&)ray,&context);
       ray.org = ray_org;
       ray.dir = ray_dir;
       if (ray.geomID == RTC_INVALID_GEOMETRY_ID) {
@@ -61,6 +66,7 @@ namespace embree
     
     void FastInstanceIntersector1::occluded (const Instance* instance, Ray& ray, size_t item)
     {
+      COST(CostCounters::Instance costs(instance->parent,instance->id));
       const AffineSpace3fa world2local = 
         likely(instance->numTimeSteps == 1) ? instance->getWorld2Local() : instance->getWorld2Local(ray.time);
       const Vec3fa ray_org = ray.org;
@@ -68,8 +74,9 @@ namespace embree
       ray.org = xfmPoint (world2local,ray_org);
       ray.dir = xfmVector(world2local,ray_dir);
       ray.instID = instance->id;
-      IntersectContext context(instance->object,nullptr);
-      instance->object->occluded((RTCRay&)ray,&context);
+      Scene* object = instance->getObject();
+      IntersectContext context(object,nullptr);
+      object->occluded((RTCRay&)ray,&context);
       ray.org = ray_org;
       ray.dir = ray_dir;
     }
@@ -81,6 +88,7 @@ namespace embree
       assert(M<=MAX_INTERNAL_STREAM_SIZE);
       Ray lrays[MAX_INTERNAL_STREAM_SIZE];
       AffineSpace3fa world2local = instance->getWorld2Local();
+      COST(CostCounters::Instance costs(instance->parent,instance->id));
 
       for (size_t i=0; i<M; i++)
       {
@@ -97,7 +105,7 @@ namespace embree
         lrays[i].instID = instance->id;
       }
 
-      rtcIntersect1M((RTCScene)instance->object,context,(RTCRay*)lrays,M,sizeof(Ray));
+      rtcIntersect1M((RTCScene)instance->getObject(),context,(RTCRay*)lrays,M,sizeof(Ray));
         
       for (size_t i=0; i<M; i++)
       {
@@ -117,6 +125,7 @@ namespace embree
       assert(M<MAX_INTERNAL_STREAM_SIZE);
       Ray lrays[MAX_INTERNAL_STREAM_SIZE];
       AffineSpace3fa world2local = instance->getWorld2Local();
+      COST(CostCounters::Instance costs(instance->parent,instance->id));
       
       for (size_t i=0; i<M; i++)
       {
@@ -133,7 +142,7 @@ namespace embree
         lrays[i].instID = instance->id;
       }
 
-      rtcOccluded1M((RTCScene)instance->object,context,(RTCRay*)lrays,M,sizeof(Ray));
+      rtcOccluded1M((RTCScene)instance->getObject(),context,(RTCRay*)lrays,M,sizeof(Ray));
         
       for (size_t i=0; i<M; i++)
       {
@@ -23,6 +23,34 @@ namespace embree
 {
   namespace isa
   {
+    /*! charges n ray tests of each valid primitive of a leaf block to its geometry */
+    template<typename Primitive>
+      __forceinline auto costPrims(const IntersectContext* context, const Primitive& prim, size_t n) -> decltype(prim.valid(),void())
+    {
+      for (size_t m=movemask(prim.valid()); m; ) {
+        const size_t i = __bscf(m);
+        CostCounters::prims(context,prim.geomID(i),n);
+      }
+    }
+
+    template<typename Primitive>
+      __forceinline auto costPrims(const IntersectContext* context, const Primitive& prim, size_t n) -> decltype(unsigned(prim.geomID()),void()) {
+      CostCounters::prims(context,prim.geomID(),n);
+    }
+
+    template<typename Primitive>
+      __forceinline auto costPrims(const IntersectContext* context, const Primitive& prim, size_t n) -> decltype(unsigned(prim.geomID),void()) {
+      CostCounters::prims(context,prim.geomID,n);
+    }
+
+    /*! number of rays of a ray stream mask, __popcnt is not available on all ISAs */
+    __forceinline size_t costRays(size_t valid)
+    {
+      size_t n = 0;
+      for (; valid; n++) valid &= valid-1;
+      return n;
+    }
+
     template<typename Intersector>
       struct ArrayIntersector1
       {
@@ -33,13 +61,16 @@ namespace embree
 
         static __forceinline void intersect(Precalculations& pre, Ray& ray, IntersectContext* context, size_t ty, const Primitive* prim, size_t num, size_t& lazy_node)
         {
-          for (size_t i=0; i<num; i++)
+          for (size_t i=0; i<num; i++) {
+            COST(costPrims(context,prim[i],1));
             Intersector::intersect(pre,ray,context,prim[i]);
+          }
         }
         
         static __forceinline bool occluded(Precalculations& pre, Ray& ray, IntersectContext* context, size_t ty, const Primitive* prim, size_t num, size_t& lazy_node) 
         {
           for (size_t i=0; i<num; i++) {
+            COST(costPrims(context,prim[i],1));
             if (Intersector::occluded(pre,ray,context,prim[i]))
               return true;
           }
@@ -59,6 +90,7 @@ namespace embree
           } while(unlikely(valid));
           return valid_isec;
 #else
+          COST(for (size_t i=0; i<num; i++) costPrims(context,prim[i],costRays(valid)));
           return Intersector::intersect(pre,valid,rays,context,ty,prim,num);
 #endif
         }
@@ -112,12 +144,16 @@ namespace embree
         {
           if (likely(ty == 0)) {
             Primitive1 prim = (Primitive1) prim_i;
-            for (size_t i=0; i<num; i++)
+            for (size_t i=0; i<num; i++) {
+              COST(costPrims(context,prim[i],1));
               Intersector1::intersect(pre.pre1,ray,context,prim[i]);
+            }
           } else {
             Primitive2 prim = (Primitive2) prim_i;
-            for (size_t i=0; i<num; i++)
+            for (size_t i=0; i<num; i++) {
+              COST(costPrims(context,prim[i],1));
               Intersector2::intersect(pre,ray,context,prim[i]);
+            }
           }
         }
         
@@ -126,12 +162,14 @@ namespace embree
           if (likely(ty == 0)) {
             Primitive1 prim = (Primitive1) prim_i;
             for (size_t i=0; i<num; i++) {
+              COST(costPrims(context,prim[i],1));
               if (Intersector1::occluded(pre.pre1,ray,context,prim[i]))
                 return true;
             }
           } else {
             Primitive2 prim = (Primitive2) prim_i;
             for (size_t i=0; i<num; i++) {
+              COST(costPrims(context,prim[i],1));
               if (Intersector2::occluded(pre,ray,context,prim[i]))
                 return true;
             }
@@ -139,9 +177,150 @@ namespace embree
           return false;
         }
       };
-    
+
+    /*! Selects one of five intersectors by the leaf type of the
+     *  instanced BVH. The first two intersectors use the shared
+     *  precalculations, the others get their precalculations
+     *  recomputed from the instance space ray. */
+    template<typename Intersector1, typename Intersector2, typename Intersector3, typename Intersector4, typename Intersector5>
+      struct Select5Intersector1
+      {
+        typedef void* Primitive;
+        typedef typename Intersector1::Primitive* Primitive1;
+        typedef typename Intersector2::Primitive* Primitive2;
+        typedef typename Intersector3::Primitive* Primitive3;
+        typedef typename Intersector4::Primitive* Primitive4;
+        typedef typename Intersector5::Primitive* Primitive5;
+        typedef typename Intersector1::Precalculations Precalculations1;
+        typedef typename Intersector2::Precalculations Precalculations2;
+        typedef typename Intersector3::Precalculations Precalculations3;
+        typedef typename Intersector4::Precalculations Precalculations4;
+        typedef typename Intersector5::Precalculations Precalculations5;
+
+        struct Precalculations : public Precalculations2
+        {
+          __forceinline Precalculations (const Ray& ray, const void* ptr, unsigned numTimeSteps)
+            : Precalculations2(ray,ptr,numTimeSteps), pre1(ray,ptr,numTimeSteps), ptr(ptr) {}
+
+          Precalculations1 pre1;
+          const void* ptr;
+        };
+
+        /*! user geometry reports its own geomID, replace it by the instance ID */
+        static __forceinline void fixupInstID(Ray& ray, IntersectContext* context, const float tfar)
+        {
+          if (ray.tfar < tfar && context->geomID_to_instID)
+            ray.geomID = context->geomID_to_instID[0];
+        }
+
+        static __forceinline void intersect(Precalculations& pre, Ray& ray, IntersectContext* context, size_t ty, const Primitive* prim_i, size_t num, size_t& lazy_node)
+        {
+          switch (ty) {
+          case 0: {
+            Primitive1 prim = (Primitive1) prim_i;
+            for (size_t i=0; i<num; i++) {
+              COST(costPrims(context,prim[i],1));
+              Intersector1::intersect(pre.pre1,ray,context,prim[i]);
+            }
+            break;
+          }
+          case 1: {
+            Primitive2 prim = (Primitive2) prim_i;
+            for (size_t i=0; i<num; i++) {
+              COST(costPrims(context,prim[i],1));
+              Intersector2::intersect(pre,ray,context,prim[i]);
+            }
+            break;
+          }
+          case 2: {
+            Primitive3 prim = (Primitive3) prim_i;
+            Precalculations3 pre3(ray,pre.ptr,1);
+            for (size_t i=0; i<num; i++) {
+              COST(costPrims(context,prim[i],1));
+              Intersector3::intersect(pre3,ray,context,prim[i]);
+            }
+            break;
+          }
+          case 3: {
+            Primitive4 prim = (Primitive4) prim_i;
+            Precalculations4 pre4(ray,pre.ptr,1);
+            for (size_t i=0; i<num; i++) {
+              COST(costPrims(context,prim[i],1));
+              const float tfar = ray.tfar;
+              Intersector4::intersect(pre4,ray,context,prim[i]);
+              fixupInstID(ray,context,tfar);
+            }
+            break;
+          }
+          default: {
+            Primitive5 prim = (Primitive5) prim_i;
+            Precalculations5 pre5(ray,pre.ptr,1);
+            for (size_t i=0; i<num; i++) {
+              COST(costPrims(context,prim[i],1));
+              Intersector5::intersect(pre5,ray,context,prim[i]);
+            }
+            break;
+          }
+          }
+        }
+
+        static __forceinline bool occluded(Precalculations& pre, Ray& ray, IntersectContext* context, size_t ty, const Primitive* prim_i, size_t num, size_t& lazy_node)
+        {
+          switch (ty) {
+          case 0: {
+            Primitive1 prim = (Primitive1) prim_i;
+            for (size_t i=0; i<num; i++) {
+              COST(costPrims(context,prim[i],1));
+              if (Intersector1::occluded(pre.pre1,ray,context,prim[i]))
+                return true;
+            }
+            return false;
+          }
+          case 1: {
+            Primitive2 prim = (Primitive2) prim_i;
+            for (size_t i=0; i<num; i++) {
+              COST(costPrims(context,prim[i],1));
+              if (Intersector2::occluded(pre,ray,context,prim[i]))
+                return true;
+            }
+            return false;
+          }
+          case 2: {
+            Primitive3 prim = (Primitive3) prim_i;
+            Precalculations3 pre3(ray,pre.ptr,1);
+            for (size_t i=0; i<num; i++) {
+              COST(costPrims(context,prim[i],1));
+              if (Intersector3::occluded(pre3,ray,context,prim[i]))
+                return true;
+            }
+            return false;
+          }
+          case 3: {
+            Primitive4 prim = (Primitive4) prim_i;
+            Precalculations4 pre4(ray,pre.ptr,1);
+            for (size_t i=0; i<num; i++) {
+              COST(costPrims(context,prim[i],1));
+              if (Intersector4::occluded(pre4,ray,context,prim[i]))
+                return true;
+            }
+            return false;
+          }
+          default: {
+            Primitive5 prim = (Primitive5) prim_i;
+            Precalculations5 pre5(ray,pre.ptr,1);
+            for (size_t i=0; i<num; i++) {
+              COST(costPrims(context,prim[i],1));
+              if (Intersector5::occluded(pre5,ray,context,prim[i]))
+                return true;
+            }
+            return false;
+          }
+          }
+        }
+      };
+
     template<int K, typename Intersector>
-      struct ArrayIntersectorK_1 
+      struct ArrayIntersectorK_1
       {
         typedef typename Intersector::Primitive Primitive;
         typedef typename Intersector::Precalculations Precalculations;
@@ -149,6 +328,7 @@ namespace embree
         static __forceinline void intersect(const vbool<K>& valid, Precalculations& pre, RayK<K>& ray, IntersectContext* context, const Primitive* prim, size_t num, size_t& lazy_node)
         {
           for (size_t i=0; i<num; i++) {
+            COST(costPrims(context,prim[i],popcnt(valid)));
             Intersector::intersect(valid,pre,ray,context,prim[i]);
           }
         }
@@ -157,6 +337,7 @@ namespace embree
         {
           vbool<K> valid0 = valid;
           for (size_t i=0; i<num; i++) {
+            COST(costPrims(context,prim[i],popcnt(valid0)));
             valid0 &= !Intersector::occluded(valid0,pre,ray,context,prim[i]);
             if (none(valid0)) break;
           }
@@ -166,6 +347,7 @@ namespace embree
         static __forceinline void intersect(Precalculations& pre, RayK<K>& ray, size_t k, IntersectContext* context, const Primitive* prim, size_t num, size_t& lazy_node)
         {
           for (size_t i=0; i<num; i++) {
+            COST(costPrims(context,prim[i],1));
             Intersector::intersect(pre,ray,k,context,prim[i]);
           }
         }
@@ -173,6 +355,7 @@ namespace embree
         static __forceinline bool occluded(Precalculations& pre, RayK<K>& ray, size_t k, IntersectContext* context, const Primitive* prim, size_t num, size_t& lazy_node) 
         {
           for (size_t i=0; i<num; i++) {
+            COST(costPrims(context,prim[i],1));
             if (Intersector::occluded(pre,ray,k,context,prim[i]))
               return true;
           }
@@ -197,6 +380,7 @@ namespace embree
           PrecalculationsK pre(valid,ray,1); //todo: might cause trouble
 
           for (size_t i=0; i<num; i++) {
+            COST(costPrims(context,prim[i],popcnt(valid)));
             IntersectorK::intersect(valid,pre,ray,context,prim[i]);
           }
         }
@@ -206,6 +390,7 @@ namespace embree
           PrecalculationsK pre(valid,ray,1); //todo: might cause trouble
           vbool<K> valid0 = valid;
           for (size_t i=0; i<num; i++) {
+            COST(costPrims(context,prim[i],popcnt(valid0)));
             valid0 &= !IntersectorK::occluded(valid0,pre,ray,context,prim[i]);
             if (none(valid0)) break;
           }
@@ -214,13 +399,16 @@ namespace embree
 
         static __forceinline void intersect(Precalculations& pre, Ray& ray, IntersectContext* context, size_t ty, const Primitive* prim, size_t num, size_t& lazy_node)
         {
-          for (size_t i=0; i<num; i++)
+          for (size_t i=0; i<num; i++) {
+            COST(costPrims(context,prim[i],1));
             Intersector1::intersect(pre,ray,context,prim[i]);
+          }
         }
         
         static __forceinline bool occluded(Precalculations& pre, Ray& ray, IntersectContext* context, size_t ty, const Primitive* prim, size_t num, size_t& lazy_node) 
         {
           for (size_t i=0; i<num; i++) {
+            COST(costPrims(context,prim[i],1));
             if (Intersector1::occluded(pre,ray,context,prim[i]))
               return true;
           }
@@ -229,6 +417,7 @@ namespace embree
 
         static __forceinline size_t intersect(Precalculations* pre, size_t valid, Ray** rays, IntersectContext* context,  size_t ty, const Primitive* prim, size_t num, size_t& lazy_node)
         {
+          COST(for (size_t i=0; i<num; i++) costPrims(context,prim[i],costRays(valid)));
           return Intersector1::intersect(pre,valid,rays,context,ty,prim,num);
         }
 
@@ -0,0 +1,141 @@
+// ======================================================================== //
+// Copyright 2009-2016 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#pragma once
+
+#include "../common/ray.h"
+#include "filter.h"
+
+namespace embree
+{
+  namespace isa
+  {
+    template<int M>
+      struct PointIntersectorHitM
+      {
+        __forceinline PointIntersectorHitM() {}
+
+        __forceinline PointIntersectorHitM(const vfloat<M>& t, const Vec3<vfloat<M>>& Ng)
+          : vt(t), vNg(Ng) {}
+        
+        __forceinline void finalize() {}
+        
+        __forceinline Vec2f uv (const size_t i) const { return Vec2f(0.0f,0.0f); }
+        __forceinline float t  (const size_t i) const { return vt[i]; }
+        __forceinline Vec3fa Ng(const size_t i) const { return Vec3fa(vNg.x[i],vNg.y[i],vNg.z[i]); }
+        
+      public:
+        vfloat<M> vt;
+        Vec3<vfloat<M>> vNg;
+      };
+
+    /*! Intersects a ray with M spheres or ray facing discs at once. A
+     *  ray hits both a sphere and a disc iff its distance to the center
+     *  is at most the radius, thus both share the discriminant test. For
+     *  spheres the closer of the two roots inside the ray interval is
+     *  reported, discs are intersected in the plane through their
+     *  center orthogonal to the ray direction. */
+    template<int M>
+      struct PointIntersector
+      {
+        typedef Vec3<vfloat<M>> Vec3vfM;
+
+        template<typename Epilog>
+        static __forceinline bool intersect(const vbool<M>& valid_i,
+                                            const Vec3vfM& ray_org, const Vec3vfM& ray_dir,
+                                            const vfloat<M>& dir_len2, const vfloat<M>& rcp_dir_len2,
+                                            const vfloat<M>& ray_tnear, const vfloat<M>& ray_tfar,
+                                            const Vec3vfM& center, const vfloat<M>& radius, const vbool<M>& discs,
+                                            const Epilog& epilog)
+        {
+          const Vec3vfM O = ray_org-center;
+          const vfloat<M> B = dot(O,ray_dir);
+          const vfloat<M> C = dot(O,O)-radius*radius;
+          const vfloat<M> D = B*B-dir_len2*C;
+          vbool<M> valid = valid_i & (D >= vfloat<M>(zero));
+          if (likely(none(valid))) return false;
+
+          /* both roots coincide for discs */
+          const vfloat<M> Q = select(discs,vfloat<M>(zero),sqrt(max(D,vfloat<M>(zero))));
+          const vfloat<M> t0 = (-B-Q)*rcp_dir_len2;
+          const vfloat<M> t1 = (-B+Q)*rcp_dir_len2;
+          const vfloat<M> t = select((ray_tnear < t0) & (t0 < ray_tfar),t0,t1);
+          valid &= (ray_tnear < t) & (t < ray_tfar);
+          if (unlikely(none(valid))) return false;
+
+          /* sphere normals point outwards, disc normals towards the ray origin */
+          const Vec3vfM P = O+t*ray_dir;
+          const Vec3vfM Ng(select(discs,-ray_dir.x,P.x),select(discs,-ray_dir.y,P.y),select(discs,-ray_dir.z,P.z));
+          PointIntersectorHitM<M> hit(t,Ng);
+          return epilog(valid,hit);
+        }
+      };
+
+    template<int M>
+      struct PointIntersector1
+      {
+        typedef Vec3<vfloat<M>> Vec3vfM;
+
+        struct Precalculations
+        {
+          __forceinline Precalculations() {}
+
+          __forceinline Precalculations(const Ray& ray, const void* ptr)
+            : dir_len2(dot(Vec3fa(ray.dir),Vec3fa(ray.dir))), rcp_dir_len2(1.0f/dir_len2) {}
+          
+          vfloat<M> dir_len2;
+          vfloat<M> rcp_dir_len2;
+        };
+        
+        template<typename Epilog>
+        static __forceinline bool intersect(const vbool<M>& valid, Ray& ray, const Precalculations& pre,
+                                            const Vec3vfM& center, const vfloat<M>& radius, const vbool<M>& discs,
+                                            const Epilog& epilog)
+        {
+          return PointIntersector<M>::intersect(valid,Vec3vfM(ray.org),Vec3vfM(ray.dir),pre.dir_len2,pre.rcp_dir_len2,
+                                                vfloat<M>(ray.tnear),vfloat<M>(ray.tfar),
+                                                center,radius,discs,epilog);
+        }
+      };
+    
+    template<int M, int K>
+      struct PointIntersectorK
+      {
+        typedef Vec3<vfloat<M>> Vec3vfM;
+        
+        struct Precalculations 
+        {
+          __forceinline Precalculations (const vbool<K>& valid, const RayK<K>& ray)
+            : dir_len2(dot(ray.dir,ray.dir)), rcp_dir_len2(1.0f/dir_len2) {}
+          
+          vfloat<K> dir_len2;
+          vfloat<K> rcp_dir_len2;
+        };
+        
+        template<typename Epilog>
+        static __forceinline bool intersect(const vbool<M>& valid, RayK<K>& ray, size_t k, const Precalculations& pre,
+                                            const Vec3vfM& center, const vfloat<M>& radius, const vbool<M>& discs,
+                                            const Epilog& epilog)
+        {
+          const Vec3vfM ray_org(ray.org.x[k],ray.org.y[k],ray.org.z[k]);
+          const Vec3vfM ray_dir(ray.dir.x[k],ray.dir.y[k],ray.dir.z[k]);
+          return PointIntersector<M>::intersect(valid,ray_org,ray_dir,vfloat<M>(pre.dir_len2[k]),vfloat<M>(pre.rcp_dir_len2[k]),
+                                                vfloat<M>(ray.tnear[k]),vfloat<M>(ray.tfar[k]),
+                                                center,radius,discs,epilog);
+        }
+      };
+  }
+}
@@ -0,0 +1,142 @@
+// ======================================================================== //
+// Copyright 2009-2016 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#pragma once
+
+#include "primitive.h"
+
+namespace embree
+{
+  /* Stores M spheres or discs with their centers and radii copied into
+   * the leaf. Discs are marked by a negative radius. */
+  template <int M>
+  struct PointMv
+  {
+    /* Virtual interface to query information about the point type */
+    struct Type : public PrimitiveType
+    {
+      Type();
+      size_t size(const char* This) const;
+    };
+    static Type type;
+
+  public:
+
+    /* Returns maximal number of stored points */
+    static __forceinline size_t max_size() { return M; }
+
+    /* Returns required number of primitive blocks for N points */
+    static __forceinline size_t blocks(size_t N) { return (N+max_size()-1)/max_size(); }
+
+  public:
+
+    /* Default constructor */
+    __forceinline PointMv() {}
+
+    /* Construction from centers, radii, and IDs */
+    __forceinline PointMv(const Vec3<vfloat<M>>& p, const vfloat<M>& r, const vint<M>& geomIDs, const vint<M>& primIDs)
+      : p(p), r(r), geomIDs(geomIDs), primIDs(primIDs) {}
+
+    /* Returns a mask that tells which points are valid */
+    __forceinline vbool<M> valid() const { return primIDs != vint<M>(-1); }
+
+    /* Returns if the specified point is valid */
+    __forceinline bool valid(const size_t i) const { assert(i<M); return primIDs[i] != -1; }
+
+    /* Returns the number of stored points */
+    __forceinline size_t size() const { return __bsf(~movemask(valid())); }
+
+    /* Returns a mask that tells which points are discs */
+    __forceinline vbool<M> discs() const { return r < vfloat<M>(zero); }
+
+    /* Returns the radii of the points */
+    __forceinline vfloat<M> radius() const { return abs(r); }
+
+    /* Returns the geometry IDs */
+    __forceinline vint<M> geomID() const { return geomIDs; }
+    __forceinline int geomID(const size_t i) const { assert(i<M); return geomIDs[i]; }
+
+    /* Returns the primitive IDs */
+    __forceinline vint<M> primID() const { return primIDs; }
+    __forceinline int primID(const size_t i) const { assert(i<M); return primIDs[i]; }
+
+    /* Calculate the bounds of the points */
+    __forceinline BBox3fa bounds() const
+    {
+      const vfloat<M> rad = radius();
+      const vbool<M> mask = valid();
+      const Vec3<vfloat<M>> lower(select(mask,p.x-rad,vfloat<M>(pos_inf)),select(mask,p.y-rad,vfloat<M>(pos_inf)),select(mask,p.z-rad,vfloat<M>(pos_inf)));
+      const Vec3<vfloat<M>> upper(select(mask,p.x+rad,vfloat<M>(neg_inf)),select(mask,p.y+rad,vfloat<M>(neg_inf)),select(mask,p.z+rad,vfloat<M>(neg_inf)));
+      return BBox3fa(Vec3fa(reduce_min(lower.x),reduce_min(lower.y),reduce_min(lower.z)),
+                     Vec3fa(reduce_max(upper.x),reduce_max(upper.y),reduce_max(upper.z)));
+    }
+
+    /* Fill point block from point list */
+    __forceinline void fill(const PrimRef* prims, size_t& begin, size_t end, Scene* scene, const bool list)
+    {
+      vint<M> vgeomID = -1, vprimID = -1;
+      Vec3<vfloat<M>> vp = zero;
+      vfloat<M> vr = zero;
+
+      for (size_t i=0; i<M && begin<end; i++, begin++)
+      {
+        const PrimRef& prim = prims[begin];
+        const unsigned geomID = prim.geomID();
+        const unsigned primID = prim.primID();
+        const Points* geom = scene->getPoints(geomID);
+        const Vec3fa v = geom->vertex(primID);
+        vgeomID [i] = geomID;
+        vprimID [i] = primID;
+        vp.x[i] = v.x;
+        vp.y[i] = v.y;
+        vp.z[i] = v.z;
+        vr[i] = geom->subtype == Points::DISCS ? -v.w : v.w;
+      }
+
+      new (this) PointMv(vp,vr,vgeomID,vprimID); // FIXME: use non temporal store
+    }
+
+    /* Updates the primitive */
+    __forceinline BBox3fa update(Points* geom)
+    {
+      for (size_t i=0; i<M && valid(i); i++)
+      {
+        const Vec3fa v = geom->vertex(primID(i));
+        p.x[i] = v.x;
+        p.y[i] = v.y;
+        p.z[i] = v.z;
+        r[i] = geom->subtype == Points::DISCS ? -v.w : v.w;
+      }
+      return bounds();
+    }
+
+    /*! output operator */
+    friend __forceinline std::ostream& operator<<(std::ostream& cout, const PointMv& point) {
+      return cout << "Point" << M << "v { p = " << point.p << ", r = " << point.r << ", geomID = " << point.geomIDs << ", primID = " << point.primIDs << " }";
+    }
+    
+  public:
+    Vec3<vfloat<M>> p;  // centers
+    vfloat<M> r;        // radii, negative for discs
+    vint<M> geomIDs;    // geometry IDs
+    vint<M> primIDs;    // primitive IDs
+  };
+
+  template<int M>
+  typename PointMv<M>::Type PointMv<M>::type;
+
+  typedef PointMv<4> Point4v;
+}
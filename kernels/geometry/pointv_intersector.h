@@ -0,0 +1,79 @@
+// ======================================================================== //
+// Copyright 2009-2016 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#pragma once
+
+#include "pointv.h"
+#include "point_intersector.h"
+#include "intersector_epilog.h"
+
+namespace embree
+{
+  namespace isa
+  {
+    template<int M, bool filter>
+    struct PointMvIntersector1
+    {
+      typedef PointMv<M> Primitive;
+      typedef Intersector1Precalculations<typename PointIntersector1<M>::Precalculations> Precalculations;
+
+      static __forceinline void intersect(Precalculations& pre, Ray& ray, IntersectContext* context, const Primitive& point)
+      {
+        STAT3(normal.trav_prims,1,1,1);
+        PointIntersector1<M>::intersect(point.valid(),ray,pre,point.p,point.radius(),point.discs(),Intersect1EpilogM<M,M,filter>(ray,context,point.geomIDs,point.primIDs));
+      }
+
+      static __forceinline bool occluded(Precalculations& pre, Ray& ray, IntersectContext* context, const Primitive& point)
+      {
+        STAT3(shadow.trav_prims,1,1,1);
+        return PointIntersector1<M>::intersect(point.valid(),ray,pre,point.p,point.radius(),point.discs(),Occluded1EpilogM<M,M,filter>(ray,context,point.geomIDs,point.primIDs));
+      }
+
+      /*! Intersect an array of rays with an array of M primitives. */
+      static __forceinline size_t intersect(Precalculations* pre, size_t valid, Ray** rays, IntersectContext* context,  size_t ty, const Primitive* prim, size_t num)
+      {
+        size_t valid_isec = 0;
+        do {
+          const size_t i = __bscf(valid);
+          const float old_far = rays[i]->tfar;
+          for (size_t n=0; n<num; n++)
+            intersect(pre[i],*rays[i],context,prim[n]);
+          valid_isec |= (rays[i]->tfar < old_far) ? ((size_t)1 << i) : 0;            
+        } while(unlikely(valid));
+        return valid_isec;
+      }
+    };
+
+    template<int M, int K, bool filter>
+    struct PointMvIntersectorK
+    {
+      typedef PointMv<M> Primitive;
+      typedef IntersectorKPrecalculations<K, typename PointIntersectorK<M,K>::Precalculations> Precalculations;
+
+      static __forceinline void intersect(Precalculations& pre, RayK<K>& ray, size_t k, IntersectContext* context, const Primitive& point)
+      {
+        STAT3(normal.trav_prims,1,1,1);
+        PointIntersectorK<M,K>::intersect(point.valid(),ray,k,pre,point.p,point.radius(),point.discs(),Intersect1KEpilogM<M,M,K,filter>(ray,k,context,point.geomIDs,point.primIDs));
+      }
+      
+      static __forceinline bool occluded(Precalculations& pre, RayK<K>& ray, size_t k, IntersectContext* context, const Primitive& point)
+      {
+        STAT3(shadow.trav_prims,1,1,1);
+        return PointIntersectorK<M,K>::intersect(point.valid(),ray,k,pre,point.p,point.radius(),point.discs(),Occluded1KEpilogM<M,M,K,filter>(ray,k,context,point.geomIDs,point.primIDs));
+      }
+    };
+  }
+}
@@ -18,11 +18,13 @@
 #include "bezier1v.h"
 #include "bezier1i.h"
 #include "linei.h"
+#include "pointv.h"
 #include "triangle.h"
 #include "trianglev.h"
 #include "trianglei.h"
 #include "trianglev_mb.h"
 #include "trianglei_mb.h"
+#include "trianglepairv.h"
 #include "quadv.h"
 #include "quadi.h"
 #include "quadi_mb.h"
@@ -63,6 +65,17 @@ namespace embree
   size_t Line4i::Type::size(const char* This) const {
     return ((Line4i*)This)->size();
   }
+
+  /********************** Point4v **************************/
+
+  template<>
+  Point4v::Type::Type ()
+    : PrimitiveType("point4v",sizeof(Point4v),4) {}
+
+  template<>
+  size_t Point4v::Type::size(const char* This) const {
+    return ((Point4v*)This)->size();
+  }
   
   /********************** Triangle4 **************************/
 
@@ -119,6 +132,17 @@ namespace embree
     return ((Triangle4iMB*)This)->size();
   }
 
+  /********************** TrianglePair4v **************************/
+
+  template<>
+  TrianglePair4v::Type::Type ()
+    : PrimitiveType("trianglepair4v",sizeof(TrianglePair4v),4) {}
+
+  template<>
+  size_t TrianglePair4v::Type::size(const char* This) const {
+    return ((TrianglePair4v*)This)->size();
+  }
+
   /********************** Quad4v **************************/
 
   template<>
@@ -0,0 +1,158 @@
+// ======================================================================== //
+// Copyright 2009-2016 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#pragma once
+
+#include "primitive.h"
+
+namespace embree
+{
+  /* Stores M pairs of triangles of a triangle mesh in quad layout.
+   * The first triangle of each pair is (v0,v1,v3) and the second
+   * one (v2,v3,v1), both keep their original primitive ID. */
+  template <int M>
+  struct TrianglePairMv
+  {
+    typedef Vec3<vfloat<M>> Vec3vfM;
+
+  public:
+    struct Type : public PrimitiveType
+    {
+      Type();
+      size_t size(const char* This) const;
+    };
+    static Type type;
+
+  public:
+
+    /* Returns maximal number of stored triangle pairs */
+    static __forceinline size_t max_size() { return M; }
+
+    /* Returns required number of primitive blocks for N primitives */
+    static __forceinline size_t blocks(size_t N) { return (N+max_size()-1)/max_size(); }
+
+  public:
+
+    /* Default constructor */
+    __forceinline TrianglePairMv() {}
+
+    /* Construction from vertices and IDs */
+    __forceinline TrianglePairMv(const Vec3vfM& v0, const Vec3vfM& v1, const Vec3vfM& v2, const Vec3vfM& v3, const vint<M>& geomIDs, const vint<M>& primIDs0, const vint<M>& primIDs1, const vint<M>& rotations)
+      : v0(v0), v1(v1), v2(v2), v3(v3), geomIDs(geomIDs), primIDs0(primIDs0), primIDs1(primIDs1), rotations(rotations) {}
+
+    /* Returns a mask that tells which triangle pairs are valid */
+    __forceinline vbool<M> valid() const { return geomIDs != vint<M>(-1); }
+
+    /* Returns true if the specified triangle pair is valid */
+    __forceinline bool valid(const size_t i) const { assert(i<M); return geomIDs[i] != -1; }
+
+    /* Returns the number of stored triangle pairs */
+    __forceinline size_t size() const { return __bsf(~movemask(valid())); }
+
+    /* Returns the geometry IDs */
+    __forceinline vint<M> geomID() const { return geomIDs; }
+    __forceinline int geomID(const size_t i) const { assert(i<M); return geomIDs[i]; }
+
+    /* Returns the primitive IDs of the first triangles */
+    __forceinline vint<M> primID() const { return primIDs0; }
+    __forceinline int  primID(const size_t i) const { assert(i<M); return primIDs0[i]; }
+
+    /* Returns the rotations of the first and second triangles */
+    __forceinline vint<M> rotation0() const { return rotations & vint<M>(3); }
+    __forceinline vint<M> rotation1() const { return srl(rotations,2); }
+
+    /* Calculate the bounds of the triangle pairs */
+    __forceinline BBox3fa bounds() const
+    {
+      Vec3vfM lower = min(v0,v1,v2,v3);
+      Vec3vfM upper = max(v0,v1,v2,v3);
+      vbool<M> mask = valid();
+      lower.x = select(mask,lower.x,vfloat<M>(pos_inf));
+      lower.y = select(mask,lower.y,vfloat<M>(pos_inf));
+      lower.z = select(mask,lower.z,vfloat<M>(pos_inf));
+      upper.x = select(mask,upper.x,vfloat<M>(neg_inf));
+      upper.y = select(mask,upper.y,vfloat<M>(neg_inf));
+      upper.z = select(mask,upper.z,vfloat<M>(neg_inf));
+      return BBox3fa(Vec3fa(reduce_min(lower.x),reduce_min(lower.y),reduce_min(lower.z)),
+                     Vec3fa(reduce_max(upper.x),reduce_max(upper.y),reduce_max(upper.z)));
+    }
+
+    /* Non temporal store */
+    __forceinline static void store_nt(TrianglePairMv* dst, const TrianglePairMv& src)
+    {
+      vfloat<M>::store_nt(&dst->v0.x,src.v0.x);
+      vfloat<M>::store_nt(&dst->v0.y,src.v0.y);
+      vfloat<M>::store_nt(&dst->v0.z,src.v0.z);
+      vfloat<M>::store_nt(&dst->v1.x,src.v1.x);
+      vfloat<M>::store_nt(&dst->v1.y,src.v1.y);
+      vfloat<M>::store_nt(&dst->v1.z,src.v1.z);
+      vfloat<M>::store_nt(&dst->v2.x,src.v2.x);
+      vfloat<M>::store_nt(&dst->v2.y,src.v2.y);
+      vfloat<M>::store_nt(&dst->v2.z,src.v2.z);
+      vfloat<M>::store_nt(&dst->v3.x,src.v3.x);
+      vfloat<M>::store_nt(&dst->v3.y,src.v3.y);
+      vfloat<M>::store_nt(&dst->v3.z,src.v3.z);
+      vint<M>::store_nt(&dst->geomIDs,src.geomIDs);
+      vint<M>::store_nt(&dst->primIDs0,src.primIDs0);
+      vint<M>::store_nt(&dst->primIDs1,src.primIDs1);
+      vint<M>::store_nt(&dst->rotations,src.rotations);
+    }
+
+    /* Fill triangle pairs from triangle pair list */
+    __forceinline void fill(const PrimRef* prims, size_t& begin, size_t end, Scene* scene, const bool list)
+    {
+      vint<M> vgeomID = -1, vprimID0 = -1, vprimID1 = -1, vrotation = 0;
+      Vec3vfM v0 = zero, v1 = zero, v2 = zero, v3 = zero;
+
+      for (size_t i=0; i<M && begin<end; i++, begin++)
+      {
+	const PrimRef& prim = prims[begin];
+        const unsigned geomID = prim.geomID();
+        const unsigned pairID = prim.primID();
+        const TriangleMesh* __restrict__ const mesh = scene->getTriangleMesh(geomID);
+        const TriangleMesh::TrianglePair& pair = mesh->trianglePair(pairID);
+        const Vec3fa& p0 = mesh->vertex(pair.v[0]);
+        const Vec3fa& p1 = mesh->vertex(pair.v[1]);
+        const Vec3fa& p2 = mesh->vertex(pair.v[2]);
+        const Vec3fa& p3 = mesh->vertex(pair.v[3]);
+        vgeomID  [i] = geomID;
+        vprimID0 [i] = pair.primID[0];
+        vprimID1 [i] = pair.primID[1];
+        vrotation[i] = pair.rotation;
+        v0.x[i] = p0.x; v0.y[i] = p0.y; v0.z[i] = p0.z;
+        v1.x[i] = p1.x; v1.y[i] = p1.y; v1.z[i] = p1.z;
+        v2.x[i] = p2.x; v2.y[i] = p2.y; v2.z[i] = p2.z;
+        v3.x[i] = p3.x; v3.y[i] = p3.y; v3.z[i] = p3.z;
+      }
+      TrianglePairMv::store_nt(this,TrianglePairMv(v0,v1,v2,v3,vgeomID,vprimID0,vprimID1,vrotation));
+    }
+
+  public:
+    Vec3vfM v0;        // 1st vertex of the triangle pairs
+    Vec3vfM v1;        // 2nd vertex of the triangle pairs
+    Vec3vfM v2;        // 3rd vertex of the triangle pairs
+    Vec3vfM v3;        // 4rd vertex of the triangle pairs
+    vint<M> geomIDs;   // geometry ID
+    vint<M> primIDs0;  // primitive ID of first triangle
+    vint<M> primIDs1;  // primitive ID of second triangle
+    vint<M> rotations; // rotation of both triangles relative to their original vertex order
+  };
+
+  template<int M>
+  typename TrianglePairMv<M>::Type TrianglePairMv<M>::type;
+
+  typedef TrianglePairMv<4> TrianglePair4v;
+}
@@ -0,0 +1,204 @@
+// ======================================================================== //
+// Copyright 2009-2016 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#pragma once
+
+#include "trianglepairv.h"
+#include "triangle_intersector_moeller.h"
+
+namespace embree
+{
+  namespace isa
+  {
+    /*! Maps the hit coordinates of a rotated triangle back to its
+     *  original vertex order. A triangle with rotation r got stored
+     *  as (p[r+2],p[r],p[r+1]). */
+    template<typename vfloat, typename vint>
+      __forceinline void unrotateUV(const vint& rotation, vfloat& u, vfloat& v, const vfloat& w)
+    {
+      const auto rot0 = rotation == vint(0);
+      const auto rot2 = rotation == vint(2);
+      const vfloat u1 = select(rot0,v,select(rot2,w,u));
+      const vfloat v1 = select(rot0,w,select(rot2,u,v));
+      u = u1; v = v1;
+    }
+
+    /*! Epilog wrapper that restores the barycentric coordinates of M triangles */
+    template<int M, typename Epilog>
+      struct TrianglePairEpilogM
+      {
+        const vint<M>& rotation;
+        const Epilog& epilog;
+
+        __forceinline TrianglePairEpilogM(const vint<M>& rotation, const Epilog& epilog)
+          : rotation(rotation), epilog(epilog) {}
+
+        template<typename Hit>
+        __forceinline bool operator() (const vbool<M>& valid, Hit& hit) const
+        {
+          unrotateUV(rotation,hit.U,hit.V,hit.absDen-hit.U-hit.V);
+          return epilog(valid,hit);
+        }
+      };
+
+    /*! Hit wrapper that restores the barycentric coordinates of one triangle hit by K rays */
+    template<int K, typename Hit>
+      struct TrianglePairHitK
+      {
+        const Hit& hit;
+        const int rotation;
+
+        __forceinline TrianglePairHitK(const Hit& hit, const int rotation)
+          : hit(hit), rotation(rotation) {}
+
+        __forceinline std::tuple<vfloat<K>,vfloat<K>,vfloat<K>,Vec3<vfloat<K>>> operator() () const
+        {
+          vfloat<K> u, v, t;
+          Vec3<vfloat<K>> Ng;
+          std::tie(u,v,t,Ng) = hit();
+          unrotateUV(vint<K>(rotation),u,v,vfloat<K>(1.0f)-u-v);
+          return std::make_tuple(u,v,t,Ng);
+        }
+      };
+
+    /*! Epilog wrapper that restores the barycentric coordinates of one triangle hit by K rays */
+    template<int K, typename Epilog>
+      struct TrianglePairEpilogK
+      {
+        const int rotation;
+        const Epilog& epilog;
+
+        __forceinline TrianglePairEpilogK(const int rotation, const Epilog& epilog)
+          : rotation(rotation), epilog(epilog) {}
+
+        template<typename Hit>
+        __forceinline vbool<K> operator() (const vbool<K>& valid, const Hit& hit) const {
+          return epilog(valid,TrianglePairHitK<K,Hit>(hit,rotation));
+        }
+      };
+
+    /*! Intersects M triangle pairs with 1 ray */
+    template<int M, bool filter>
+      struct TrianglePairMvIntersector1Moeller
+      {
+        typedef TrianglePairMv<M> Primitive;
+        typedef Intersector1Precalculations<MoellerTrumboreIntersector1<M>> Precalculations;
+
+        /*! Intersect a ray with the M triangle pairs and updates the hit. */
+        static __forceinline void intersect(const Precalculations& pre, Ray& ray, IntersectContext* context, const Primitive& tri)
+        {
+          STAT3(normal.trav_prims,1,1,1);
+          const vint<M> rotation0 = tri.rotation0();
+          const vint<M> rotation1 = tri.rotation1();
+          pre.intersect(ray,tri.v0,tri.v1,tri.v3,TrianglePairEpilogM<M,Intersect1EpilogM<M,M,filter>>(rotation0,Intersect1EpilogM<M,M,filter>(ray,context,tri.geomIDs,tri.primIDs0)));
+          pre.intersect(ray,tri.v2,tri.v3,tri.v1,TrianglePairEpilogM<M,Intersect1EpilogM<M,M,filter>>(rotation1,Intersect1EpilogM<M,M,filter>(ray,context,tri.geomIDs,tri.primIDs1)));
+        }
+
+        /*! Test if the ray is occluded by one of M triangle pairs. */
+        static __forceinline bool occluded(const Precalculations& pre, Ray& ray, IntersectContext* context, const Primitive& tri)
+        {
+          STAT3(shadow.trav_prims,1,1,1);
+          const vint<M> rotation0 = tri.rotation0();
+          if (pre.intersect(ray,tri.v0,tri.v1,tri.v3,TrianglePairEpilogM<M,Occluded1EpilogM<M,M,filter>>(rotation0,Occluded1EpilogM<M,M,filter>(ray,context,tri.geomIDs,tri.primIDs0))))
+            return true;
+          const vint<M> rotation1 = tri.rotation1();
+          return pre.intersect(ray,tri.v2,tri.v3,tri.v1,TrianglePairEpilogM<M,Occluded1EpilogM<M,M,filter>>(rotation1,Occluded1EpilogM<M,M,filter>(ray,context,tri.geomIDs,tri.primIDs1)));
+        }
+
+        /*! Intersect an array of rays with an array of M primitives. */
+        static __forceinline size_t intersect(Precalculations* pre, size_t valid, Ray** rays, IntersectContext* context,  size_t ty, const Primitive* prim, size_t num)
+        {
+          size_t valid_isec = 0;
+          do {
+            const size_t i = __bscf(valid);
+            const float old_far = rays[i]->tfar;
+            for (size_t n=0; n<num; n++)
+              intersect(pre[i],*rays[i],context,prim[n]);
+            valid_isec |= (rays[i]->tfar < old_far) ? ((size_t)1 << i) : 0;
+          } while(unlikely(valid));
+          return valid_isec;
+        }
+      };
+
+    /*! Intersects M triangle pairs with K rays */
+    template<int M, int K, bool filter>
+      struct TrianglePairMvIntersectorKMoeller
+      {
+        typedef TrianglePairMv<M> Primitive;
+        typedef IntersectorKPrecalculations<K,MoellerTrumboreIntersectorK<M,K>> Precalculations;
+
+        /*! Intersects K rays with M triangle pairs. */
+        static __forceinline void intersect(const vbool<K>& valid_i, Precalculations& pre, RayK<K>& ray, IntersectContext* context, const Primitive& tri)
+        {
+          for (size_t i=0; i<M; i++)
+          {
+            if (!tri.valid(i)) break;
+            STAT3(normal.trav_prims,1,popcnt(valid_i),K);
+            const Vec3<vfloat<K>> v0 = broadcast<vfloat<K>>(tri.v0,i);
+            const Vec3<vfloat<K>> v1 = broadcast<vfloat<K>>(tri.v1,i);
+            const Vec3<vfloat<K>> v2 = broadcast<vfloat<K>>(tri.v2,i);
+            const Vec3<vfloat<K>> v3 = broadcast<vfloat<K>>(tri.v3,i);
+            pre.intersectK(valid_i,ray,v0,v1,v3,TrianglePairEpilogK<K,IntersectKEpilogM<M,K,filter>>(tri.rotation0()[i],IntersectKEpilogM<M,K,filter>(ray,context,tri.geomIDs,tri.primIDs0,i)));
+            if (tri.primIDs1[i] == -1) continue;
+            pre.intersectK(valid_i,ray,v2,v3,v1,TrianglePairEpilogK<K,IntersectKEpilogM<M,K,filter>>(tri.rotation1()[i],IntersectKEpilogM<M,K,filter>(ray,context,tri.geomIDs,tri.primIDs1,i)));
+          }
+        }
+
+        /*! Test for K rays if they are occluded by any of the M triangle pairs. */
+        static __forceinline vbool<K> occluded(const vbool<K>& valid_i, Precalculations& pre, RayK<K>& ray, IntersectContext* context, const Primitive& tri)
+        {
+          vbool<K> valid0 = valid_i;
+
+          for (size_t i=0; i<M; i++)
+          {
+            if (!tri.valid(i)) break;
+            STAT3(shadow.trav_prims,1,popcnt(valid0),K);
+            const Vec3<vfloat<K>> v0 = broadcast<vfloat<K>>(tri.v0,i);
+            const Vec3<vfloat<K>> v1 = broadcast<vfloat<K>>(tri.v1,i);
+            const Vec3<vfloat<K>> v2 = broadcast<vfloat<K>>(tri.v2,i);
+            const Vec3<vfloat<K>> v3 = broadcast<vfloat<K>>(tri.v3,i);
+            pre.intersectK(valid0,ray,v0,v1,v3,TrianglePairEpilogK<K,OccludedKEpilogM<M,K,filter>>(tri.rotation0()[i],OccludedKEpilogM<M,K,filter>(valid0,ray,context,tri.geomIDs,tri.primIDs0,i)));
+            if (none(valid0)) break;
+            if (tri.primIDs1[i] == -1) continue;
+            pre.intersectK(valid0,ray,v2,v3,v1,TrianglePairEpilogK<K,OccludedKEpilogM<M,K,filter>>(tri.rotation1()[i],OccludedKEpilogM<M,K,filter>(valid0,ray,context,tri.geomIDs,tri.primIDs1,i)));
+            if (none(valid0)) break;
+          }
+          return !valid0;
+        }
+
+        /*! Intersect a ray with M triangle pairs and updates the hit. */
+        static __forceinline void intersect(Precalculations& pre, RayK<K>& ray, size_t k, IntersectContext* context, const Primitive& tri)
+        {
+          STAT3(normal.trav_prims,1,1,1);
+          const vint<M> rotation0 = tri.rotation0();
+          const vint<M> rotation1 = tri.rotation1();
+          pre.intersect(ray,k,tri.v0,tri.v1,tri.v3,TrianglePairEpilogM<M,Intersect1KEpilogM<M,M,K,filter>>(rotation0,Intersect1KEpilogM<M,M,K,filter>(ray,k,context,tri.geomIDs,tri.primIDs0)));
+          pre.intersect(ray,k,tri.v2,tri.v3,tri.v1,TrianglePairEpilogM<M,Intersect1KEpilogM<M,M,K,filter>>(rotation1,Intersect1KEpilogM<M,M,K,filter>(ray,k,context,tri.geomIDs,tri.primIDs1)));
+        }
+
+        /*! Test if the ray is occluded by one of the M triangle pairs. */
+        static __forceinline bool occluded(Precalculations& pre, RayK<K>& ray, size_t k, IntersectContext* context, const Primitive& tri)
+        {
+          STAT3(shadow.trav_prims,1,1,1);
+          const vint<M> rotation0 = tri.rotation0();
+          if (pre.intersect(ray,k,tri.v0,tri.v1,tri.v3,TrianglePairEpilogM<M,Occluded1KEpilogM<M,M,K,filter>>(rotation0,Occluded1KEpilogM<M,M,K,filter>(ray,k,context,tri.geomIDs,tri.primIDs0))))
+            return true;
+          const vint<M> rotation1 = tri.rotation1();
+          return pre.intersect(ray,k,tri.v2,tri.v3,tri.v1,TrianglePairEpilogM<M,Occluded1KEpilogM<M,M,K,filter>>(rotation1,Occluded1KEpilogM<M,M,K,filter>(ray,k,context,tri.geomIDs,tri.primIDs1)));
+        }
+      };
+  }
+}
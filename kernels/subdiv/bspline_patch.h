@@ -62,6 +62,61 @@ namespace embree
     }
   };
 
+  /*! Control vertex indices of a regular interior B-spline patch,
+   *  allows to evaluate the patch directly from any vertex buffer
+   *  that shares the topology of the mesh. */
+  struct BSplineStencil
+  {
+    /*! gathers the indices of the 16 control vertices, returns false
+     *  if the face is not regular or touches the border */
+    bool init(const HalfEdge* edge0)
+    {
+      if (!edge0->isRegularFace()) return false;
+      
+      /* fill inner vertices */
+      const HalfEdge* edge1 = edge0->next();
+      const HalfEdge* edge2 = edge1->next();
+      const HalfEdge* edge3 = edge2->next();
+      index[1][1] = edge0->getStartVertexIndex();
+      index[1][2] = edge1->getStartVertexIndex();
+      index[2][2] = edge2->getStartVertexIndex();
+      index[2][1] = edge3->getStartVertexIndex();
+
+      /* fill border and corner vertices */
+      return 
+        init_border(edge0,index[0][1],index[0][2]) && 
+        init_border(edge1,index[1][3],index[2][3]) && 
+        init_border(edge2,index[3][2],index[3][1]) && 
+        init_border(edge3,index[2][0],index[1][0]) && 
+        init_corner(edge0,index[0][0]) && 
+        init_corner(edge1,index[0][3]) &&
+        init_corner(edge2,index[3][3]) &&
+        init_corner(edge3,index[3][0]);
+    }
+
+  private:
+    __forceinline bool init_border(const HalfEdge* edge0, unsigned& i01, unsigned& i02)
+    {
+      if (!edge0->hasOpposite()) return false;
+      const HalfEdge* e = edge0->opposite()->next()->next(); 
+      i01 = e->getStartVertexIndex();
+      i02 = e->next()->getStartVertexIndex();
+      return true;
+    }
+
+    __forceinline bool init_corner(const HalfEdge* edge0, unsigned& i00)
+    {
+      if (!edge0->hasOpposite() || !edge0->prev()->hasOpposite()) return false;
+      const HalfEdge* e = edge0->opposite()->next();
+      if (!e->hasOpposite()) return false;
+      i00 = e->opposite()->prev()->getStartVertexIndex();
+      return true;
+    }
+
+  public:
+    unsigned index[4][4];
+  };
+
   template<typename Vertex, typename Vertex_t = Vertex>
     class __aligned(64) BSplinePatchT
     {
@@ -89,6 +144,13 @@ namespace embree
         init(edge,vertices,stride);
       }
 
+      __forceinline BSplinePatchT (const BSplineStencil& stencil, const char* vertices, size_t stride) 
+      {
+        for (size_t y=0; y<4; y++)
+          for (size_t x=0; x<4; x++)
+            v[y][x] = Vertex_t::loadu(vertices+stencil.index[y][x]*stride);
+      }
+
       __forceinline Vertex hard_corner(const                    Vertex& v01, const Vertex& v02, 
                                        const Vertex& v10, const Vertex& v11, const Vertex& v12, 
                                        const Vertex& v20, const Vertex& v21, const Vertex& v22)
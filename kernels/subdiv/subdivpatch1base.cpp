@@ -27,27 +27,47 @@ namespace embree
                                       const float edge_level[4],
                                       const int subdiv[4],
                                       const int simd_width)
+  : SubdivPatch1Base(gID,pID,subPatch,mesh,mesh->getVertexBuffer(time),time,uv,edge_level,subdiv,simd_width) {}
+
+  SubdivPatch1Base::SubdivPatch1Base (const unsigned int gID,
+                                      const unsigned int pID,
+                                      const unsigned int subPatch,
+                                      const SubdivMesh *const mesh,
+                                      const BufferRefT<Vec3fa>& vertices,
+                                      const size_t time,
+                                      const Vec2f uv[4],
+                                      const float edge_level[4],
+                                      const int subdiv[4],
+                                      const int simd_width)
   : flags(0), type(INVALID_PATCH), geom(gID), prim(pID), time_(unsigned(time))
   {
     static_assert(sizeof(SubdivPatch1Base) == 5 * 64, "SubdivPatch1Base has wrong size");
 
     const HalfEdge* edge = mesh->getHalfEdge(pID);
 
-    if (edge->patch_type == HalfEdge::REGULAR_QUAD_PATCH) 
+    /* patches with a precomputed grid stencil never need their control points */
+    float stencil_level[4]; computeEdgeLevels(edge_level,subdiv,stencil_level);
+    if (mesh->getGridStencil(pID,subPatch,stencil_level))
+    {
+      type = EVAL_PATCH;
+      set_edge(edge);
+      set_subPatch(subPatch);
+    }
+    else if (edge->patch_type == HalfEdge::REGULAR_QUAD_PATCH) 
     {
 #if PATCH_USE_BEZIER_PATCH 
       type = BEZIER_PATCH;
-      new (patch_v) BezierPatch3fa(BSplinePatch3fa(CatmullClarkPatch3fa(edge,mesh->getVertexBuffer(time))));
+      new (patch_v) BezierPatch3fa(BSplinePatch3fa(CatmullClarkPatch3fa(edge,vertices)));
 #else
       type = BSPLINE_PATCH;
-      new (patch_v) BSplinePatch3fa(CatmullClarkPatch3fa(edge,mesh->getVertexBuffer(time))); // FIXME: init BSpline directly from half edge structure
+      new (patch_v) BSplinePatch3fa(CatmullClarkPatch3fa(edge,vertices)); // FIXME: init BSpline directly from half edge structure
 #endif      
     }
 #if PATCH_USE_GREGORY == 2
     else if (edge->patch_type == HalfEdge::IRREGULAR_QUAD_PATCH) 
     {
       type = GREGORY_PATCH;
-      new (patch_v) DenseGregoryPatch3fa(GregoryPatch3fa(CatmullClarkPatch3fa(edge,mesh->getVertexBuffer(time))));
+      new (patch_v) DenseGregoryPatch3fa(GregoryPatch3fa(CatmullClarkPatch3fa(edge,vertices)));
     }
 #endif
     else
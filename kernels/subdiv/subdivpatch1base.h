@@ -58,6 +58,18 @@ namespace embree
                       const int subdiv[4],
                       const int simd_width);
 
+    /*! Constructs the patch from some other vertex buffer of the same topology. */
+    SubdivPatch1Base (const unsigned int gID,
+                      const unsigned int pID,
+                      const unsigned int subPatch,
+                      const SubdivMesh *const mesh,
+                      const BufferRefT<Vec3fa>& vertices,
+                      const size_t time,
+                      const Vec2f uv[4],
+                      const float edge_level[4],
+                      const int subdiv[4],
+                      const int simd_width);
+
     __forceinline bool needsStitching() const {
       return flags & TRANSITION_PATCH;      
     }
@@ -158,5 +170,9 @@ namespace embree
                            const unsigned y0, const unsigned y1,
                            const unsigned swidth, const unsigned sheight,
                            const SubdivMesh* const geom);
+
+    /* precomputes the limit stencils of all grid vertices of some sub patch, basis is a zero initialized scratch buffer */
+    void updateGridStencil(SubdivMesh* const geom, const unsigned prim, const unsigned subPatch, 
+                           const Vec2f uv[4], const float edge_level[4], const int subdiv[4], avector<Vec3fa>& basis);
   }
 }
@@ -66,17 +66,101 @@ namespace embree
       return Vec3<simdf>( zero );
     }
 
-    /* eval grid over patch and stich edges when required */      
-    void evalGrid(const SubdivPatch1Base& patch,
-                  const unsigned x0, const unsigned x1,
-                  const unsigned y0, const unsigned y1,
-                  const unsigned swidth, const unsigned sheight,
-                  float *__restrict__ const grid_x,
-                  float *__restrict__ const grid_y,
-                  float *__restrict__ const grid_z,
-                  float *__restrict__ const grid_u,
-                  float *__restrict__ const grid_v,
-                  const SubdivMesh* const geom)
+    /* returns the precomputed grid stencil of the patch if there is a valid one */
+    static __forceinline const SubdivMesh::GridStencil* getGridStencil(const SubdivPatch1Base& patch, const SubdivMesh* const geom)
+    {
+      const unsigned subPatch = patch.type == SubdivPatch1Base::EVAL_PATCH ? patch.subPatch() : 0;
+      return geom->getGridStencil(patch.prim,subPatch,patch.level);
+    }
+
+    /* eval grid as weighted sum of the control vertices of the patch */
+    static void evalGridStencil(const SubdivMesh::GridStencil& stencil,
+                                const unsigned x0, const unsigned x1,
+                                const unsigned y0, const unsigned y1,
+                                float *__restrict__ const grid_x,
+                                float *__restrict__ const grid_y,
+                                float *__restrict__ const grid_z,
+                                float *__restrict__ const grid_u,
+                                float *__restrict__ const grid_v,
+                                const BufferRefT<Vec3fa>& vertices)
+    {
+      const unsigned dwidth  = x1-x0+1;
+      const unsigned dheight = y1-y0+1;
+      const unsigned M = dwidth*dheight+VSIZEX;
+      const unsigned grid_size_simd_blocks = (M-1)/VSIZEX;
+      const size_t numGridVertices = size_t(stencil.width)*size_t(stencil.height);
+
+      /* gather control vertices relative to the first one, which keeps
+       * rounding errors small and neighbouring patches watertight */
+      const size_t K = stencil.indices.size();
+      dynamic_large_stack_array(float,cv_x,K,64*sizeof(float));
+      dynamic_large_stack_array(float,cv_y,K,64*sizeof(float));
+      dynamic_large_stack_array(float,cv_z,K,64*sizeof(float));
+      const Vec3fa o = vertices[stencil.indices[0]];
+      for (size_t k=0; k<K; k++) {
+        const Vec3fa p = vertices[stencil.indices[k]]-o;
+        cv_x[k] = p.x; cv_y[k] = p.y; cv_z[k] = p.z;
+      }
+
+      auto evalBlock = [&] (const size_t src, const size_t dst)
+      {
+        vfloatx px = zero, py = zero, pz = zero;
+        for (size_t k=0; k<K; k++) {
+          const vfloatx w = vfloatx::loadu(&stencil.weights[k*numGridVertices+src]);
+          px = madd(w,vfloatx(cv_x[k]),px);
+          py = madd(w,vfloatx(cv_y[k]),py);
+          pz = madd(w,vfloatx(cv_z[k]),pz);
+        }
+        vfloatx::storeu(&grid_x[dst],px+vfloatx(o.x));
+        vfloatx::storeu(&grid_y[dst],py+vfloatx(o.y));
+        vfloatx::storeu(&grid_z[dst],pz+vfloatx(o.z));
+        vfloatx::storeu(&grid_u[dst],vfloatx::loadu(&stencil.grid_u[src]));
+        vfloatx::storeu(&grid_v[dst],vfloatx::loadu(&stencil.grid_v[src]));
+      };
+
+      /* the full grid is stored contiguously in the stencil, thus can get evaluated without per-row padding */
+      if (dwidth == stencil.width && dheight == stencil.height)
+      {
+        for (size_t i=0; i<numGridVertices; i+=VSIZEX)
+          evalBlock(i,i);
+      }
+
+      /* the last SIMD block of each row may write into the next row, which gets overwritten afterwards */
+      else 
+      {
+        for (unsigned y=0; y<dheight; y++)
+          for (unsigned x=0; x<dwidth; x+=VSIZEX)
+            evalBlock(size_t(y0+y)*stencil.width+x0+x,size_t(y)*dwidth+x);
+      }
+
+      /* set last elements in u,v array to last valid point */
+      const float last_u = grid_u[dwidth*dheight-1];
+      const float last_v = grid_v[dwidth*dheight-1];
+      const float last_x = grid_x[dwidth*dheight-1];
+      const float last_y = grid_y[dwidth*dheight-1];
+      const float last_z = grid_z[dwidth*dheight-1];
+      for (unsigned i=dwidth*dheight;i<grid_size_simd_blocks*VSIZEX;i++)
+      {
+        grid_u[i] = last_u;
+        grid_v[i] = last_v;
+        grid_x[i] = last_x;
+        grid_y[i] = last_y;
+        grid_z[i] = last_z;
+      }
+    }
+
+    /* eval grid over patch using the specified vertex buffer and stich edges when required */      
+    static void evalGrid(const SubdivPatch1Base& patch,
+                         const unsigned x0, const unsigned x1,
+                         const unsigned y0, const unsigned y1,
+                         const unsigned swidth, const unsigned sheight,
+                         float *__restrict__ const grid_x,
+                         float *__restrict__ const grid_y,
+                         float *__restrict__ const grid_z,
+                         float *__restrict__ const grid_u,
+                         float *__restrict__ const grid_v,
+                         const SubdivMesh* const geom,
+                         const BufferRefT<Vec3fa>& vertices)
     {
       const unsigned dwidth  = x1-x0+1;
       const unsigned dheight = y1-y0+1;
@@ -102,7 +186,7 @@ namespace embree
         }
         else 
         {
-          GeneralCatmullClarkPatch3fa ccpatch(patch.edge(),geom->getVertexBuffer(patch.time()));
+          GeneralCatmullClarkPatch3fa ccpatch(patch.edge(),vertices);
           
           feature_adaptive_eval_grid<FeatureAdaptiveEvalGrid,GeneralCatmullClarkPatch3fa> 
             (ccpatch, patch.subPatch(), patch.needsStitching() ? patch.level : nullptr,
@@ -197,6 +281,24 @@ namespace embree
     }
 
 
+    /* eval grid over patch and stich edges when required */      
+    void evalGrid(const SubdivPatch1Base& patch,
+                  const unsigned x0, const unsigned x1,
+                  const unsigned y0, const unsigned y1,
+                  const unsigned swidth, const unsigned sheight,
+                  float *__restrict__ const grid_x,
+                  float *__restrict__ const grid_y,
+                  float *__restrict__ const grid_z,
+                  float *__restrict__ const grid_u,
+                  float *__restrict__ const grid_v,
+                  const SubdivMesh* const geom)
+    {
+      if (const SubdivMesh::GridStencil* stencil = getGridStencil(patch,geom))
+        evalGridStencil(*stencil,x0,x1,y0,y1,grid_x,grid_y,grid_z,grid_u,grid_v,geom->getVertexBuffer(patch.time()));
+      else
+        evalGrid(patch,x0,x1,y0,y1,swidth,sheight,grid_x,grid_y,grid_z,grid_u,grid_v,geom,geom->getVertexBuffer(patch.time()));
+    }
+
     /* eval grid over patch and stich edges when required */      
     BBox3fa evalGridBounds(const SubdivPatch1Base& patch,
                            const unsigned x0, const unsigned x1,
@@ -212,7 +314,24 @@ namespace embree
       dynamic_large_stack_array(float,grid_u,M,64*64*sizeof(float));
       dynamic_large_stack_array(float,grid_v,M,64*64*sizeof(float));
 
-      if (unlikely(patch.type == SubdivPatch1Base::EVAL_PATCH))
+      if (const SubdivMesh::GridStencil* stencil = getGridStencil(patch,geom))
+      {
+        dynamic_large_stack_array(float,grid_x,M,64*64*sizeof(float));
+        dynamic_large_stack_array(float,grid_y,M,64*64*sizeof(float));
+        dynamic_large_stack_array(float,grid_z,M,64*64*sizeof(float));
+        evalGridStencil(*stencil,x0,x1,y0,y1,grid_x,grid_y,grid_z,grid_u,grid_v,geom->getVertexBuffer(patch.time()));
+
+        Vec3<vfloatx> bounds_min(pos_inf), bounds_max(neg_inf);
+        for (unsigned i=0; i<grid_size_simd_blocks; i++)
+        {
+          const Vec3<vfloatx> vtx(vfloatx::loadu(&grid_x[i*VSIZEX]),vfloatx::loadu(&grid_y[i*VSIZEX]),vfloatx::loadu(&grid_z[i*VSIZEX]));
+          bounds_min = min(bounds_min,vtx);
+          bounds_max = max(bounds_max,vtx);
+        }
+        b.lower = Vec3fa(reduce_min(bounds_min.x),reduce_min(bounds_min.y),reduce_min(bounds_min.z));
+        b.upper = Vec3fa(reduce_max(bounds_max.x),reduce_max(bounds_max.y),reduce_max(bounds_max.z));
+      }
+      else if (unlikely(patch.type == SubdivPatch1Base::EVAL_PATCH))
       {
         const bool displ = geom->displFunc || geom->displFunc2;
         dynamic_large_stack_array(float,grid_x,M,64*64*sizeof(float));
@@ -377,5 +496,120 @@ namespace embree
       assert(b.lower.z <= b.upper.z);
       return b;
     }
+
+    /* gathers all vertices of the faces around the vertices of some face, these are all control vertices of the limit patch */
+    static void gatherSupport(const HalfEdge* const face, std::vector<unsigned>& indices)
+    {
+      const HalfEdge* e = face;
+      do {
+        const HalfEdge* p = e;
+        do
+        {
+          const HalfEdge* f = p;
+          do {
+            if (std::find(indices.begin(),indices.end(),f->getStartVertexIndex()) == indices.end())
+              indices.push_back(f->getStartVertexIndex());
+            f = f->next();
+          } while (f != p);
+          
+          /* continue with next face */
+          p = p->prev();
+          if (likely(p->hasOpposite())) 
+            p = p->opposite();
+          
+          /* if there is no opposite go the long way to the other side of the border */
+          else
+          {
+            p = e;
+            while (p->hasOpposite()) 
+              p = p->rotate();
+          }
+        } while (p != e);
+        e = e->next();
+      } while (e != face);
+    }
+
+    void updateGridStencil(SubdivMesh* const geom, const unsigned prim, const unsigned subPatch, 
+                           const Vec2f uv[4], const float edge_level[4], const int subdiv[4], avector<Vec3fa>& basis)
+    {
+      /* regular faces directly evaluate their B-spline control points, which is cheaper than a dense stencil */
+      const HalfEdge* face = geom->getHalfEdge(prim);
+      if (face->patch_type == HalfEdge::REGULAR_QUAD_PATCH)
+        return;
+
+      /* nothing to do if the stencil is still valid */
+      float level[4]; SubdivPatch1Base::computeEdgeLevels(edge_level,subdiv,level);
+      SubdivMesh::GridStencil& stencil = geom->gridStencil(prim,subPatch);
+      if (stencil.matches(geom->topologyID,level)) 
+        return;
+
+      stencil.topologyID = geom->topologyID;
+      for (size_t i=0; i<4; i++) stencil.level[i] = level[i];
+      stencil.valid = false;
+      stencil.indices.clear();
+      gatherSupport(face,stencil.indices);
+
+      /* evaluating the patch over a vertex buffer that is zero except for a
+       * single unit vertex yields the weights of that vertex, each evaluation
+       * calculates the weights of three vertices through the x, y, and z channels */
+      const size_t numVertices = geom->getVertexBuffer().size();
+      if (basis.size() != numVertices) {
+        basis.resize(numVertices);
+        for (size_t i=0; i<numVertices; i++) basis[i] = Vec3fa(zero);
+      }
+      BufferRefT<Vec3fa> vertices(numVertices,sizeof(Vec3fa));
+      vertices.set((char*)basis.data(),sizeof(Vec3fa));
+      
+      const size_t K = stencil.indices.size();
+      for (size_t k=0; k<K; k+=3)
+      {
+        for (size_t i=0; i<3 && k+i<K; i++)
+          basis[stencil.indices[k+i]][i] = 1.0f;
+
+        SubdivPatch1Base patch(geom->id,prim,subPatch,geom,vertices,0,uv,edge_level,subdiv,VSIZEX);
+        const unsigned width = patch.grid_u_res;
+        const unsigned height = patch.grid_v_res;
+        const size_t N = size_t(width)*size_t(height);
+        const unsigned M = unsigned(N)+VSIZEX;
+        if (k == 0) 
+        {
+          stencil.width = width;
+          stencil.height = height;
+          stencil.weights.resize(K*N+VSIZEX);
+          stencil.grid_u.resize(N+VSIZEX);
+          stencil.grid_v.resize(N+VSIZEX);
+        }
+        
+        dynamic_large_stack_array(float,grid_x,M,64*64*sizeof(float));
+        dynamic_large_stack_array(float,grid_y,M,64*64*sizeof(float));
+        dynamic_large_stack_array(float,grid_z,M,64*64*sizeof(float));
+        dynamic_large_stack_array(float,grid_u,M,64*64*sizeof(float));
+        dynamic_large_stack_array(float,grid_v,M,64*64*sizeof(float));
+        evalGrid(patch,0,width-1,0,height-1,width,height,grid_x,grid_y,grid_z,grid_u,grid_v,geom,vertices);
+
+        const float* grid[3] = { grid_x, grid_y, grid_z };
+        for (size_t i=0; i<3 && k+i<K; i++) {
+          for (size_t j=0; j<N; j++) stencil.weights[(k+i)*N+j] = grid[i][j];
+          basis[stencil.indices[k+i]][i] = 0.0f;
+        }
+        if (k == 0) {
+          for (size_t j=0; j<N+VSIZEX; j++) stencil.grid_u[j] = grid_u[min(j,N-1)];
+          for (size_t j=0; j<N+VSIZEX; j++) stencil.grid_v[j] = grid_v[min(j,N-1)];
+        }
+      }
+      for (size_t j=K*stencil.width*stencil.height; j<stencil.weights.size(); j++) 
+        stencil.weights[j] = 0.0f;
+      
+      /* the weights of each grid vertex have to form an affine combination,
+       * otherwise the patch depends on vertices outside the gathered set */
+      const size_t N = size_t(stencil.width)*size_t(stencil.height);
+      for (size_t j=0; j<N; j++) 
+      {
+        float sum = 0.0f;
+        for (size_t k=0; k<K; k++) sum += stencil.weights[k*N+j];
+        if (!(abs(sum-1.0f) < 1E-3f)) return;
+      }
+      stencil.valid = true;
+    }
   }
 }
@@ -28,7 +28,8 @@ namespace embree
     SHADER_NG = 3,
     SHADER_GEOMID = 4,
     SHADER_GEOMID_PRIMID = 5,
-    SHADER_AMBIENT_OCCLUSION = 6
+    SHADER_AMBIENT_OCCLUSION = 6,
+    SHADER_HEATMAP = 7
   };
 
   /*! Scene representing the OBJ file */
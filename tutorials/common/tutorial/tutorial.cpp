@@ -168,6 +168,7 @@ namespace embree
         else if (mode == "geomID"  ) shader = SHADER_GEOMID;
         else if (mode == "primID"  ) shader = SHADER_GEOMID_PRIMID;
         else if (mode == "ao"      ) shader = SHADER_AMBIENT_OCCLUSION;
+        else if (mode == "heatmap" ) shader = SHADER_HEATMAP;
         else throw std::runtime_error("invalid shader:" +mode);
       }, 
       "--shader <string>: sets shader to use at startup\n"
@@ -177,7 +178,8 @@ namespace embree
       "  Ng: visualization of shading normal\n"
       "  geomID: visualization of geometry ID\n"
       "  primID: visualization of geometry and primitive ID\n"
-      "  ao: ambient occlusion shader");
+      "  ao: ambient occlusion shader\n"
+      "  heatmap: traversal cost per geometry (requires EMBREE_COST_COUNTERS, otherwise per pixel)");
 
     if (features & FEATURE_STREAM)
     {
@@ -379,6 +381,7 @@ namespace embree
         double t0 = getSeconds();
         device_render(pixels,width,height,0.0f,ispccamera);
         double t1 = getSeconds();
+        device_gather_costs();
         std::cout << "frame [" << std::setw(3) << i << " / " << std::setw(3) << numTotalFrames << "]: " <<  std::setw(8) << 1.0/(t1-t0) << " fps (skipped)" << std::endl << std::flush;
         if (benchmarkSleep) sleepSeconds(0.1);
       }
@@ -388,6 +391,7 @@ namespace embree
         double t0 = getSeconds();
         device_render(pixels,width,height,0.0f,ispccamera);
         double t1 = getSeconds();
+        device_gather_costs();
 
         float fr = float(1.0/(t1-t0));
         stat.add(fr);
@@ -432,6 +436,12 @@ namespace embree
     resize(width,height);
     ISPCCamera ispccamera = camera.getISPCCamera(width,height);
     device_render(pixels,width,height,0.0f,ispccamera);
+    device_gather_costs();
+
+    /* the heatmap shows the costs of the previous frame */
+    if (shader == SHADER_HEATMAP) 
+      device_render(pixels,width,height,0.0f,ispccamera);
+
     Ref<Image> image = new Image4uc(width, height, (Col4uc*)pixels);
     storeImage(image, fileName);
   }
@@ -582,6 +592,7 @@ namespace embree
     double t0 = getSeconds();
     device_render(pixels,width,height,float(time0-t0),ispccamera);
     double dt0 = getSeconds()-t0;
+    device_gather_costs();
 
     /* draw pixels to screen */
     glDrawPixels(width,height,GL_RGBA,GL_UNSIGNED_BYTE,pixels);
@@ -679,6 +690,7 @@ namespace embree
     case SHADER_GEOMID  : device_key_pressed(GLUT_KEY_F6); break;
     case SHADER_GEOMID_PRIMID: device_key_pressed(GLUT_KEY_F7); break;
     case SHADER_AMBIENT_OCCLUSION: device_key_pressed(GLUT_KEY_F11); break;
+    case SHADER_HEATMAP: device_key_pressed(KEY_HEATMAP); break;
     };
     
     /* benchmark mode */
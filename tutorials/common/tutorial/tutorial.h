@@ -32,6 +32,9 @@ namespace embree
   extern "C" void device_key_pressed (int key);
   extern "C" void device_cleanup();
 
+  /* functions provided by the common tutorial device code */
+  extern "C" void device_gather_costs();
+
   class TutorialApplication : public Application
   {
   public:
@@ -19,7 +19,8 @@
 
 namespace embree {
 
-/* the scene to render */
+/* the device and scene to render */
+extern RTCDevice g_device;
 extern RTCScene g_scene;
 
 /* intensity scaling for traversal cost visualization */
@@ -432,6 +433,102 @@ void renderTileCycles(int taskIndex,
   }
 }
 
+/* traversal costs per geometry of the previous frame for the heatmap shader */
+RTCCosts* g_costs = nullptr;
+size_t g_num_costs = 0;
+float g_costs_scale = 0.0f;
+
+/* maps a value in [0,1] to a blue to red heat color */
+Vec3fa heatColor(const float f)
+{
+  const float r = clamp(1.5f-abs(4.0f*f-3.0f),0.0f,1.0f);
+  const float g = clamp(1.5f-abs(4.0f*f-2.0f),0.0f,1.0f);
+  const float b = clamp(1.5f-abs(4.0f*f-1.0f),0.0f,1.0f);
+  return Vec3fa(r,g,b);
+}
+
+/* vizualizes the traversal cost of the geometry seen through a pixel */
+Vec3fa renderPixelHeatmap(float x, float y, const ISPCCamera& camera)
+{
+  /* initialize ray */
+  RTCRay ray;
+  ray.org = Vec3fa(camera.xfm.p);
+  ray.dir = Vec3fa(normalize(x*camera.xfm.l.vx + y*camera.xfm.l.vy + camera.xfm.l.vz));
+  ray.tnear = 0.0f;
+  ray.tfar = inf;
+  ray.geomID = RTC_INVALID_GEOMETRY_ID;
+  ray.primID = RTC_INVALID_GEOMETRY_ID;
+  ray.instID = RTC_INVALID_GEOMETRY_ID;
+  ray.mask = -1;
+  ray.time = g_debug;
+
+  /* intersect ray with scene */
+  int64_t c0 = get_tsc();
+  rtcIntersect(g_scene,ray);
+  int64_t c1 = get_tsc();
+
+  /* without cost counters we can only show the cost of this pixel */
+  if (g_costs == nullptr) 
+    return heatColor((float)(c1-c0)*scale);
+
+  /* shade pixel by the costs of the hit geometry or instance */
+  if (ray.geomID == RTC_INVALID_GEOMETRY_ID) return Vec3fa(0.0f);
+  const unsigned int id = ray.instID != RTC_INVALID_GEOMETRY_ID ? ray.instID : ray.geomID;
+  float cost = 0.0f;
+  if (id < g_num_costs) cost = (float)(g_costs[id].nodes + g_costs[id].prims + g_costs[id].filters);
+  const float light = 0.5f+0.5f*abs(dot(normalize(ray.dir),normalize(ray.Ng)));
+  return heatColor(log(1.0f+cost)*g_costs_scale)*Vec3fa(light);
+}
+
+void renderTileHeatmap(int taskIndex,
+                       int* pixels,
+                       const unsigned int width,
+                       const unsigned int height,
+                       const float time,
+                       const ISPCCamera& camera,
+                       const int numTilesX,
+                       const int numTilesY)
+{
+  const int t = taskIndex;
+  const unsigned int tileY = t / numTilesX;
+  const unsigned int tileX = t - tileY * numTilesX;
+  const unsigned int x0 = tileX * TILE_SIZE_X;
+  const unsigned int x1 = min(x0+TILE_SIZE_X,width);
+  const unsigned int y0 = tileY * TILE_SIZE_Y;
+  const unsigned int y1 = min(y0+TILE_SIZE_Y,height);
+
+  for (unsigned int y=y0; y<y1; y++) for (unsigned int x=x0; x<x1; x++)
+  {
+    Vec3fa color = renderPixelHeatmap((float)x,(float)y,camera);
+
+    /* write color to framebuffer */
+    unsigned int r = (unsigned int) (255.0f * clamp(color.x,0.0f,1.0f));
+    unsigned int g = (unsigned int) (255.0f * clamp(color.y,0.0f,1.0f));
+    unsigned int b = (unsigned int) (255.0f * clamp(color.z,0.0f,1.0f));
+    pixels[y*width+x] = (b << 16) + (g << 8) + r;
+  }
+}
+
+/* gathers the traversal costs of the last frame for the heatmap shader */
+extern "C" void device_gather_costs()
+{
+  if (renderTile != renderTileHeatmap || g_scene == nullptr) return;
+  if (!rtcDeviceGetParameter1i(g_device,RTC_CONFIG_COST_COUNTERS)) return;
+
+  const size_t numGeometries = rtcGetCosts(g_scene,nullptr,0,nullptr);
+  if (numGeometries > g_num_costs) {
+    alignedFree(g_costs);
+    g_costs = (RTCCosts*) alignedMalloc(numGeometries*sizeof(RTCCosts));
+    g_num_costs = numGeometries;
+  }
+  rtcGetCosts(g_scene,g_costs,g_num_costs,nullptr);
+
+  size_t maxCost = 0;
+  for (size_t i=0; i<g_num_costs; i++)
+    maxCost = max(maxCost,g_costs[i].nodes + g_costs[i].prims + g_costs[i].filters);
+  g_costs_scale = maxCost ? 1.0f/log(1.0f+(float)maxCost) : 0.0f;
+}
+
 /* renders a single pixel with UV shading and shoot ray 16 times for measurements */
 Vec3fa renderPixelUV16(float x, float y, const ISPCCamera& camera)
 {
@@ -778,6 +875,10 @@ extern "C" void device_key_pressed_default(int key)
     }
     g_changed = true;
   }
+  else if (key == KEY_HEATMAP) {
+    renderTile = renderTileHeatmap;
+    g_changed = true;
+  }
 }
 
 /* called when a key is pressed */
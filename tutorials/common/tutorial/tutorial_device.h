@@ -86,6 +86,9 @@ inline Vec3fa faceforward( const Vec3fa& N, const Vec3fa& I, const Vec3fa& Ng )
 #define GLUT_KEY_F12 12
 #endif
 
+/* key to switch to the traversal cost heatmap shader */
+#define KEY_HEATMAP 72 /*H*/
+
 /* standard shading function */
 typedef void (* renderTileFunc)(int taskIndex,
                                         int* pixels,
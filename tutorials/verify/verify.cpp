@@ -993,6 +993,455 @@ namespace embree
     }
   };
 
+  struct CompactBuildTest : public VerifyApplication::Test
+  {
+    RTCSceneFlags sflags;
+
+    CompactBuildTest (std::string name, int isa, RTCSceneFlags sflags)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+    
+    VerifyApplication::TestReturnValue run (VerifyApplication* state, bool silent)
+    {
+      /* second device builds upper levels with compact primrefs */
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device0 = rtcNewDevice(cfg.c_str());
+      errorHandler(rtcDeviceGetError(device0));
+      RTCDeviceRef device1 = rtcNewDevice((cfg+",compact_build_threshold=1").c_str());
+      errorHandler(rtcDeviceGetError(device1));
+
+      VerifyScene scene0(device0,sflags,aflags);
+      VerifyScene scene1(device1,sflags,aflags);
+      Ref<SceneGraph::Node> tris  = SceneGraph::createTriangleSphere(Vec3fa(-1,0,0),1.0f,200);
+      Ref<SceneGraph::Node> quads = SceneGraph::createQuadSphere    (Vec3fa(+1,0,0),1.0f,200);
+      scene0.addGeometry(RTC_GEOMETRY_STATIC,tris); scene0.addGeometry(RTC_GEOMETRY_STATIC,quads);
+      scene1.addGeometry(RTC_GEOMETRY_STATIC,tris); scene1.addGeometry(RTC_GEOMETRY_STATIC,quads);
+      rtcCommit (scene0);
+      rtcCommit (scene1);
+      AssertNoError(device0);
+      AssertNoError(device1);
+
+      /* both hierarchies have to report the same hits */
+      for (size_t i=0; i<1000; i++)
+      {
+        const Vec3fa org = 10.0f*(2.0f*random_Vec3fa()-Vec3fa(1.0f));
+        const Vec3fa dir = Vec3fa(2,1,1)*(2.0f*random_Vec3fa()-Vec3fa(1.0f)) - org;
+        RTCRay ray0 = makeRay(org,dir); rtcIntersect(scene0,ray0);
+        RTCRay ray1 = makeRay(org,dir); rtcIntersect(scene1,ray1);
+        if (ray0.geomID != ray1.geomID) return VerifyApplication::FAILED;
+        if (ray0.geomID != RTC_INVALID_GEOMETRY_ID && abs(ray0.tfar-ray1.tfar) > 1E-5f) return VerifyApplication::FAILED;
+      }
+      AssertNoError(device0);
+      AssertNoError(device1);
+      
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct SweepBuildTest : public VerifyApplication::Test
+  {
+    RTCSceneFlags sflags;
+
+    SweepBuildTest (std::string name, int isa, RTCSceneFlags sflags)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+    
+    VerifyApplication::TestReturnValue run (VerifyApplication* state, bool silent)
+    {
+      /* second device finds all object splits by sweeping */
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device0 = rtcNewDevice((cfg+",sweep_build_threshold=0").c_str());
+      errorHandler(rtcDeviceGetError(device0));
+      RTCDeviceRef device1 = rtcNewDevice((cfg+",sweep_build_threshold=1").c_str());
+      errorHandler(rtcDeviceGetError(device1));
+
+      VerifyScene scene0(device0,sflags,aflags);
+      VerifyScene scene1(device1,sflags,aflags);
+      Ref<SceneGraph::Node> tris  = SceneGraph::createTriangleSphere(Vec3fa(-1,0,0),1.0f,200);
+      Ref<SceneGraph::Node> quads = SceneGraph::createQuadSphere    (Vec3fa(+1,0,0),1.0f,200);
+      scene0.addGeometry(RTC_GEOMETRY_STATIC,tris); scene0.addGeometry(RTC_GEOMETRY_STATIC,quads);
+      scene1.addGeometry(RTC_GEOMETRY_STATIC,tris); scene1.addGeometry(RTC_GEOMETRY_STATIC,quads);
+      rtcCommit (scene0);
+      rtcCommit (scene1);
+      AssertNoError(device0);
+      AssertNoError(device1);
+
+      /* both hierarchies have to report the same hits */
+      for (size_t i=0; i<1000; i++)
+      {
+        const Vec3fa org = 10.0f*(2.0f*random_Vec3fa()-Vec3fa(1.0f));
+        const Vec3fa dir = Vec3fa(2,1,1)*(2.0f*random_Vec3fa()-Vec3fa(1.0f)) - org;
+        RTCRay ray0 = makeRay(org,dir); rtcIntersect(scene0,ray0);
+        RTCRay ray1 = makeRay(org,dir); rtcIntersect(scene1,ray1);
+        if (ray0.geomID != ray1.geomID) return VerifyApplication::FAILED;
+        if (ray0.geomID != RTC_INVALID_GEOMETRY_ID && abs(ray0.tfar-ray1.tfar) > 1E-5f) return VerifyApplication::FAILED;
+      }
+      AssertNoError(device0);
+      AssertNoError(device1);
+      
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct TimeSplitBuildTest : public VerifyApplication::Test
+  {
+    RTCSceneFlags sflags;
+
+    TimeSplitBuildTest (std::string name, int isa, RTCSceneFlags sflags)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+    
+    VerifyApplication::TestReturnValue run (VerifyApplication* state, bool silent)
+    {
+      /* second device may split the time segments of motion blur builds */
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device0 = rtcNewDevice(cfg.c_str());
+      errorHandler(rtcDeviceGetError(device0));
+      RTCDeviceRef device1 = rtcNewDevice((cfg+",max_time_splits=8").c_str());
+      errorHandler(rtcDeviceGetError(device1));
+
+      /* fast moving spheres that cross each others paths */
+      VerifyScene scene0(device0,sflags,aflags);
+      VerifyScene scene1(device1,sflags,aflags);
+      std::vector<Vec3fa> pos, motion;
+      for (size_t i=0; i<64; i++)
+      {
+        pos.push_back(10.0f*(2.0f*random_Vec3fa()-Vec3fa(1.0f)));
+        motion.push_back(-2.0f*pos.back());
+        Ref<SceneGraph::Node> node = (i%2) ? SceneGraph::createQuadSphere(pos.back(),0.5f,10) : SceneGraph::createTriangleSphere(pos.back(),0.5f,10);
+        node = node->set_motion_vector(motion.back());
+        scene0.addGeometry(RTC_GEOMETRY_STATIC,node);
+        scene1.addGeometry(RTC_GEOMETRY_STATIC,node);
+      }
+      rtcCommit (scene0);
+      rtcCommit (scene1);
+      AssertNoError(device0);
+      AssertNoError(device1);
+
+      /* both hierarchies have to report the same hits */
+      for (size_t i=0; i<1000; i++)
+      {
+        const size_t k = size_t(random_int()) % pos.size();
+        const float time = random_float();
+        const Vec3fa org = 20.0f*(2.0f*random_Vec3fa()-Vec3fa(1.0f));
+        const Vec3fa dir = pos[k] + time*motion[k] + 0.5f*(2.0f*random_Vec3fa()-Vec3fa(1.0f)) - org;
+        RTCRay ray0 = makeRay(org,dir); ray0.time = time; rtcIntersect(scene0,ray0);
+        RTCRay ray1 = makeRay(org,dir); ray1.time = time; rtcIntersect(scene1,ray1);
+        if (ray0.geomID != ray1.geomID) return VerifyApplication::FAILED;
+        if (ray0.geomID != RTC_INVALID_GEOMETRY_ID && abs(ray0.tfar-ray1.tfar) > 1E-5f) return VerifyApplication::FAILED;
+      }
+      AssertNoError(device0);
+      AssertNoError(device1);
+      
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct QuantizedMBlurTest : public VerifyApplication::Test
+  {
+    RTCSceneFlags sflags;
+
+    QuantizedMBlurTest (std::string name, int isa, RTCSceneFlags sflags)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+    
+    VerifyApplication::TestReturnValue run (VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(rtcDeviceGetError(device));
+
+      /* compact scenes use quantized motion blur nodes */
+      VerifyScene scene0(device,sflags,aflags);
+      VerifyScene scene1(device,sflags | RTC_SCENE_COMPACT,aflags);
+      std::vector<Vec3fa> pos, motion;
+      for (size_t i=0; i<64; i++)
+      {
+        pos.push_back(10.0f*(2.0f*random_Vec3fa()-Vec3fa(1.0f)));
+        motion.push_back(2.0f*(2.0f*random_Vec3fa()-Vec3fa(1.0f)));
+        Ref<SceneGraph::Node> node = (i%2) ? SceneGraph::createQuadSphere(pos.back(),0.5f,10) : SceneGraph::createTriangleSphere(pos.back(),0.5f,10);
+        node = node->set_motion_vector(motion.back());
+        scene0.addGeometry(RTC_GEOMETRY_STATIC,node);
+        scene1.addGeometry(RTC_GEOMETRY_STATIC,node);
+      }
+      rtcCommit (scene0);
+      rtcCommit (scene1);
+      AssertNoError(device);
+
+      /* both hierarchies have to report the same hits */
+      for (size_t i=0; i<1000; i++)
+      {
+        const size_t k = size_t(random_int()) % pos.size();
+        const float time = random_float();
+        const Vec3fa org = 20.0f*(2.0f*random_Vec3fa()-Vec3fa(1.0f));
+        const Vec3fa dir = pos[k] + time*motion[k] + 0.5f*(2.0f*random_Vec3fa()-Vec3fa(1.0f)) - org;
+        RTCRay ray0 = makeRay(org,dir); ray0.time = time; rtcIntersect(scene0,ray0);
+        RTCRay ray1 = makeRay(org,dir); ray1.time = time; rtcIntersect(scene1,ray1);
+        if (ray0.geomID != ray1.geomID) return VerifyApplication::FAILED;
+        if (ray0.geomID != RTC_INVALID_GEOMETRY_ID && abs(ray0.tfar-ray1.tfar) > 1E-5f) return VerifyApplication::FAILED;
+      }
+      AssertNoError(device);
+      
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct ShortStackTraversalTest : public VerifyApplication::Test
+  {
+    RTCSceneFlags sflags;
+
+    ShortStackTraversalTest (std::string name, int isa, RTCSceneFlags sflags)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+
+    VerifyApplication::TestReturnValue run (VerifyApplication* state, bool silent)
+    {
+      /* second device traverses with a short stack */
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device0 = rtcNewDevice(cfg.c_str());
+      errorHandler(rtcDeviceGetError(device0));
+      RTCDeviceRef device1 = rtcNewDevice((cfg+",short_stack_traversal=1").c_str());
+      errorHandler(rtcDeviceGetError(device1));
+
+      /* deep hierarchies that overflow the short stack */
+      VerifyScene scene0(device0,sflags,aflags);
+      VerifyScene scene1(device1,sflags,aflags);
+      Ref<SceneGraph::Node> nodes[] = {
+        SceneGraph::createTriangleSphere(Vec3fa(-1,0,0),1.0f,200),
+        SceneGraph::createQuadSphere    (Vec3fa(+1,0,0),1.0f,200),
+        SceneGraph::createSubdivSphere  (Vec3fa(0,+2,0),1.0f,8,20),
+        SceneGraph::createHairyPlane    (1,Vec3fa(-2,-2,-2),Vec3fa(4,0,0),Vec3fa(0,0,4),1.0f,0.01f,10000,true)
+      };
+      for (auto node : nodes) {
+        scene0.addGeometry(RTC_GEOMETRY_STATIC,node);
+        scene1.addGeometry(RTC_GEOMETRY_STATIC,node);
+      }
+      rtcCommit (scene0);
+      rtcCommit (scene1);
+      AssertNoError(device0);
+      AssertNoError(device1);
+
+      /* both traversals have to report the same hits */
+      for (size_t i=0; i<1000; i++)
+      {
+        const Vec3fa org = 10.0f*(2.0f*random_Vec3fa()-Vec3fa(1.0f));
+        const Vec3fa dir = 2.0f*(2.0f*random_Vec3fa()-Vec3fa(1.0f)) - org;
+        RTCRay ray0 = makeRay(org,dir); rtcIntersect(scene0,ray0);
+        RTCRay ray1 = makeRay(org,dir); rtcIntersect(scene1,ray1);
+        if (ray0.geomID != ray1.geomID) return VerifyApplication::FAILED;
+        if (ray0.geomID != RTC_INVALID_GEOMETRY_ID && abs(ray0.tfar-ray1.tfar) > 1E-5f) return VerifyApplication::FAILED;
+
+        RTCRay shadow0 = makeRay(org,dir); rtcOccluded(scene0,shadow0);
+        RTCRay shadow1 = makeRay(org,dir); rtcOccluded(scene1,shadow1);
+        if (shadow0.geomID != shadow1.geomID) return VerifyApplication::FAILED;
+      }
+      AssertNoError(device0);
+      AssertNoError(device1);
+
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct OccluderCacheTest : public VerifyApplication::Test
+  {
+    RTCSceneFlags sflags;
+
+    OccluderCacheTest (std::string name, int isa, RTCSceneFlags sflags)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+
+    VerifyApplication::TestReturnValue run (VerifyApplication* state, bool silent)
+    {
+      /* second device caches the last occluder of each thread */
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device0 = rtcNewDevice(cfg.c_str());
+      errorHandler(rtcDeviceGetError(device0));
+      RTCDeviceRef device1 = rtcNewDevice((cfg+",occluder_cache=1").c_str());
+      errorHandler(rtcDeviceGetError(device1));
+
+      VerifyScene scene0(device0,sflags,aflags);
+      VerifyScene scene1(device1,sflags,aflags);
+      Ref<SceneGraph::Node> nodes[] = {
+        SceneGraph::createTriangleSphere(Vec3fa(-1,0,0),1.0f,50),
+        SceneGraph::createQuadSphere    (Vec3fa(+1,0,0),1.0f,50),
+        SceneGraph::createSubdivSphere  (Vec3fa(0,+2,0),1.0f,8,20),
+        SceneGraph::createHairyPlane    (1,Vec3fa(-2,-2,-2),Vec3fa(4,0,0),Vec3fa(0,0,4),1.0f,0.01f,1000,true)
+      };
+      for (auto node : nodes) {
+        scene0.addGeometry(RTC_GEOMETRY_STATIC,node);
+        scene1.addGeometry(RTC_GEOMETRY_STATIC,node);
+      }
+      rtcCommit (scene0);
+      rtcCommit (scene1);
+      AssertNoError(device0);
+      AssertNoError(device1);
+
+      for (size_t i=0; i<100; i++)
+      {
+        /* dynamic scenes get rebuilt, which invalidates the cached occluders */
+        if ((sflags & RTC_SCENE_DYNAMIC) && i == 50) {
+          rtcDisable(scene0,0); rtcCommit(scene0);
+          rtcDisable(scene1,0); rtcCommit(scene1);
+          AssertNoError(device0);
+          AssertNoError(device1);
+        }
+
+        /* coherent shadow rays from one point towards an area light */
+        const Vec3fa org = 4.0f*(2.0f*random_Vec3fa()-Vec3fa(1.0f));
+        const Vec3fa light = 4.0f*(2.0f*random_Vec3fa()-Vec3fa(1.0f));
+        for (size_t j=0; j<16; j++)
+        {
+          const Vec3fa dir = light + 0.2f*random_Vec3fa() - org;
+          RTCRay shadow0 = makeRay(org,dir,0.0f,1.0f); rtcOccluded(scene0,shadow0);
+          RTCRay shadow1 = makeRay(org,dir,0.0f,1.0f); rtcOccluded(scene1,shadow1);
+          if (shadow0.geomID != shadow1.geomID) return VerifyApplication::FAILED;
+        }
+      }
+      AssertNoError(device0);
+      AssertNoError(device1);
+
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct LazyInstanceTest : public VerifyApplication::Test
+  {
+    RTCSceneFlags sflags;
+
+    LazyInstanceTest (std::string name, int isa, RTCSceneFlags sflags)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+
+    VerifyApplication::TestReturnValue run (VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(rtcDeviceGetError(device));
+
+      /* the same spheres get instanced eagerly and lazily */
+      const size_t numObjects = 4;
+      std::vector<Ref<VerifyScene>> objects0, objects1;
+      for (size_t i=0; i<numObjects; i++)
+      {
+        Ref<SceneGraph::Node> node = SceneGraph::createTriangleSphere(zero,1.0f,10+10*i);
+        objects0.push_back(new VerifyScene(device,RTC_SCENE_DYNAMIC,aflags));
+        objects1.push_back(new VerifyScene(device,RTC_SCENE_DYNAMIC,aflags));
+        objects0[i]->addGeometry(RTC_GEOMETRY_STATIC,node);
+        objects1[i]->addGeometry(RTC_GEOMETRY_STATIC,node);
+        rtcCommit(*objects0[i]);
+      }
+      AssertNoError(device);
+
+      VerifyScene scene0(device,sflags,aflags);
+      VerifyScene scene1(device,sflags,aflags);
+      RTCBounds bounds = { -1.0f, -1.0f, -1.0f, 0.0f, +1.0f, +1.0f, +1.0f, 0.0f };
+      for (size_t i=0; i<4*numObjects; i++)
+      {
+        const AffineSpace3fa xfm = AffineSpace3fa::translate(Vec3fa(3.0f*float(i%4),0.0f,3.0f*float(i/4)));
+        unsigned geomID0 = rtcNewInstance2(scene0,*objects0[i%numObjects],1);
+        unsigned geomID1 = rtcNewLazyInstance(scene1,*objects1[i%numObjects],&bounds,1);
+        rtcSetTransform2(scene0,geomID0,RTC_MATRIX_COLUMN_MAJOR_ALIGNED16,(float*)&xfm,0);
+        rtcSetTransform2(scene1,geomID1,RTC_MATRIX_COLUMN_MAJOR_ALIGNED16,(float*)&xfm,0);
+      }
+      rtcCommit (scene0);
+      rtcCommit (scene1);
+      AssertNoError(device);
+
+      /* concurrent rays build the lazy instances */
+      const size_t numRays = 1000;
+      avector<Vec3fa> orgs(numRays), dirs(numRays);
+      for (size_t i=0; i<numRays; i++) {
+        orgs[i] = Vec3fa(4.5f,10.0f,4.5f) + 10.0f*(2.0f*random_Vec3fa()-Vec3fa(1.0f));
+        dirs[i] = Vec3fa(10.0f,1.0f,10.0f)*random_Vec3fa() - Vec3fa(0.5f,0.5f,0.5f) - orgs[i];
+      }
+      auto compare = [&] () -> bool
+      {
+        avector<RTCRay> rays0(numRays), rays1(numRays), shadows1(numRays);
+        parallel_for(numRays, [&] (size_t i) {
+            rays1[i] = makeRay(orgs[i],dirs[i]); rtcIntersect(scene1,rays1[i]);
+            shadows1[i] = makeRay(orgs[i],dirs[i]); rtcOccluded(scene1,shadows1[i]);
+          });
+        for (size_t i=0; i<numRays; i++)
+        {
+          rays0[i] = makeRay(orgs[i],dirs[i]); rtcIntersect(scene0,rays0[i]);
+          if (rays0[i].geomID != rays1[i].geomID || rays0[i].instID != rays1[i].instID || rays0[i].primID != rays1[i].primID) return false;
+          if (rays0[i].geomID != RTC_INVALID_GEOMETRY_ID && abs(rays0[i].tfar-rays1[i].tfar) > 1E-5f) return false;
+          if ((rays0[i].geomID == RTC_INVALID_GEOMETRY_ID) != (shadows1[i].geomID == RTC_INVALID_GEOMETRY_ID)) return false;
+        }
+        return true;
+      };
+      if (!compare()) return VerifyApplication::FAILED;
+      AssertNoError(device);
+
+      /* the first eviction only resets the access flags, the second one frees all objects */
+      rtcEvictLazyInstances(scene1);
+      if (rtcEvictLazyInstances(scene1) != numObjects) return VerifyApplication::FAILED;
+      if (!compare()) return VerifyApplication::FAILED;
+      AssertNoError(device);
+
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct CostCountersTest : public VerifyApplication::Test
+  {
+    RTCSceneFlags sflags;
+
+    CostCountersTest (std::string name, int isa, RTCSceneFlags sflags)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+
+    VerifyApplication::TestReturnValue run (VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(rtcDeviceGetError(device));
+      const bool enabled = rtcDeviceGetParameter1i(device,RTC_CONFIG_COST_COUNTERS);
+
+      /* two spheres far apart and an instanced sphere */
+      VerifyScene object(device,RTC_SCENE_STATIC,aflags);
+      object.addGeometry(RTC_GEOMETRY_STATIC,SceneGraph::createTriangleSphere(zero,1.0f,20));
+      rtcCommit(object);
+      VerifyScene scene(device,sflags,aflags);
+      unsigned geomID0 = scene.addGeometry(RTC_GEOMETRY_STATIC,SceneGraph::createTriangleSphere(Vec3fa(0,0,0),1.0f,20));
+      unsigned geomID1 = scene.addGeometry(RTC_GEOMETRY_STATIC,SceneGraph::createTriangleSphere(Vec3fa(100,0,0),1.0f,20));
+      unsigned geomID2 = rtcNewInstance2(scene,object,1);
+      const AffineSpace3fa xfm = AffineSpace3fa::translate(Vec3fa(-100,0,0));
+      rtcSetTransform2(scene,geomID2,RTC_MATRIX_COLUMN_MAJOR_ALIGNED16,(float*)&xfm,0);
+      rtcCommit(scene);
+      AssertNoError(device);
+
+      /* rays only pass the first sphere and the instance */
+      for (size_t i=0; i<100; i++) {
+        const Vec3fa org = Vec3fa(i%2 ? -100.0f : 0.0f,0,0) + Vec3fa(random_float()-0.5f,random_float()-0.5f,-10.0f);
+        RTCRay ray = makeRay(org,Vec3fa(0,0,1)); rtcIntersect(scene,ray);
+        if (ray.geomID == RTC_INVALID_GEOMETRY_ID) return VerifyApplication::FAILED;
+      }
+
+      /* querying the number of geometries does not reset the costs */
+      RTCCosts costs[4], scosts;
+      if (rtcGetCosts(scene,nullptr,0,nullptr) != 3) return VerifyApplication::FAILED;
+      if (rtcGetCosts(scene,costs,4,&scosts) != 3) return VerifyApplication::FAILED;
+      AssertNoError(device);
+      if (!enabled) 
+      {
+        /* without cost counters all costs are zero */
+        for (size_t i=0; i<4; i++)
+          if (costs[i].nodes || costs[i].prims || costs[i].filters) return VerifyApplication::FAILED;
+        return VerifyApplication::PASSED;
+      }
+
+      /* instanced work is charged to the instance, not the instanced scene */
+      if (costs[geomID0].prims == 0 || costs[geomID1].prims != 0) return VerifyApplication::FAILED;
+      if (costs[geomID2].prims == 0 || costs[geomID2].nodes == 0) return VerifyApplication::FAILED;
+      if (scosts.nodes == 0) return VerifyApplication::FAILED;
+      RTCCosts ocosts;
+      rtcGetCosts(object,&ocosts,1,nullptr);
+      if (ocosts.nodes || ocosts.prims) return VerifyApplication::FAILED;
+
+      /* getting the costs resets them */
+      rtcGetCosts(scene,costs,4,&scosts);
+      for (size_t i=0; i<4; i++)
+        if (costs[i].nodes || costs[i].prims || costs[i].filters) return VerifyApplication::FAILED;
+      if (scosts.nodes) return VerifyApplication::FAILED;
+      AssertNoError(device);
+
+      return VerifyApplication::PASSED;
+    }
+  };
+
   struct OverlappingGeometryTest : public VerifyApplication::Test
   {
     RTCSceneFlags sflags;
@@ -1318,6 +1767,170 @@ namespace embree
     }
   };
 
+  struct InvalidPrimitivesTest : public VerifyApplication::Test
+  {
+    RTCSceneFlags sflags;
+
+    InvalidPrimitivesTest (std::string name, int isa, RTCSceneFlags sflags)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+    
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(rtcDeviceGetError(device));
+
+      /* each primitive gets its own unit square, some of them use out of range indices or NaN/inf vertices */
+      const size_t N = 37;
+      const float values[2] = { nan, inf };
+      auto invalid = [] (size_t i) { return i%5 == 1 || i%7 == 3; };
+      VerifyScene scene(device,sflags,aflags);
+      for (size_t type=0; type<2; type++)
+      {
+        const size_t nv = type == 0 ? 3 : 4;
+        unsigned geomID = type == 0 ? rtcNewTriangleMesh(scene,RTC_GEOMETRY_STATIC,N,nv*N) : rtcNewQuadMesh(scene,RTC_GEOMETRY_STATIC,N,nv*N);
+        Vec3fa* vertices = (Vec3fa*) rtcMapBuffer(scene,geomID,RTC_VERTEX_BUFFER);
+        unsigned* indices = (unsigned*) rtcMapBuffer(scene,geomID,RTC_INDEX_BUFFER);
+        for (size_t i=0; i<N; i++)
+        {
+          const Vec3fa p(float(i),0.0f,float(type));
+          vertices[nv*i+0] = p; vertices[nv*i+1] = p+Vec3fa(1,0,0); vertices[nv*i+2] = p+Vec3fa(1,1,0);
+          if (nv == 4) vertices[nv*i+3] = p+Vec3fa(0,1,0);
+          for (size_t j=0; j<nv; j++) indices[nv*i+j] = unsigned(nv*i+j);
+          if (!invalid(i)) continue;
+          if (i%2) indices[nv*i+i%nv] = unsigned(i%3 ? nv*N : -1);
+          else     vertices[nv*i+i%nv].x = values[i%4/2];
+        }
+        rtcUnmapBuffer(scene,geomID,RTC_VERTEX_BUFFER);
+        rtcUnmapBuffer(scene,geomID,RTC_INDEX_BUFFER);
+      }
+      rtcCommit(scene);
+      AssertNoError(device);
+
+      /* rays towards the center of each valid primitive have to hit it, invalid primitives are never hit */
+      for (size_t type=0; type<2; type++)
+      {
+        for (size_t i=0; i<N; i++)
+        {
+          RTCRay ray = makeRay(Vec3fa(float(i)+0.75f,0.25f,float(type)-0.5f),Vec3fa(0,0,1),0.0f,1.0f);
+          rtcIntersect(scene,ray);
+          if (invalid(i)) {
+            if (ray.geomID != RTC_INVALID_GEOMETRY_ID) return VerifyApplication::FAILED;
+          } else {
+            if (ray.geomID != type || ray.primID != i) return VerifyApplication::FAILED;
+          }
+        }
+      }
+      AssertNoError(device);
+
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct SubdivStencilTableTest : public VerifyApplication::Test
+  {
+    RTCSceneFlags sflags;
+
+    SubdivStencilTableTest (std::string name, int isa, RTCSceneFlags sflags)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+
+    /* deformable cube with a triangulated top and deformable height field, both tessellated into grids */
+    static void createScene(RTCScene scene, const std::vector<Vec3fa>& cube, const std::vector<Vec3fa>& field, size_t W)
+    {
+      const unsigned cube_faces[7] = { 4, 4, 4, 4, 4, 3, 3 };
+      const unsigned cube_indices[26] = { 0,1,5,4, 1,2,6,5, 2,3,7,6, 3,0,4,7, 3,2,1,0, 4,5,6, 4,6,7 };
+      unsigned geomID0 = rtcNewSubdivisionMesh(scene,RTC_GEOMETRY_DEFORMABLE,7,26,8,0,0,0,1);
+      rtcSetBuffer(scene,geomID0,RTC_FACE_BUFFER,cube_faces,0,sizeof(unsigned));
+      rtcSetBuffer(scene,geomID0,RTC_INDEX_BUFFER,cube_indices,0,sizeof(unsigned));
+      rtcSetBuffer(scene,geomID0,RTC_VERTEX_BUFFER,cube.data(),0,sizeof(Vec3fa));
+      rtcSetTessellationRate(scene,geomID0,7.0f);
+      
+      unsigned geomID1 = rtcNewSubdivisionMesh(scene,RTC_GEOMETRY_DEFORMABLE,W*W,4*W*W,(W+1)*(W+1),0,0,0,1);
+      unsigned* faces = (unsigned*) rtcMapBuffer(scene,geomID1,RTC_FACE_BUFFER);
+      unsigned* indices = (unsigned*) rtcMapBuffer(scene,geomID1,RTC_INDEX_BUFFER);
+      for (size_t y=0; y<W; y++) {
+        for (size_t x=0; x<W; x++) {
+          const size_t i = y*W+x;
+          faces[i] = 4;
+          indices[4*i+0] = unsigned((y+0)*(W+1)+(x+0));
+          indices[4*i+1] = unsigned((y+0)*(W+1)+(x+1));
+          indices[4*i+2] = unsigned((y+1)*(W+1)+(x+1));
+          indices[4*i+3] = unsigned((y+1)*(W+1)+(x+0));
+        }
+      }
+      rtcUnmapBuffer(scene,geomID1,RTC_FACE_BUFFER);
+      rtcUnmapBuffer(scene,geomID1,RTC_INDEX_BUFFER);
+      rtcSetBuffer(scene,geomID1,RTC_VERTEX_BUFFER,field.data(),0,sizeof(Vec3fa));
+      rtcSetTessellationRate(scene,geomID1,5.0f);
+    }
+    
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device0 = rtcNewDevice((cfg+",subdiv_stencil_tables=0").c_str());
+      errorHandler(rtcDeviceGetError(device0));
+      RTCDeviceRef device1 = rtcNewDevice((cfg+",subdiv_stencil_tables=1").c_str());
+      errorHandler(rtcDeviceGetError(device1));
+
+      const size_t W = 8;
+      std::vector<Vec3fa> cube(8);
+      std::vector<Vec3fa> field((W+1)*(W+1));
+      auto deform = [&] () 
+      {
+        for (size_t i=0; i<8; i++) {
+          const Vec3fa p((i+1)&2 ? 1.0f : -1.0f, i&2 ? 1.0f : -1.0f, i&4 ? 1.0f : -1.0f);
+          cube[i] = (0.8f+0.4f*random_float())*p;
+        }
+        for (size_t y=0; y<=W; y++)
+          for (size_t x=0; x<=W; x++)
+            field[y*(W+1)+x] = Vec3fa(float(x)-0.5f*W,float(y)-0.5f*W,-4.0f-random_float());
+      };
+      deform();
+
+      /* scenes without and with stencil tables have to render the same surfaces */
+      RTCSceneRef scene0 = rtcDeviceNewScene(device0,sflags,aflags);
+      RTCSceneRef scene1 = rtcDeviceNewScene(device1,sflags,aflags);
+      createScene(scene0,cube,field,W);
+      createScene(scene1,cube,field,W);
+      AssertNoError(device0);
+      AssertNoError(device1);
+
+      for (size_t frame=0; frame<4; frame++)
+      {
+        if (frame) 
+        {
+          deform();
+          for (unsigned geomID=0; geomID<2; geomID++) {
+            rtcUpdateBuffer(scene0,geomID,RTC_VERTEX_BUFFER);
+            rtcUpdateBuffer(scene1,geomID,RTC_VERTEX_BUFFER);
+          }
+        }
+        rtcCommit(scene0);
+        rtcCommit(scene1);
+        AssertNoError(device0);
+        AssertNoError(device1);
+
+        for (size_t i=0; i<256; i++)
+        {
+          const Vec3fa dir = normalize(Vec3fa(2.0f*random_float()-1.0f,2.0f*random_float()-1.0f,2.0f*random_float()-1.0f));
+          const Vec3fa org = i%2 ? Vec3fa(-4.0f*dir) : Vec3fa(float(W)*(random_float()-0.5f),float(W)*(random_float()-0.5f),-10.0f);
+          RTCRay ray0 = makeRay(org,i%2 ? dir : Vec3fa(0,0,1));
+          RTCRay ray1 = ray0;
+          rtcIntersect(scene0,ray0);
+          rtcIntersect(scene1,ray1);
+          if (ray0.geomID != ray1.geomID) return VerifyApplication::FAILED;
+          if (ray0.geomID == RTC_INVALID_GEOMETRY_ID) continue;
+          if (ray0.primID != ray1.primID) return VerifyApplication::FAILED;
+          if (abs(ray0.tfar-ray1.tfar) > 1E-3f) return VerifyApplication::FAILED;
+        }
+      }
+      AssertNoError(device0);
+      AssertNoError(device1);
+      
+      return VerifyApplication::PASSED;
+    }
+  };
+
   /////////////////////////////////////////////////////////////////////////////////
   /////////////////////////////////////////////////////////////////////////////////
   /////////////////////////////////////////////////////////////////////////////////
@@ -1535,6 +2148,108 @@ namespace embree
     }
   };
 
+  struct InterpolateRegularSubdivTest : public VerifyApplication::Test
+  {
+    size_t N;
+    
+    InterpolateRegularSubdivTest (std::string name, int isa, size_t N)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), N(N) {}
+
+    /* compares single point interpolation against the stream interpolation, which always evaluates through the patch cache */
+    bool checkInterpolation(const RTCSceneRef& scene, int geomID, const unsigned* primIDs, const float* u, const float* v, RTCBufferType buffer)
+    {
+      float P1[4*256], dPdu1[4*256], dPdv1[4*256], ddPdudu1[4*256], ddPdvdv1[4*256], ddPdudv1[4*256];
+      int valid[4] = { -1, -1, -1, -1 };
+      rtcInterpolateN2(scene,geomID,valid,primIDs,u,v,4,buffer,P1,dPdu1,dPdv1,ddPdudu1,ddPdvdv1,ddPdudv1,N);
+
+      bool passed = true;
+      for (size_t k=0; k<4; k++)
+      {
+        float P0[256], dPdu0[256], dPdv0[256], ddPdudu0[256], ddPdvdv0[256], ddPdudv0[256];
+        rtcInterpolate2(scene,geomID,primIDs[k],u[k],v[k],buffer,P0,dPdu0,dPdv0,ddPdudu0,ddPdvdv0,ddPdudv0,N);
+        
+        for (size_t i=0; i<N; i++) {
+          passed &= fabsf(P0[i]-P1[4*i+k]) < 1E-4f;
+          passed &= fabsf(dPdu0[i]-dPdu1[4*i+k]) < 1E-3f;
+          passed &= fabsf(dPdv0[i]-dPdv1[4*i+k]) < 1E-3f;
+          passed &= fabsf(ddPdudu0[i]-ddPdudu1[4*i+k]) < 1E-2f;
+          passed &= fabsf(ddPdvdv0[i]-ddPdvdv1[4*i+k]) < 1E-2f;
+          passed &= fabsf(ddPdudv0[i]-ddPdudv1[4*i+k]) < 1E-2f;
+        }
+      }
+      return passed;
+    }
+    
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(rtcDeviceGetError(device));
+
+      /* grid of W*W quads, all inner faces are regular */
+      const size_t W = 6;
+      const size_t numFaces = W*W;
+      const size_t numVertices = (W+1)*(W+1);
+      std::vector<unsigned> faces(numFaces,4);
+      std::vector<unsigned> indices(4*numFaces);
+      std::vector<unsigned> flipped(4*numFaces);
+      for (size_t y=0; y<W; y++) {
+        for (size_t x=0; x<W; x++) {
+          const size_t i = y*W+x;
+          indices[4*i+0] = flipped[4*i+0] = unsigned((y+0)*(W+1)+(x+0));
+          indices[4*i+1] = flipped[4*i+3] = unsigned((y+0)*(W+1)+(x+1));
+          indices[4*i+2] = flipped[4*i+2] = unsigned((y+1)*(W+1)+(x+1));
+          indices[4*i+3] = flipped[4*i+1] = unsigned((y+1)*(W+1)+(x+0));
+        }
+      }
+      std::vector<float> vertices(numVertices*N+16);
+      std::vector<float> user_vertices0(numVertices*N+16);
+      std::vector<float> user_vertices1(numVertices*N+16);
+      for (auto& f : vertices) f = random_float();
+      for (auto& f : user_vertices0) f = random_float();
+      for (auto& f : user_vertices1) f = random_float();
+      
+      RTCSceneRef scene = rtcDeviceNewScene(device,RTC_SCENE_DYNAMIC,RTC_INTERPOLATE);
+      AssertNoError(device);
+      unsigned int geomID = rtcNewSubdivisionMesh(scene, RTC_GEOMETRY_DYNAMIC, numFaces, 4*numFaces, numVertices, 0, 0, 0, 1);
+      AssertNoError(device);
+      rtcSetBuffer(scene, geomID, RTC_FACE_BUFFER, faces.data(), 0, sizeof(unsigned));
+      rtcSetBuffer(scene, geomID, RTC_INDEX_BUFFER, indices.data(), 0, sizeof(unsigned));
+      rtcSetBuffer(scene, geomID, RTC_VERTEX_BUFFER0, vertices.data(), 0, N*sizeof(float));
+      rtcSetBuffer(scene, geomID, RTC_USER_VERTEX_BUFFER0, user_vertices0.data(), 0, N*sizeof(float));
+      rtcSetBuffer(scene, geomID, RTC_USER_VERTEX_BUFFER1, user_vertices1.data(), 0, N*sizeof(float));
+      AssertNoError(device);
+      rtcDisable(scene,geomID);
+      rtcCommit(scene);
+      AssertNoError(device);
+
+      bool passed = true;
+      for (size_t pass=0; pass<2; pass++)
+      {
+        for (size_t i=0; i<64; i++)
+        {
+          unsigned primIDs[4]; float u[4], v[4];
+          for (size_t k=0; k<4; k++) {
+            primIDs[k] = unsigned(size_t(random_int()) % numFaces);
+            u[k] = random_float(); v[k] = random_float();
+          }
+          /* interpolate the same faces from different buffers and interleave faces */
+          passed &= checkInterpolation(scene,geomID,primIDs,u,v,RTC_VERTEX_BUFFER0);
+          passed &= checkInterpolation(scene,geomID,primIDs,u,v,RTC_USER_VERTEX_BUFFER0);
+          passed &= checkInterpolation(scene,geomID,primIDs,u,v,RTC_USER_VERTEX_BUFFER1);
+        }
+
+        /* changing the topology has to invalidate cached stencils */
+        rtcSetBuffer(scene, geomID, RTC_INDEX_BUFFER, flipped.data(), 0, sizeof(unsigned));
+        rtcCommit(scene);
+        AssertNoError(device);
+      }
+      AssertNoError(device);
+
+      return (VerifyApplication::TestReturnValue) passed;
+    }
+  };
+
   struct InterpolateTrianglesTest : public VerifyApplication::Test
   {
     size_t N;
@@ -1796,25 +2511,153 @@ namespace embree
       }
       IntersectWithMode(imode,ivariant,scene,rays,256);
 
-      for (size_t i=0; i<256; i++)
+      for (size_t i=0; i<256; i++)
+      {
+        if (rays[i].geomID != 0) return VerifyApplication::FAILED;
+        
+        if (ivariant & VARIANT_OCCLUDED) continue;
+
+        if (rays[i].primID != 0) return VerifyApplication::FAILED;
+        if (abs(rays[i].u - u[i]) > 16.0f*float(ulp)) return VerifyApplication::FAILED;
+        if (abs(rays[i].v - v[i]) > 16.0f*float(ulp)) return VerifyApplication::FAILED;
+        if (abs(rays[i].tfar - 1.0f) > 16.0f*float(ulp)) return VerifyApplication::FAILED;
+        const Vec3fa org(rays[i].org[0],rays[i].org[1],rays[i].org[2]);
+        const Vec3fa dir(rays[i].dir[0],rays[i].dir[1],rays[i].dir[2]);
+        const Vec3fa ht  = org + rays[i].tfar*dir;
+        const Vec3fa huv = vertices[0] + rays[i].u*(vertices[1]-vertices[0]) + rays[i].v*(vertices[2]-vertices[0]);
+        if (reduce_max(abs(ht-huv)) > 16.0f*float(ulp)) return VerifyApplication::FAILED;
+        const Vec3fa Ng = normalize(Vec3fa(rays[i].Ng[0],rays[i].Ng[1],rays[i].Ng[2])); // FIXME: some geom normals are scaled!!!??
+        if (reduce_max(abs(Ng - Vec3fa(0.0f,0.0f,-1.0f))) > 16.0f*float(ulp)) return VerifyApplication::FAILED;
+      }
+      AssertNoError(device);
+
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct TrianglePairTest : public VerifyApplication::IntersectTest
+  {
+    RTCSceneFlags sflags; 
+
+    TrianglePairTest (std::string name, int isa, RTCSceneFlags sflags, IntersectMode imode, IntersectVariant ivariant)
+      : VerifyApplication::IntersectTest(name,isa,imode,ivariant,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      /* second device pairs adjacent triangles into quad leaves */
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device0 = rtcNewDevice(cfg.c_str());
+      errorHandler(rtcDeviceGetError(device0));
+      RTCDeviceRef device1 = rtcNewDevice((cfg+",tri_accel=bvh4.trianglepair4v").c_str());
+      errorHandler(rtcDeviceGetError(device1));
+      if (!supportsIntersectMode(device0,imode))
+        return VerifyApplication::SKIPPED;
+
+      /* closed and open meshes with an odd number of triangles leave some triangles unpaired */
+      VerifyScene scene0(device0,sflags,to_aflags(imode));
+      VerifyScene scene1(device1,sflags,to_aflags(imode));
+      Ref<SceneGraph::Node> nodes[] = {
+        SceneGraph::createTriangleSphere(Vec3fa(-1,0,0),1.0f,20),
+        SceneGraph::createTrianglePlane (Vec3fa(0,-2,-2),Vec3fa(0,0,4),Vec3fa(0,4,0),7,5)
+      };
+      for (auto node : nodes) {
+        scene0.addGeometry(RTC_GEOMETRY_STATIC,node);
+        scene1.addGeometry(RTC_GEOMETRY_STATIC,node);
+      }
+      rtcCommit (scene0);
+      rtcCommit (scene1);
+      AssertNoError(device0);
+      AssertNoError(device1);
+
+      RTCRay rays0[256], rays1[256];
+      for (size_t i=0; i<256; i++)
+      {
+        const Vec3fa org = 4.0f*(2.0f*random_Vec3fa()-Vec3fa(1.0f));
+        const Vec3fa dir = 2.0f*(2.0f*random_Vec3fa()-Vec3fa(1.0f)) - org;
+        rays0[i] = rays1[i] = makeRay(org,dir);
+      }
+      IntersectWithMode(imode,ivariant,scene0,rays0,256);
+      IntersectWithMode(imode,ivariant,scene1,rays1,256);
+
+      /* hits have to report the original primitive IDs and barycentric coordinates */
+      for (size_t i=0; i<256; i++)
+      {
+        if (ivariant & VARIANT_OCCLUDED) {
+          if ((rays0[i].geomID == RTC_INVALID_GEOMETRY_ID) != (rays1[i].geomID == RTC_INVALID_GEOMETRY_ID)) return VerifyApplication::FAILED;
+          continue;
+        }
+        if (rays0[i].geomID != rays1[i].geomID) return VerifyApplication::FAILED;
+        if (rays0[i].geomID == RTC_INVALID_GEOMETRY_ID) continue;
+        if (rays0[i].primID != rays1[i].primID) return VerifyApplication::FAILED;
+        if (abs(rays0[i].tfar-rays1[i].tfar) > 1E-5f) return VerifyApplication::FAILED;
+        if (abs(rays0[i].u-rays1[i].u) > 1E-4f) return VerifyApplication::FAILED;
+        if (abs(rays0[i].v-rays1[i].v) > 1E-4f) return VerifyApplication::FAILED;
+      }
+      AssertNoError(device0);
+      AssertNoError(device1);
+
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct TinySceneTest : public VerifyApplication::IntersectTest
+  {
+    RTCSceneFlags sflags; 
+
+    TinySceneTest (std::string name, int isa, RTCSceneFlags sflags, IntersectMode imode, IntersectVariant ivariant)
+      : VerifyApplication::IntersectTest(name,isa,imode,ivariant,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      /* second device always performs a full BVH build */
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device0 = rtcNewDevice(cfg.c_str());
+      errorHandler(rtcDeviceGetError(device0));
+      RTCDeviceRef device1 = rtcNewDevice((cfg+",tiny_scene_threshold=0").c_str());
+      errorHandler(rtcDeviceGetError(device1));
+      if (!supportsIntersectMode(device0,imode))
+        return VerifyApplication::SKIPPED;
+
+      for (size_t width=1; width<=12; width++)
       {
-        if (rays[i].geomID != 0) return VerifyApplication::FAILED;
-        
-        if (ivariant & VARIANT_OCCLUDED) continue;
+        /* scenes with up to 24 triangles and 12 quads */
+        VerifyScene scene0(device0,sflags,to_aflags(imode));
+        VerifyScene scene1(device1,sflags,to_aflags(imode));
+        Ref<SceneGraph::Node> nodes[] = {
+          SceneGraph::createTrianglePlane(Vec3fa(-2,-2,0),Vec3fa(4,0,0),Vec3fa(0,4,0),width,1),
+          SceneGraph::createQuadPlane    (Vec3fa(-2,0,-2),Vec3fa(4,0,0),Vec3fa(0,0,4),width,1)
+        };
+        for (auto node : nodes) {
+          scene0.addGeometry(RTC_GEOMETRY_STATIC,node);
+          scene1.addGeometry(RTC_GEOMETRY_STATIC,node);
+        }
+        rtcCommit (scene0);
+        rtcCommit (scene1);
+        AssertNoError(device0);
+        AssertNoError(device1);
 
-        if (rays[i].primID != 0) return VerifyApplication::FAILED;
-        if (abs(rays[i].u - u[i]) > 16.0f*float(ulp)) return VerifyApplication::FAILED;
-        if (abs(rays[i].v - v[i]) > 16.0f*float(ulp)) return VerifyApplication::FAILED;
-        if (abs(rays[i].tfar - 1.0f) > 16.0f*float(ulp)) return VerifyApplication::FAILED;
-        const Vec3fa org(rays[i].org[0],rays[i].org[1],rays[i].org[2]);
-        const Vec3fa dir(rays[i].dir[0],rays[i].dir[1],rays[i].dir[2]);
-        const Vec3fa ht  = org + rays[i].tfar*dir;
-        const Vec3fa huv = vertices[0] + rays[i].u*(vertices[1]-vertices[0]) + rays[i].v*(vertices[2]-vertices[0]);
-        if (reduce_max(abs(ht-huv)) > 16.0f*float(ulp)) return VerifyApplication::FAILED;
-        const Vec3fa Ng = normalize(Vec3fa(rays[i].Ng[0],rays[i].Ng[1],rays[i].Ng[2])); // FIXME: some geom normals are scaled!!!??
-        if (reduce_max(abs(Ng - Vec3fa(0.0f,0.0f,-1.0f))) > 16.0f*float(ulp)) return VerifyApplication::FAILED;
+        RTCRay rays0[64], rays1[64];
+        for (size_t i=0; i<64; i++)
+        {
+          const Vec3fa org = 4.0f*(2.0f*random_Vec3fa()-Vec3fa(1.0f));
+          const Vec3fa dir = 2.0f*(2.0f*random_Vec3fa()-Vec3fa(1.0f)) - org;
+          rays0[i] = rays1[i] = makeRay(org,dir);
+        }
+        IntersectWithMode(imode,ivariant,scene0,rays0,64);
+        IntersectWithMode(imode,ivariant,scene1,rays1,64);
+
+        for (size_t i=0; i<64; i++)
+        {
+          if ((rays0[i].geomID == RTC_INVALID_GEOMETRY_ID) != (rays1[i].geomID == RTC_INVALID_GEOMETRY_ID)) return VerifyApplication::FAILED;
+          if (ivariant & VARIANT_OCCLUDED) continue;
+          if (rays0[i].geomID != rays1[i].geomID) return VerifyApplication::FAILED;
+          if (rays0[i].geomID == RTC_INVALID_GEOMETRY_ID) continue;
+          if (rays0[i].primID != rays1[i].primID) return VerifyApplication::FAILED;
+          if (abs(rays0[i].tfar-rays1[i].tfar) > 1E-5f) return VerifyApplication::FAILED;
+        }
       }
-      AssertNoError(device);
+      AssertNoError(device0);
+      AssertNoError(device1);
 
       return VerifyApplication::PASSED;
     }
@@ -1888,6 +2731,110 @@ namespace embree
     }
   };
   
+  struct PointHitTest : public VerifyApplication::IntersectTest
+  {
+    RTCSceneFlags sflags; 
+    RTCGeometryFlags gflags; 
+
+    PointHitTest (std::string name, int isa, RTCSceneFlags sflags, RTCGeometryFlags gflags, IntersectMode imode, IntersectVariant ivariant)
+      : VerifyApplication::IntersectTest(name,isa,imode,ivariant,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), gflags(gflags) {}
+
+    /* reference intersection, returns false if the ray grazes the point too closely to decide */
+    static bool intersectPoint(const Vec3fa& org, const Vec3fa& dir, const Vec3fa& p, bool disc, float& t)
+    {
+      const float r2 = p.w*p.w;
+      const Vec3fa O = org-Vec3fa(p.x,p.y,p.z);
+      const float A = dot(dir,dir);
+      const float B = dot(O,dir);
+      if (disc) {
+        t = -B/A;
+        const Vec3fa P = O+t*dir;
+        const float d2 = dot(P,P);
+        if (abs(d2-r2) < 1E-3f*r2) return false;
+        if (d2 > r2) t = float(pos_inf);
+        return true;
+      }
+      const float D = B*B-A*(dot(O,O)-r2);
+      if (abs(D) < 1E-3f*A*r2) return false;
+      t = D < 0.0f ? float(pos_inf) : (-B-sqrt(D))/A;
+      return true;
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(rtcDeviceGetError(device));
+      if (!supportsIntersectMode(device,imode))
+        return VerifyApplication::SKIPPED;
+      if (!rtcDeviceGetParameter1i(device,RTC_CONFIG_POINT_GEOMETRY))
+        return VerifyApplication::SKIPPED;
+
+      /* spheres at z=0 and discs at z=1 on interleaved grids */
+      const size_t N = 8;
+      avector<Vec3fa> points[2];
+      for (size_t i=0; i<2; i++)
+      {
+        points[i].resize(N*N);
+        for (size_t y=0; y<N; y++)
+          for (size_t x=0; x<N; x++)
+            points[i][y*N+x] = Vec3fa(float(x)+0.5f*float(i),float(y)+0.5f*float(i),float(i),0.2f+0.2f*random_float());
+      }
+
+      RTCSceneRef scene = rtcDeviceNewScene(device,sflags,to_aflags(imode));
+      unsigned geom0 = rtcNewSphereGeometry(scene,gflags,N*N);
+      unsigned geom1 = rtcNewDiscGeometry(scene,gflags,N*N);
+      rtcSetBuffer(scene,geom0,RTC_VERTEX_BUFFER,points[0].data(),0,sizeof(Vec3fa));
+      rtcSetBuffer(scene,geom1,RTC_VERTEX_BUFFER,points[1].data(),0,sizeof(Vec3fa));
+      rtcCommit (scene);
+      AssertNoError(device);
+
+      RTCRay rays[256];
+      for (size_t i=0; i<256; i++) {
+        const Vec3fa org(float(N)*random_float()-0.5f,float(N)*random_float()-0.5f,-4.0f);
+        const Vec3fa dir(0.2f*random_float()-0.1f,0.2f*random_float()-0.1f,2.0f);
+        rays[i] = makeRay(org,dir);
+      }
+      IntersectWithMode(imode,ivariant,scene,rays,256);
+
+      for (size_t i=0; i<256; i++)
+      {
+        const Vec3fa org(rays[i].org[0],rays[i].org[1],rays[i].org[2]);
+        const Vec3fa dir(rays[i].dir[0],rays[i].dir[1],rays[i].dir[2]);
+        
+        /* find closest point */
+        bool ambiguous = false;
+        float tfar = float(pos_inf);
+        unsigned geomID = RTC_INVALID_GEOMETRY_ID, primID = RTC_INVALID_GEOMETRY_ID;
+        for (unsigned g=0; g<2; g++) {
+          for (unsigned j=0; j<N*N; j++) {
+            float t = float(pos_inf);
+            ambiguous |= !intersectPoint(org,dir,points[g][j],g == 1,t);
+            if (t < tfar) { tfar = t; geomID = g; primID = j; }
+          }
+        }
+        if (ambiguous) continue;
+        
+        if (ivariant & VARIANT_OCCLUDED) {
+          if ((rays[i].geomID != RTC_INVALID_GEOMETRY_ID) != (geomID != RTC_INVALID_GEOMETRY_ID)) return VerifyApplication::FAILED;
+          continue;
+        }
+        
+        if (rays[i].geomID != geomID) return VerifyApplication::FAILED;
+        if (geomID == RTC_INVALID_GEOMETRY_ID) continue;
+        if (rays[i].primID != primID) return VerifyApplication::FAILED;
+        if (abs(rays[i].tfar - tfar) > 1E-4f*tfar) return VerifyApplication::FAILED;
+        const Vec3fa p = points[geomID][primID];
+        const Vec3fa Ng = normalize(Vec3fa(rays[i].Ng[0],rays[i].Ng[1],rays[i].Ng[2]));
+        const Vec3fa Ng_ref = geomID == 0 ? normalize(org+tfar*dir-Vec3fa(p.x,p.y,p.z)) : normalize(-dir);
+        if (reduce_max(abs(Ng-Ng_ref)) > 1E-3f) return VerifyApplication::FAILED;
+      }
+      AssertNoError(device);
+
+      return VerifyApplication::PASSED;
+    }
+  };
+
   struct RayMasksTest : public VerifyApplication::IntersectTest
   {
     RTCSceneFlags sflags; 
@@ -1944,6 +2891,48 @@ namespace embree
     }
   };
 
+  struct MixedGeometryOrderTest : public VerifyApplication::IntersectTest
+  {
+    RTCSceneFlags sflags; 
+
+    MixedGeometryOrderTest (std::string name, int isa, RTCSceneFlags sflags, IntersectMode imode, IntersectVariant ivariant)
+      : VerifyApplication::IntersectTest(name,isa,imode,ivariant,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(rtcDeviceGetError(device));
+      if (!supportsIntersectMode(device,imode))
+        return VerifyApplication::SKIPPED;
+
+      /* geometries of different types get stored in different acceleration structures */
+      VerifyScene scene(device,sflags,to_aflags(imode));
+      unsigned int geom0 = scene.addSphere      (sampler,RTC_GEOMETRY_STATIC,Vec3fa(-4,0,0),1.0f,50);
+      unsigned int geom1 = scene.addQuadSphere  (sampler,RTC_GEOMETRY_STATIC,Vec3fa( 0,0,0),1.0f,50); 
+      unsigned int geom2 = scene.addSubdivSphere(sampler,RTC_GEOMETRY_STATIC,Vec3fa(+4,0,0),1.0f,5,4);
+      rtcCommit (scene);
+      AssertNoError(device);
+
+      RTCRay rays[4] = {
+        makeRay(Vec3fa(-10,0,0),Vec3fa(+1,0,0)),
+        makeRay(Vec3fa(+10,0,0),Vec3fa(-1,0,0)),
+        makeRay(Vec3fa( -2,0,0),Vec3fa(+1,0,0)),
+        makeRay(Vec3fa( +2,0,0),Vec3fa(-1,0,0))
+      };
+      unsigned int expected[4] = { geom0, geom2, geom1, geom1 };
+      IntersectWithMode(imode,ivariant,scene,rays,4);
+      AssertNoError(device);
+
+      bool passed = true;
+      for (size_t i=0; i<4; i++) {
+        if (ivariant & VARIANT_OCCLUDED) passed &= rays[i].geomID != RTC_INVALID_GEOMETRY_ID;
+        else                             passed &= rays[i].geomID == expected[i];
+      }
+      return (VerifyApplication::TestReturnValue) passed;
+    }
+  };
+
   struct BackfaceCullingTest : public VerifyApplication::IntersectTest
   {
     RTCSceneFlags sflags;
@@ -2170,6 +3159,203 @@ namespace embree
     }
   };
     
+  struct OpacityMaskTest : public VerifyApplication::IntersectTest
+  {
+    RTCSceneFlags sflags;
+    static const unsigned level = 2;
+
+    struct Alpha
+    {
+      Alpha (bool quads) : quads(quads), calls(0) {}
+
+      /* index of sub-triangle (or sub-quad) that contains the u/v location */
+      unsigned index(float u, float v) const
+      {
+        const int N = 1 << level;
+        const float fu = u*float(N), fv = v*float(N);
+        int iu = clamp(int(fu),0,N-1);
+        int iv = clamp(int(fv),0,N-1);
+        if (quads) return iv*N+iu;
+        iu = min(iu,N-1-iv);
+        const bool flip = (fu-float(iu)) + (fv-float(iv)) >= 1.0f && iu+iv < N-1;
+        return iv*(2*N-iv) + 2*iu + flip;
+      }
+
+      RTCOpacityState state(unsigned primID, unsigned index) const {
+        return (RTCOpacityState) ((primID*7+index*13) % 3);
+      }
+
+      /* transparent, opaque, or striped for unknown regions */
+      bool opaque(unsigned primID, float u, float v) const 
+      {
+        const RTCOpacityState s = state(primID,index(u,v));
+        if (s != RTC_OPACITY_UNKNOWN) return s == RTC_OPACITY_OPAQUE;
+        return frac(8.0f*u) < 0.5f;
+      }
+
+      std::vector<unsigned char> mask(size_t numPrimitives) const
+      {
+        const size_t bytes = ((2u << (2*level))+7)/8;
+        std::vector<unsigned char> m(numPrimitives*bytes,0);
+        for (unsigned primID=0; primID<numPrimitives; primID++)
+          for (unsigned i=0; i<(1u << (2*level)); i++)
+            m[primID*bytes+i/4] |= state(primID,i) << (2*(i%4));
+        return m;
+      }
+      
+      bool quads;
+      std::atomic<size_t> calls;
+    };
+
+    OpacityMaskTest (std::string name, int isa, RTCSceneFlags sflags, IntersectMode imode, IntersectVariant ivariant)
+      : VerifyApplication::IntersectTest(name,isa,imode,ivariant,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+
+    static void alphaFilter1(void* userGeomPtr, RTCRay& ray)
+    {
+      Alpha* alpha = (Alpha*) userGeomPtr;
+      alpha->calls++;
+      if (!alpha->opaque(ray.primID,ray.u,ray.v))
+        ray.geomID = RTC_INVALID_GEOMETRY_ID;
+    }
+
+    template<int K, typename RayK>
+    static void alphaFilterK(const void* valid_i, void* userGeomPtr, RayK& ray)
+    {
+      const int* valid = (const int*) valid_i;
+      Alpha* alpha = (Alpha*) userGeomPtr;
+      for (size_t i=0; i<K; i++)
+      {
+        if (valid[i] != -1) continue;
+        alpha->calls++;
+        if (!alpha->opaque(ray.primID[i],ray.u[i],ray.v[i]))
+          ray.geomID[i] = RTC_INVALID_GEOMETRY_ID;
+      }
+    }
+
+    static void alphaFilterN(int* valid, void* userGeomPtr, const RTCIntersectContext* context, RTCRayN* ray, const RTCHitN* potentialHit, const size_t N)
+    {
+      Alpha* alpha = (Alpha*) userGeomPtr;
+      for (size_t i=0; i<N; i++)
+      {
+        if (valid[i] != -1) continue;
+        alpha->calls++;
+
+        /* reject hit */
+        if (!alpha->opaque(RTCHitN_primID(potentialHit,N,i),RTCHitN_u(potentialHit,N,i),RTCHitN_v(potentialHit,N,i))) {
+          valid[i] = 0;
+        }
+
+        /* accept hit */
+        else {
+          RTCRayN_instID(ray,N,i) = RTCHitN_instID(potentialHit,N,i);
+          RTCRayN_geomID(ray,N,i) = RTCHitN_geomID(potentialHit,N,i);
+          RTCRayN_primID(ray,N,i) = RTCHitN_primID(potentialHit,N,i);
+          RTCRayN_u(ray,N,i) = RTCHitN_u(potentialHit,N,i);
+          RTCRayN_v(ray,N,i) = RTCHitN_v(potentialHit,N,i);
+          RTCRayN_tfar(ray,N,i) = RTCHitN_t(potentialHit,N,i);
+          RTCRayN_Ng_x(ray,N,i) = RTCHitN_Ng_x(potentialHit,N,i);
+          RTCRayN_Ng_y(ray,N,i) = RTCHitN_Ng_y(potentialHit,N,i);
+          RTCRayN_Ng_z(ray,N,i) = RTCHitN_Ng_z(potentialHit,N,i);
+        }
+      }
+    }
+
+    void setAlphaFilter(RTCScene scene, unsigned geomID)
+    {
+      if (imode == MODE_INTERSECT1) {
+        rtcSetIntersectionFilterFunction(scene,geomID,alphaFilter1);
+        rtcSetOcclusionFilterFunction   (scene,geomID,alphaFilter1);
+      }
+      else if (imode == MODE_INTERSECT4) {
+        rtcSetIntersectionFilterFunction4(scene,geomID,alphaFilterK<4,RTCRay4>);
+        rtcSetOcclusionFilterFunction4   (scene,geomID,alphaFilterK<4,RTCRay4>);
+      }
+      else if (imode == MODE_INTERSECT8) {
+        rtcSetIntersectionFilterFunction8(scene,geomID,alphaFilterK<8,RTCRay8>);
+        rtcSetOcclusionFilterFunction8   (scene,geomID,alphaFilterK<8,RTCRay8>);
+      }
+      else if (imode == MODE_INTERSECT16) {
+        rtcSetIntersectionFilterFunction16(scene,geomID,alphaFilterK<16,RTCRay16>);
+        rtcSetOcclusionFilterFunction16   (scene,geomID,alphaFilterK<16,RTCRay16>);
+      }
+      else {
+        rtcSetIntersectionFilterFunctionN(scene,geomID,alphaFilterN);
+        rtcSetOcclusionFilterFunctionN   (scene,geomID,alphaFilterN);
+      }
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(rtcDeviceGetError(device));
+      if (!supportsIntersectMode(device,imode))
+        return VerifyApplication::SKIPPED;
+
+      /* first scene evaluates alpha in filter functions only, second scene uses opacity masks */
+      Ref<SceneGraph::TriangleMeshNode> triangles = SceneGraph::createTriangleSphere(Vec3fa(-1,0,0),1.0f,20).dynamicCast<SceneGraph::TriangleMeshNode>();
+      Ref<SceneGraph::QuadMeshNode> quads = SceneGraph::createQuadSphere(Vec3fa(+1,0,0),1.0f,20).dynamicCast<SceneGraph::QuadMeshNode>();
+      Alpha triangleAlpha0(false), quadAlpha0(true);
+      Alpha triangleAlpha1(false), quadAlpha1(true);
+      Alpha* alphas[2][2] = { { &triangleAlpha0, &quadAlpha0 }, { &triangleAlpha1, &quadAlpha1 } };
+      std::vector<unsigned char> triangleMask = triangleAlpha0.mask(triangles->triangles.size());
+      std::vector<unsigned char> quadMask = quadAlpha0.mask(quads->quads.size());
+      
+      VerifyScene scene0(device,sflags,to_aflags(imode));
+      VerifyScene scene1(device,sflags,to_aflags(imode));
+      VerifyScene* scenes[2] = { &scene0, &scene1 };
+      for (size_t i=0; i<2; i++)
+      {
+        unsigned geomIDs[2] = { scenes[i]->addGeometry(RTC_GEOMETRY_STATIC,triangles.dynamicCast<SceneGraph::Node>()),
+                                scenes[i]->addGeometry(RTC_GEOMETRY_STATIC,quads.dynamicCast<SceneGraph::Node>()) };
+        for (size_t j=0; j<2; j++) {
+          rtcSetUserData(*scenes[i],geomIDs[j],alphas[i][j]);
+          setAlphaFilter(*scenes[i],geomIDs[j]);
+        }
+        if (i == 1) {
+          rtcSetOpacityMask(*scenes[i],geomIDs[0],triangleMask.data(),level);
+          rtcSetOpacityMask(*scenes[i],geomIDs[1],quadMask.data(),level);
+        }
+        rtcCommit (*scenes[i]);
+      }
+      AssertNoError(device);
+      
+      /* both scenes have to report the same hits */
+      bool passed = true;
+      for (size_t i=0; i<size_t(64*state->intensity); i++)
+      {
+        __aligned(16) RTCRay rays0[16];
+        __aligned(16) RTCRay rays1[16];
+        for (size_t j=0; j<16; j++) {
+          const Vec3fa org = 2.0f*random_Vec3fa()-Vec3fa(1.0f) + Vec3fa(0,0,-4);
+          const Vec3fa dir = 2.0f*random_Vec3fa()-Vec3fa(1.0f) - org;
+          rays0[j] = rays1[j] = makeRay(org,dir);
+        }
+        IntersectWithMode(imode,ivariant,scene0,rays0,16);
+        IntersectWithMode(imode,ivariant,scene1,rays1,16);
+        for (size_t j=0; j<16; j++) 
+        {
+          /* occlusion queries only report whether something got hit */
+          if (ivariant & VARIANT_OCCLUDED) {
+            passed &= (rays0[j].geomID == RTC_INVALID_GEOMETRY_ID) == (rays1[j].geomID == RTC_INVALID_GEOMETRY_ID);
+            continue;
+          }
+          passed &= rays0[j].geomID == rays1[j].geomID;
+          passed &= rays0[j].primID == rays1[j].primID;
+          passed &= rays0[j].tfar == rays1[j].tfar;
+        }
+      }
+      AssertNoError(device);
+
+      /* masked scene only invokes the filter functions for unknown regions */
+      const size_t calls0 = triangleAlpha0.calls + quadAlpha0.calls;
+      const size_t calls1 = triangleAlpha1.calls + quadAlpha1.calls;
+      passed &= calls1 < calls0;
+      
+      return (VerifyApplication::TestReturnValue) passed;
+    }
+  };
+    
   struct InactiveRaysTest : public VerifyApplication::IntersectTest
   {
     RTCSceneFlags sflags;
@@ -3808,6 +4994,46 @@ namespace embree
       for (auto sflags : sceneFlags) 
         groups.top()->add(new BuildTest(to_string(sflags),isa,sflags,RTC_GEOMETRY_STATIC));
       groups.pop();
+
+      push(new TestGroup("compact_build",true,true));
+      for (auto sflags : sceneFlags) 
+        groups.top()->add(new CompactBuildTest(to_string(sflags),isa,sflags));
+      groups.pop();
+
+      push(new TestGroup("sweep_build",true,true));
+      groups.top()->add(new SweepBuildTest("high_quality",isa,RTC_SCENE_STATIC | RTC_SCENE_HIGH_QUALITY));
+      groups.top()->add(new SweepBuildTest("high_quality.robust",isa,RTC_SCENE_STATIC | RTC_SCENE_HIGH_QUALITY | RTC_SCENE_ROBUST));
+      groups.pop();
+
+      push(new TestGroup("time_split_build",true,true));
+      for (auto sflags : sceneFlags) 
+        groups.top()->add(new TimeSplitBuildTest(to_string(sflags),isa,sflags));
+      groups.pop();
+
+      push(new TestGroup("quantized_mblur",true,true));
+      groups.top()->add(new QuantizedMBlurTest("fast",isa,RTC_SCENE_STATIC));
+      groups.top()->add(new QuantizedMBlurTest("robust",isa,RTC_SCENE_STATIC | RTC_SCENE_ROBUST));
+      groups.pop();
+
+      push(new TestGroup("short_stack_traversal",true,true));
+      for (auto sflags : sceneFlags)
+        groups.top()->add(new ShortStackTraversalTest(to_string(sflags),isa,sflags));
+      groups.pop();
+
+      push(new TestGroup("occluder_cache",true,true));
+      for (auto sflags : sceneFlags)
+        groups.top()->add(new OccluderCacheTest(to_string(sflags),isa,sflags));
+      groups.pop();
+
+      push(new TestGroup("lazy_instances",true,true));
+      for (auto sflags : sceneFlags)
+        groups.top()->add(new LazyInstanceTest(to_string(sflags),isa,sflags));
+      groups.pop();
+
+      push(new TestGroup("cost_counters",true,true));
+      for (auto sflags : sceneFlags)
+        groups.top()->add(new CostCountersTest(to_string(sflags),isa,sflags));
+      groups.pop();
       
       push(new TestGroup("overlapping_primitives",true,true));
       for (auto sflags : sceneFlags)
@@ -3839,6 +5065,16 @@ namespace embree
 
       groups.top()->add(new GarbageGeometryTest("build_garbage_geom."+stringOfISA(isa),isa));
 
+      push(new TestGroup("invalid_primitives",true,true));
+      for (auto sflags : sceneFlags) 
+        groups.top()->add(new InvalidPrimitivesTest(to_string(sflags),isa,sflags));
+      groups.pop();
+
+      push(new TestGroup("subdiv_stencil_tables",true,true));
+      for (auto sflags : sceneFlagsDynamic) 
+        groups.top()->add(new SubdivStencilTableTest(to_string(sflags),isa,sflags));
+      groups.pop();
+
       /**************************************************************************/
       /*                     Interpolation Tests                                */
       /**************************************************************************/
@@ -3855,6 +5091,11 @@ namespace embree
       for (auto s : interpolateTests)
         groups.top()->add(new InterpolateSubdivTest(std::to_string((long long)(s)),isa,s));
       groups.pop();
+
+      push(new TestGroup("regular_subdiv",true,true));
+      for (auto s : interpolateTests)
+        groups.top()->add(new InterpolateRegularSubdivTest(std::to_string((long long)(s)),isa,s));
+      groups.pop();
         
       push(new TestGroup("hair",true,true));
       for (auto s : interpolateTests) 
@@ -3874,6 +5115,22 @@ namespace embree
             if (has_variant(imode,ivariant))
                 groups.top()->add(new TriangleHitTest(to_string(sflags,imode,ivariant),isa,sflags,RTC_GEOMETRY_STATIC,imode,ivariant));
       groups.pop();
+
+      push(new TestGroup("triangle_pairs",true,true));
+      for (auto sflags : sceneFlags) 
+        for (auto imode : intersectModes) 
+          for (auto ivariant : intersectVariants)
+            if (has_variant(imode,ivariant))
+                groups.top()->add(new TrianglePairTest(to_string(sflags,imode,ivariant),isa,sflags,imode,ivariant));
+      groups.pop();
+
+      push(new TestGroup("tiny_scenes",true,true));
+      for (auto sflags : sceneFlags) 
+        for (auto imode : intersectModes) 
+          for (auto ivariant : intersectVariants)
+            if (has_variant(imode,ivariant))
+                groups.top()->add(new TinySceneTest(to_string(sflags,imode,ivariant),isa,sflags,imode,ivariant));
+      groups.pop();
       
       push(new TestGroup("quad_hit",true,true));
       for (auto sflags : sceneFlags) 
@@ -3883,6 +5140,22 @@ namespace embree
                 groups.top()->add(new QuadHitTest(to_string(sflags,imode,ivariant),isa,sflags,RTC_GEOMETRY_STATIC,imode,ivariant));
       groups.pop();
 
+      push(new TestGroup("point_hit",true,true));
+      for (auto sflags : sceneFlags) 
+        for (auto imode : intersectModes) 
+          for (auto ivariant : intersectVariants)
+            if (has_variant(imode,ivariant))
+                groups.top()->add(new PointHitTest(to_string(sflags,imode,ivariant),isa,sflags,RTC_GEOMETRY_STATIC,imode,ivariant));
+      groups.pop();
+
+      push(new TestGroup("mixed_geometry_order",true,true));
+      for (auto sflags : sceneFlags) 
+        for (auto imode : intersectModes) 
+          for (auto ivariant : intersectVariants)
+            if (has_variant(imode,ivariant))
+              groups.top()->add(new MixedGeometryOrderTest(to_string(sflags,imode,ivariant),isa,sflags,imode,ivariant));
+      groups.pop();
+
       if (rtcDeviceGetParameter1i(device,RTC_CONFIG_RAY_MASK)) 
       {
         push(new TestGroup("ray_masks",true,true));
@@ -3922,6 +5195,17 @@ namespace embree
                   groups.top()->add(new IntersectionFilterTest("subdiv."+to_string(sflags,imode,ivariant),isa,sflags,RTC_GEOMETRY_STATIC,true,imode,ivariant));
       }
       groups.pop();
+
+      push(new TestGroup("opacity_mask",true,true));
+      if (rtcDeviceGetParameter1i(device,RTC_CONFIG_INTERSECTION_FILTER)) 
+      {
+        for (auto sflags : sceneFlags) 
+          for (auto imode : intersectModes) 
+            for (auto ivariant : intersectVariants)
+              if (has_variant(imode,ivariant))
+                groups.top()->add(new OpacityMaskTest(to_string(sflags,imode,ivariant),isa,sflags,imode,ivariant));
+      }
+      groups.pop();
       
       push(new TestGroup("inactive_rays",true,true));
       for (auto sflags : sceneFlags) 